@@ -58,7 +58,8 @@ function(compile_glsl_to_spirv input_dir output_dir glsl_path output_dependencie
     # and glslangvalidator seem to be... finicky?
     COMMAND stb_include_app ${glsl_path} ${spv_path_parse} "${input_dir}/include" "${CMAKE_BINARY_DIR}"
     
-    # Second command; nuke shader cache if one currently exists
+    # Second command; nuke program binary cache written by ProgramCache, if one currently
+    # exists; its entries are keyed by shader source as well, but stale entries would linger
     COMMAND ${CMAKE_COMMAND} -E rm -f "${output_dir}/shaders.bin"
 
     # Third command; generate spirv binary using glslangvalidator
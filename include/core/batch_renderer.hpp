@@ -0,0 +1,64 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <core/draw_batch.hpp>
+#include <core/utility.hpp>
+#include <array>
+
+namespace prg {
+  // GPU buffers of a draw batch, uploaded once into immutable storage, alongside a vertex
+  // array and the indirect command buffer; all polygons are drawn through one multi-draw call.
+  // Bindings follow the batch shaders; vertices and colors at attributes 0 and 1, and per-draw
+  // polygon data at attribute 2, advanced per instance s.t. a command's base instance selects
+  // it. Vertices, colors and rings are also at storage bindings 0, 1 and 2
+  class BatchRenderer {
+    enum BufferType : uint { eVerts, eColrs, eElems, eRings, ePolygons, eCommands, eCount };
+
+    std::array<uint, BufferType::eCount> m_buffers = { };
+    uint                                 m_array   = 0;
+    uint                                 m_draws   = 0;
+
+  public:
+    BatchRenderer() = default;
+    explicit BatchRenderer(const DrawBatch &batch);
+    ~BatchRenderer();
+
+    BatchRenderer(BatchRenderer &&o) noexcept { swap(o); }
+    BatchRenderer &operator=(BatchRenderer &&o) noexcept { swap(o); return *this; }
+    BatchRenderer(const BatchRenderer &) = delete;
+    BatchRenderer &operator=(const BatchRenderer &) = delete;
+
+    // Bind the vertex array, storage buffers and indirect command buffer
+    void bind() const;
+
+    // Draw all polygons through a single glMultiDrawElementsIndirect with a GL primitive
+    // mode, using the bound program
+    void draw(uint mode) const;
+
+    // Draw polygon i by itself, with the same bindings; for comparison against draw(...)
+    void draw(uint mode, uint i) const;
+
+    uint draws() const { return m_draws; }
+
+    void swap(BatchRenderer &o);
+  };
+} // namespace prg
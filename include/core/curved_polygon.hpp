@@ -0,0 +1,120 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <core/math.hpp>
+#include <core/utility.hpp>
+#include <span>
+#include <vector>
+
+namespace prg {
+  // Curve types of polygon edges
+  enum class CurveType : uint {
+    eLine      = 0,
+    eQuadratic = 1, // Bezier curve with control point ctrl_a
+    eCubic     = 2  // Bezier curve with control points ctrl_a, ctrl_b
+  };
+
+  // Edge (i, i + 1) of a curved polygon; its end points are the polygon's vertices, and
+  // control points unused by its type are ignored
+  struct CurvedEdge {
+    CurveType     type   = CurveType::eLine;
+    eig::Vector2f ctrl_a = eig::Vector2f::Zero();
+    eig::Vector2f ctrl_b = eig::Vector2f::Zero();
+  };
+
+  // Evaluate an edge from a to b at parameter t in [0, 1]
+  eig::Vector2f eval_curve(const eig::Vector2f &a, const CurvedEdge &edge, const eig::Vector2f &b, float t);
+
+  // Upper bound on the nr. of segments a single edge is flattened into
+  constexpr uint curve_max_segments = 256;
+
+  // Nr. of uniform parameter steps that flatten an edge from a to b to within tolerance of the
+  // curve, following Wang's formula, which bounds deviation through the control polygon's
+  // second differences; lines need a single step
+  uint curve_segments(const eig::Vector2f &a, const CurvedEdge &edge, const eig::Vector2f &b, float tolerance);
+
+  // Polygon whose edges may be quadratic or cubic Bezier curves, flattened on demand into
+  // contiguous vertex/color buffers for triangulate_polygon(...) and eval_mvc(...). Flattened
+  // edges are cached, and an update only re-flattens edges touched by edits since the last
+  // update. Tolerances are snapped down to powers of two, s.t. zooming re-flattens curved edges
+  // only when the view scale crosses a power of two. Colors along an edge are interpolated
+  // linearly by parameter between its end points' colors
+  class CurvedPolygon {
+    // Flattened edge; holds points and parameters strictly inside the edge
+    struct EdgeCache {
+      std::vector<eig::Vector2f> points;
+      std::vector<float>         params;
+      bool                       is_dirty = true;
+    };
+
+    std::vector<eig::Vector2f>  m_verts;
+    std::vector<eig::AlArray3f> m_colrs;
+    std::vector<CurvedEdge>     m_edges;
+    std::vector<EdgeCache>      m_cache;
+
+    // Flattened output; edge i starts at vertex i, at m_offsets[i]
+    std::vector<eig::Vector2f>  m_flat_verts;
+    std::vector<eig::AlArray3f> m_flat_colrs;
+    std::vector<uint>           m_offsets;
+    float                       m_tolerance = 0.f; // Snapped tolerance of the cache
+    uint                        m_flattened = 0;   // Nr. of edges re-flattened by the last update
+    bool                        m_is_dirty  = true;
+
+    void mark_vert(uint i);
+
+  public:
+    CurvedPolygon() = default;
+
+    // Build from vertex and color buffers of equal size; edges is either empty, s.t. all edges
+    // are lines, or holds an edge per vertex
+    CurvedPolygon(std::span<const eig::Vector2f>  verts,
+                  std::span<const eig::AlArray3f> colrs,
+                  std::span<const CurvedEdge>     edges = { });
+
+    uint size()  const { return static_cast<uint>(m_verts.size()); }
+    bool empty() const { return m_verts.empty();                    }
+
+    // Vertex and edge access and updates by position; updates mark adjacent edges for
+    // re-flattening. Control points of edge i move along with neither of its vertices
+    const eig::Vector2f  &vert(uint i) const { return m_verts[i]; }
+    const eig::AlArray3f &colr(uint i) const { return m_colrs[i]; }
+    const CurvedEdge     &edge(uint i) const { return m_edges[i]; }
+    void set_vert(uint i, const eig::Vector2f &vert);
+    void set_colr(uint i, const eig::AlArray3f &colr);
+    void set_edge(uint i, const CurvedEdge &edge);
+
+    // Re-flatten edited edges, or all curved edges if the snapped tolerance changed, and
+    // update the flattened buffers; ranges of edges whose vertex count is unchanged are
+    // patched in place. Tolerance is in vertex space, e.g. a pixel tolerance over the view's
+    // scale. Returns whether the flattened buffers changed
+    bool update(float tolerance);
+
+    // Flattened buffers as of the last update; vertex i of the polygon is flattened vertex
+    // offsets()[i], and offsets() holds size() + 1 entries
+    std::span<const eig::Vector2f>  flat_verts() const { return m_flat_verts; }
+    std::span<const eig::AlArray3f> flat_colrs() const { return m_flat_colrs; }
+    std::span<const uint>           offsets()    const { return m_offsets;    }
+
+    // Nr. of edges re-flattened by the last update
+    uint flattened() const { return m_flattened; }
+  };
+} // namespace prg
@@ -0,0 +1,87 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <core/math.hpp>
+#include <core/utility.hpp>
+#include <span>
+#include <vector>
+
+namespace prg {
+  // Sparse, row-compressed matrix of mean value coordinate weights; row i holds the
+  // weights of point i w.r.t. the cage's vertices in [offsets[i], offsets[i + 1]). As
+  // truncated rows lose linear precision, each row also stores its residual against the
+  // rest pose, s.t. deformation by the rest-pose cage returns the points unchanged
+  struct SparseWeights {
+    uint                       n_verts = 0;
+    std::vector<uint>          offsets = { 0 };
+    std::vector<uint>          indices;
+    std::vector<float>         weights;
+    std::vector<eig::Vector2f> residuals; // Per row, p_i - W_i * verts_rest
+
+    uint n_points() const { return static_cast<uint>(offsets.size()) - 1; }
+  };
+
+  // Precompute sparse weights of a set of points w.r.t. a cage in its rest pose; per point,
+  // at most the k weights of largest magnitude are retained, minus those with magnitude below
+  // epsilon times the largest, and the remainder is renormalized. Rows whose retained weights 
+  // nearly cancel out keep all of their weights instead
+  SparseWeights build_sparse_weights(std::span<const eig::Vector2f> verts,
+                                     std::span<const eig::Vector2f> points,
+                                     uint                           k       = 16,
+                                     float                          epsilon = 1e-3f);
+  
+  // Deform points by a posed cage, as the sparse product out = W * verts plus the rows'
+  // residuals; out is expected to be of size weights.n_points()
+  void deform_points(const SparseWeights              &weights,
+                     std::span<const eig::Vector2f>   verts,
+                     std::span<eig::Vector2f>         out);
+
+  // Image deformation settings
+  struct ImageDeformerInfo {
+    eig::Array2u      size;                                                      // Image resolution in pixels
+    eig::AlignedBox2f bounds = { eig::Vector2f(0, 0), eig::Vector2f(1, 1) };     // Image region in polygon space
+    uint              step   = 4;                                                // Deformation lattice spacing in pixels
+  };
+
+  // Cage-based image deformation; sparse weights are precomputed once for a lattice over
+  // the image against the cage's rest pose. Per edit, the lattice is deformed through
+  // deform_points(...) and the image is resampled by rasterizing the deformed lattice
+  class ImageDeformer {
+    ImageDeformerInfo          m_info;
+    eig::Array2u               m_lattice_size;
+    std::vector<eig::Vector2f> m_lattice_src; // Undeformed lattice, in pixel space
+    std::vector<eig::Vector2f> m_lattice_dst; // Deformed lattice, in pixel space
+    SparseWeights              m_weights;
+
+  public:
+    ImageDeformer() = default;
+    ImageDeformer(std::span<const eig::Vector2f> verts_rest, ImageDeformerInfo info);
+
+    const SparseWeights &weights() const { return m_weights; }
+
+    // Deform a rgba8 source image by the posed cage into dst; both are row-major and 
+    // of the image size, and uncovered pixels in dst are left transparent
+    void deform(std::span<const eig::Vector2f>      verts,
+                std::span<const eig::Array4<uchar>> src,
+                std::span<eig::Array4<uchar>>       dst);
+  };
+} // namespace prg
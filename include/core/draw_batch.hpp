@@ -0,0 +1,68 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <core/math.hpp>
+#include <core/polygon_collection.hpp>
+#include <core/utility.hpp>
+#include <vector>
+
+namespace prg {
+  // Indirect draw command; layout matches GL's DrawElementsIndirectCommand
+  struct DrawIndirectCommand {
+    uint count;          // Nr. of indices
+    uint instance_count; // Always 1
+    uint first_index;    // First index in the batch's element buffer
+    int  base_vertex;    // Polygon's first vertex, added to its indices
+    uint base_instance;  // Polygon's id, which selects its per-draw data
+  };
+
+  // Ring of a polygon in a batch; layout matches std430, and sign scales the ring's mean value
+  // weights s.t. holes wind opposite to the outer ring, as in eval_mvc(...)
+  struct DrawBatchRing {
+    uint  first; // Absolute first vertex
+    uint  size;
+    float sign;
+    uint  padding = 0;
+  };
+
+  // Per-draw data of a polygon in a batch; its rings are [rings_first, rings_first + rings_size)
+  struct DrawBatchPolygon {
+    uint rings_first;
+    uint rings_size;
+  };
+
+  // Draw data of a polygon collection, packed into shared buffers s.t. a single multi-draw
+  // call covers all polygons; vertices and colors are concatenated in collection order, and
+  // each polygon's triangles index its own vertices, offset by the command's base vertex
+  struct DrawBatch {
+    std::vector<eig::Vector2f>       verts;
+    std::vector<eig::AlArray3f>      colrs;
+    std::vector<eig::Array3u>        elems;
+    std::vector<DrawBatchRing>       rings;
+    std::vector<DrawBatchPolygon>    polygons; // One per command, indexed by base instance
+    std::vector<DrawIndirectCommand> commands; // One per polygon, in collection order
+  };
+
+  // Pack all polygons of a collection into a draw batch; polygons are triangulated
+  // concurrently, and the triangulation does not depend on the nr. of threads
+  DrawBatch pack_draw_batch(const PolygonCollection &collection);
+} // namespace prg
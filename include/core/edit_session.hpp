@@ -0,0 +1,206 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <core/editable_polygon.hpp>
+#include <core/math.hpp>
+#include <core/mvc.hpp>
+#include <core/point_grid.hpp>
+#include <core/polygon_lod.hpp>
+#include <core/undo_history.hpp>
+#include <core/utility.hpp>
+#include <filesystem>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace prg {
+  // Draw methods of the interactive test; values match the shader-side settings layout
+  enum class DrawMethod : uint {
+    eBarycentric     = 0,
+    eMeanValueCoords = 1,
+    eWachspress      = 2
+  };
+
+  // Draw settings of the interactive test, as edited through the UI
+  struct EditSettings {
+    DrawMethod   draw_method     = DrawMethod::eBarycentric;
+    MvcPrecision draw_precision  = MvcPrecision::eExact;
+    bool         draw_lines      = false;
+    bool         auto_wachspress = true; // Use cheaper Wachspress coordinates for convex polygons
+
+    bool operator==(const EditSettings &) const = default;
+  };
+
+  // Edit operations that can be applied to, and recorded by, an edit session
+  enum class EditType : uint {
+    eSplitEdge   = 0, // Insert a vertex halfway along the longest edge
+    eEraseVert   = 1, // Erase the vertex at index
+    eMoveVert    = 2, // Set the vertex at index to vert
+    eSetColr     = 3, // Set the color at index to colr
+    eSetSettings = 4, // Replace draw settings with settings
+    eUndo        = 5, // Revert the last undo step, if any
+    eRedo        = 6  // Reapply the last reverted undo step, if any
+  };
+
+  // Single edit event; members not used by an edit's type are ignored
+  struct EditEvent {
+    uint           frame    = 0; // Frame on which the edit happened, relative to recording start
+    EditType       type     = EditType::eSplitEdge;
+    uint           index    = 0;
+    eig::Vector2f  vert     = eig::Vector2f::Zero();
+    eig::AlArray3f colr     = 0.f;
+    EditSettings   settings = { };
+  };
+
+  // Recorded editing session; the initial polygon and settings, followed by events over a nr.
+  // of frames. Saved as json, as in save_edit_trace(...)
+  struct EditTrace {
+    eig::Array2u                window_size = { 1024, 768 }; // Window size, which determines the view
+    uint                        frames      = 0;
+    EditSettings                settings;
+    std::vector<eig::Vector2f>  verts;
+    std::vector<eig::AlArray3f> colrs;
+    std::vector<EditEvent>      events;   // Sorted by frame
+  };
+
+  // Polygons larger than this are drawn at a coarse LOD level of at most this many vertices,
+  // while being dragged
+  constexpr uint edit_preview_verts = 512;
+
+  // Data derived from an edit session each frame, for drawing and vertex picking; parts are
+  // regenerated only if the session's polygon or the view changed since the last update
+  struct EditFrame {
+    DrawMethod                draw_method   = DrawMethod::eBarycentric; // Effective draw method, after Wachspress fallback
+    bool                      is_convex     = false;
+    std::vector<eig::Array3u> elems;                                    // Polygon triangulation
+    PointGrid                 pick_grid;                                // Window-space grid over vertices
+    eig::ViewTransform        pick_view;                                // View transform of pick_grid
+    uint                      draw_revision = static_cast<uint>(-1);
+    uint                      pick_revision = static_cast<uint>(-1);
+
+    // Coarse preview, drawn instead of the full polygon if is_preview is set; the LOD chain
+    // is rebuilt only on structural edits, as vertex moves reuse its levels
+    bool                         is_preview = false;
+    std::vector<PolygonLodLevel> lod;
+    uint                         lod_revision = static_cast<uint>(-1);
+    std::vector<eig::Vector2f>   preview_verts;
+    std::vector<eig::AlArray3f>  preview_colrs;
+    std::vector<eig::Array3u>    preview_elems;
+
+    // Vertex/color data to draw alongside elems or preview_elems
+    std::span<const eig::Vector2f>  draw_verts(std::span<const eig::Vector2f> verts) const { return is_preview ? preview_verts : verts; }
+    std::span<const eig::AlArray3f> draw_colrs(std::span<const eig::AlArray3f> colrs) const { return is_preview ? preview_colrs : colrs; }
+    std::span<const eig::Array3u>   draw_elems() const { return is_preview ? preview_elems : elems; }
+  };
+
+  // Vertex data of an edit session, as stored in its undo history
+  struct EditVertex {
+    eig::Vector2f  vert;
+    eig::AlArray3f colr;
+  };
+
+  // Radius around vertices in window space, in pixels, within which they can be picked
+  constexpr float edit_pick_radius = 8.f;
+
+  // View transform of the interactive test, from vertex space in [0, 1] to window space
+  eig::ViewTransform edit_view_transform(eig::Array2f window_size);
+
+  // Editing state of the interactive test; the UI and headless replay apply all edits through
+  // apply(...), s.t. both share update logic and an active recording captures every edit.
+  // Vertex and color data are kept as flat buffers next to an EditablePolygon, which locates
+  // structural edits; flat buffers take the same insert or erase at the returned position. Polygon edits are kept in an undo history of chunked, shared
+  // versions; an edit begins a new undo step, unless it continues a drag, i.e. it moves or
+  // recolors the same vertex as the previous edit on the same or the next frame
+  class EditSession {
+    EditablePolygon             m_polygon;
+    std::vector<eig::Vector2f>  m_verts;
+    std::vector<eig::AlArray3f> m_colrs;
+    EditSettings                m_settings;
+    uint                        m_frame    = 0;
+    uint                        m_revision = 0;           // Incremented on every polygon edit
+    uint                        m_structure_revision = 0; // Incremented on vertex inserts/erases
+
+    // Undo history, and the last polygon edit, which later edits may continue
+    UndoHistory<EditVertex> m_history;
+    EditEvent               m_step_event;
+    bool                    m_is_step_open = false;
+
+    // Active recording, if any
+    bool      m_is_recording = false;
+    uint      m_record_frame = 0;
+    EditTrace m_trace;
+
+    // Bring flat buffers and the polygon from one history version to another; only chunks
+    // that versions do not share are visited if their layouts match
+    void restore(const ChunkedVector<EditVertex> &from, const ChunkedVector<EditVertex> &to);
+
+  public:
+    EditSession() = default;
+    EditSession(std::span<const eig::Vector2f>  verts,
+                std::span<const eig::AlArray3f> colrs,
+                EditSettings                    settings = { });
+
+    // Apply an edit, and record it if recording; the event's frame is ignored
+    void apply(const EditEvent &event);
+
+    // Shorthands for apply(...)
+    void split_longest_edge()                  { apply({ .type = EditType::eSplitEdge }); }
+    void erase_vert(uint i)                    { apply({ .type = EditType::eEraseVert, .index = i }); }
+    void set_vert(uint i, eig::Vector2f vert)  { apply({ .type = EditType::eMoveVert,  .index = i, .vert = vert }); }
+    void set_colr(uint i, eig::AlArray3f colr) { apply({ .type = EditType::eSetColr,   .index = i, .colr = colr }); }
+    void set_settings(EditSettings settings)   { apply({ .type = EditType::eSetSettings, .settings = settings }); }
+    void undo()                                { apply({ .type = EditType::eUndo }); }
+    void redo()                                { apply({ .type = EditType::eRedo }); }
+
+    // Advance to the next frame; recorded events are stamped with the frame they happened on
+    void next_frame() { m_frame++; }
+
+    // Regenerate derived draw data if the polygon changed since frame was last updated; if
+    // is_preview is set, e.g. during drags, polygons above edit_preview_verts are instead drawn
+    // at a coarse LOD level, which retains the pinned vertex
+    void update_draw(EditFrame &frame, bool is_preview = false, std::optional<uint> pinned = { }) const;
+
+    // Rebuild the picking grid if the polygon or view changed since frame was last updated;
+    // returns whether the grid was rebuilt
+    bool update_pick(EditFrame &frame, const eig::ViewTransform &view, float radius) const;
+
+    // Start recording edits from the current state, or stop and return the recording
+    void      start_recording(eig::Array2u window_size);
+    EditTrace stop_recording();
+    bool      is_recording() const { return m_is_recording; }
+
+    const EditablePolygon             &polygon()  const { return m_polygon;  }
+    std::span<const eig::Vector2f>     verts()    const { return m_verts;    }
+    std::span<const eig::AlArray3f>    colrs()    const { return m_colrs;    }
+    const EditSettings                &settings() const { return m_settings; }
+    uint                               frame()    const { return m_frame;    }
+    uint                               revision() const { return m_revision; }
+    uint                               structure_revision() const { return m_structure_revision; }
+    const UndoHistory<EditVertex>     &history()  const { return m_history;  }
+  };
+
+  // Save/load an edit trace as json of the form
+  // { "window_size": [w, h], "frames": n, "settings": { ... }, "verts": [[x, y], ...],
+  //   "colrs": [[r, g, b], ...], "events": [{ "frame": f, "type": "move_vert", ... }, ...] }
+  void      save_edit_trace(const std::filesystem::path &path, const EditTrace &trace);
+  EditTrace load_edit_trace(const std::filesystem::path &path);
+} // namespace prg
@@ -0,0 +1,92 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <core/math.hpp>
+#include <core/utility.hpp>
+#include <span>
+#include <vector>
+
+namespace prg {
+  // Polygon editing structure with logarithmic-time structural edits; vertices are stored in
+  // an implicit treap ordered by position, where each subtree tracks its longest edge, s.t.
+  // insertion, deletion, vertex updates and longest-edge splits cost O(log n) expected time.
+  // Contiguous vertex/color buffers are produced on demand through flatten(...)
+  class EditablePolygon {
+    struct Node {
+      eig::Vector2f  vert     = eig::Vector2f::Zero();
+      eig::AlArray3f colr     = eig::AlArray3f::Zero();
+      uint           priority = 0;
+      uint           left = 0, right = 0;    // Child nodes; 0 denotes no child
+      uint           size = 1;               // Nr. of vertices in subtree
+      uint           first = 0, last = 0;    // First/last node of subtree, in order
+      float          edge_max = -1.f;        // Squared length of longest edge inside subtree
+      uint           edge_max_i = 0;         // Subtree-relative index of its first vertex
+    };
+
+    std::vector<Node> m_nodes = { Node { } }; // Node 0 is a sentinel
+    std::vector<uint> m_free;
+    uint              m_root = 0;
+    uint              m_seed = 0x9e3779b9u;
+
+    uint alloc_node(const eig::Vector2f &vert, const eig::AlArray3f &colr);
+    void pull(uint t);
+    std::pair<uint, uint> split(uint t, uint i);
+    uint merge(uint a, uint b);
+    uint find(uint i) const;
+    template <typename F> 
+    void update(uint t, uint i, F &&f);
+
+  public:
+    EditablePolygon() = default;
+    
+    // Build from vertex and color buffers of equal size in O(n)
+    EditablePolygon(std::span<const eig::Vector2f>  verts,
+                    std::span<const eig::AlArray3f> colrs);
+
+    uint size()  const { return m_root ? m_nodes[m_root].size : 0; }
+    bool empty() const { return m_root == 0; }
+
+    // Vertex access and updates by position
+    eig::Vector2f  vert(uint i) const { return m_nodes[find(i)].vert; }
+    eig::AlArray3f colr(uint i) const { return m_nodes[find(i)].colr; }
+    void set_vert(uint i, const eig::Vector2f &vert);
+    void set_colr(uint i, const eig::AlArray3f &colr);
+
+    // Insert a vertex before position i, s.t. it takes position i; i == size() appends
+    void insert(uint i, const eig::Vector2f &vert, const eig::AlArray3f &colr);
+
+    // Delete the vertex at position i
+    void erase(uint i);
+
+    // Return the position i of the longest edge (i, i + 1), including the closing edge
+    // (size() - 1, 0), in O(1); requires at least two vertices
+    uint longest_edge() const;
+
+    // Split the longest edge at its midpoint, interpolating colors; returns the 
+    // position of the inserted vertex
+    uint split_longest_edge();
+
+    // Write vertices and colors in order to contiguous buffers in O(n)
+    void flatten(std::vector<eig::Vector2f>  &verts,
+                 std::vector<eig::AlArray3f> &colrs) const;
+  };
+} // namespace prg
@@ -0,0 +1,96 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <core/math.hpp>
+#include <core/utility.hpp>
+#include <small_gl/window.hpp>
+#include <algorithm>
+#include <chrono>
+#include <optional>
+
+struct GLFWwindow;
+
+namespace prg {
+  // Redraw policy of a window loop
+  enum class RedrawMode : uint {
+    eContinuous = 0, // Poll events and redraw every frame
+    eOnDemand   = 1  // Block on events, and redraw only if a frame was invalidated
+  };
+
+  // Frame pacing construction arguments
+  struct FramePacerCreateInfo {
+    RedrawMode mode          = RedrawMode::eOnDemand;
+    bool       vsync         = true; // Sync buffer swaps to the display's refresh rate
+    float      frame_budget  = 0.f;  // Min. time between frames in seconds, if nonzero
+    uint       settle_frames = 3;    // Nr. of frames redrawn after an input event, s.t. ImGui settles
+  };
+
+  // Frame pacing statistics, measured over intervals of at least one second; cpu usage is
+  // process cpu time over wall time, s.t. one fully busy core measures 1
+  struct FramePacerStats {
+    float frame_rate     = 0.f; // Frames drawn per second
+    float cpu_usage      = 0.f; // Cpu usage of the whole process
+    float idle_cpu_usage = 0.f; // Cpu usage while waiting for the next frame
+  };
+
+  // Window loop pacing; in on-demand mode, wait_frame() blocks on window events until a frame
+  // is invalidated by input, by invalidate(), or by a redraw scheduled through invalidate_after().
+  // Input events are detected through glfw callbacks chained in front of existing ones, so
+  // a pacer must be created after the window, but before ImGui installs its own callbacks
+  class FramePacer {
+    using clock = std::chrono::steady_clock;
+
+    FramePacerCreateInfo             m_info;
+    GLFWwindow                      *m_window = nullptr;
+    uint                             m_frames_pending = 0;
+    std::optional<clock::time_point> m_deadline;   // Scheduled redraw, if any
+    clock::time_point                m_frame_last;
+
+    // Statistics over the current measurement interval
+    FramePacerStats   m_stats;
+    clock::time_point m_stats_wall;
+    double            m_stats_cpu   = 0.0;
+    double            m_idle_wall   = 0.0;
+    double            m_idle_cpu    = 0.0;
+    uint              m_stats_frames = 0;
+
+  public:
+    FramePacer() = default;
+    FramePacer(const gl::Window &window, FramePacerCreateInfo info);
+
+    // Process window events, and block until the next frame should be drawn or the window
+    // should close; in continuous mode, this only polls events and applies the frame budget
+    void wait_frame(gl::Window &window);
+
+    // Request a redraw of the next frame, or of a frame after a delay in seconds
+    void invalidate() { m_frames_pending = std::max(m_frames_pending, 1u); }
+    void invalidate_after(float seconds);
+
+    // Settings accessors
+    const FramePacerCreateInfo &info() const { return m_info; }
+    void set_mode(RedrawMode mode);
+    void set_vsync(bool vsync);
+    void set_frame_budget(float frame_budget) { m_info.frame_budget = std::max(frame_budget, 0.f); }
+
+    const FramePacerStats &stats() const { return m_stats; }
+  };
+} // namespace prg
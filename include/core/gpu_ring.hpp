@@ -0,0 +1,148 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <core/math.hpp>
+#include <core/utility.hpp>
+#include <cstddef>
+#include <span>
+#include <vector>
+
+namespace prg {
+  // Cumulative nr. of GL objects created through glad since install_gl_object_counters();
+  // differences between frames give per-frame creation counts
+  struct GlObjectCounts {
+    uint buffers      = 0;
+    uint arrays       = 0;
+    uint textures     = 0;
+    uint framebuffers = 0;
+    uint programs     = 0; // Programs and shaders
+    uint fences       = 0; // Sync objects, which a GpuRing creates once per frame by design
+
+    // Objects other than fences
+    uint objects() const { return buffers + arrays + textures + framebuffers + programs; }
+
+    GlObjectCounts operator-(const GlObjectCounts &o) const {
+      return { buffers - o.buffers, arrays - o.arrays, textures - o.textures,
+               framebuffers - o.framebuffers, programs - o.programs, fences - o.fences };
+    }
+  };
+
+  // Wrap glad's creation entry points with counting functions; requires a loaded GL context,
+  // and is a no-op if counters are already installed
+  void install_gl_object_counters();
+
+  // Counts since install_gl_object_counters(), or zero if counters are not installed
+  GlObjectCounts gl_object_counts();
+
+  struct GpuRingCreateInfo {
+    size_t slot_size = 1 << 16; // Initial size of a slot in bytes; slots grow on demand
+    uint   slots     = 3;       // Nr. of frames that may be in flight
+  };
+
+  // Ring of upload slots in a single persistent, coherently mapped GL buffer; each frame
+  // writes one slot by memcpy, and a fence placed once the frame's commands are submitted
+  // guards the slot until the gpu is done with it. Slots grow, by recreating the buffer, if a
+  // frame requires more space than a slot holds
+  class GpuRing {
+    uint                m_object    = 0;
+    std::byte          *m_mapped    = nullptr;
+    size_t              m_slot_size = 0;
+    size_t              m_align     = 1;   // Largest uniform/storage offset alignment
+    uint                m_slot      = 0;
+    size_t              m_head      = 0;   // Write offset inside current slot
+    bool                m_is_open   = false;
+    std::vector<void *> m_fences;          // GLsync per slot; null if unguarded
+    uint                m_stalls    = 0;   // Nr. of frames that waited on a fence
+    uint                m_grows     = 0;
+
+    void create(size_t slot_size, uint slots);
+    void destroy();
+
+  public:
+    GpuRing() = default;
+    explicit GpuRing(GpuRingCreateInfo info);
+    ~GpuRing();
+
+    GpuRing(GpuRing &&o) noexcept { swap(o); }
+    GpuRing &operator=(GpuRing &&o) noexcept { swap(o); return *this; }
+    GpuRing(const GpuRing &) = delete;
+    GpuRing &operator=(const GpuRing &) = delete;
+
+    // Fence the previous frame's slot, then move to the next slot and wait until the gpu has
+    // released it; slots are grown first if size bytes, spread over n_pushes aligned pushes,
+    // do not fit
+    void begin_frame(size_t size, uint n_pushes = 1);
+
+    // Copy data into the current slot at an offset aligned for uniform and storage bindings,
+    // and return its offset in the buffer
+    size_t push(std::span<const std::byte> data);
+
+    uint   object()    const { return m_object;    }
+    size_t slot_size() const { return m_slot_size; }
+    uint   slots()     const { return static_cast<uint>(m_fences.size()); }
+    uint   stalls()    const { return m_stalls;    }
+    uint   grows()     const { return m_grows;     }
+
+    void swap(GpuRing &o);
+  };
+
+  // Per-frame polygon draw data for the interactive test; elements, vertices, colors and the
+  // settings block are pushed into a GpuRing, and a vertex array, created once, has its
+  // bindings pointed at the frame's ranges. Bindings follow the draw shaders; settings at
+  // uniform binding 0, vertices and colors at storage bindings 0 and 1, and vertices and
+  // colors at attributes 0 and 1
+  class DrawUploads {
+    GpuRing m_ring;
+    uint    m_array        = 0;
+    uint    m_array_buffer = 0; // Ring buffer the vertex array's element binding refers to
+    size_t  m_elems_offset = 0, m_verts_offset    = 0, m_colrs_offset = 0, m_settings_offset = 0;
+    size_t  m_verts_size   = 0, m_colrs_size      = 0, m_settings_size = 0;
+    uint    m_elem_count   = 0;
+
+  public:
+    DrawUploads() = default;
+    explicit DrawUploads(GpuRingCreateInfo info);
+    ~DrawUploads();
+
+    DrawUploads(DrawUploads &&o) noexcept { swap(o); }
+    DrawUploads &operator=(DrawUploads &&o) noexcept { swap(o); return *this; }
+    DrawUploads(const DrawUploads &) = delete;
+    DrawUploads &operator=(const DrawUploads &) = delete;
+
+    // Push a frame's data; previous uploads stay valid until the gpu is done with them
+    void upload(std::span<const eig::Array3u>   elems,
+                std::span<const eig::Vector2f>  verts,
+                std::span<const eig::AlArray3f> colrs,
+                std::span<const std::byte>      settings);
+
+    // Bind the vertex array and buffer ranges of the last upload
+    void bind() const;
+
+    // Draw the last upload's elements with a GL primitive mode, using the bound program
+    void draw(uint mode) const;
+
+    uint           elem_count() const { return m_elem_count; }
+    const GpuRing &ring()       const { return m_ring;       }
+
+    void swap(DrawUploads &o);
+  };
+} // namespace prg
@@ -0,0 +1,96 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <core/edit_session.hpp>
+#include <core/math.hpp>
+#include <core/mvc.hpp>
+#include <core/program_cache.hpp>
+#include <glad/glad.h>
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+#include <array>
+#include <filesystem>
+#include <initializer_list>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace prg {
+  // Headless context on an EGL surfaceless display, e.g. Mesa's llvmpipe without a window
+  // system; draws go to an offscreen framebuffer
+  struct HeadlessContext {
+    EGLDisplay display = EGL_NO_DISPLAY;
+    EGLContext context = EGL_NO_CONTEXT;
+
+    HeadlessContext() {
+      display = eglGetPlatformDisplay(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+      if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr))
+        throw std::runtime_error("HeadlessContext() could not initialize a surfaceless EGL display");
+      eglBindAPI(EGL_OPENGL_API);
+
+      constexpr std::array<EGLint, 3> config_attribs = { EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE };
+      EGLConfig config;
+      EGLint    n_configs = 0;
+      eglChooseConfig(display, config_attribs.data(), &config, 1, &n_configs);
+
+      constexpr std::array<EGLint, 7> context_attribs = {
+        EGL_CONTEXT_MAJOR_VERSION,       4,
+        EGL_CONTEXT_MINOR_VERSION,       5,
+        EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+        EGL_NONE
+      };
+      context = eglCreateContext(display, n_configs ? config : EGL_NO_CONFIG_KHR, EGL_NO_CONTEXT, context_attribs.data());
+      if (context == EGL_NO_CONTEXT || !eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, context))
+        throw std::runtime_error("HeadlessContext() could not create a GL 4.5 core context");
+      if (!gladLoadGLLoader(reinterpret_cast<GLADloadproc>(eglGetProcAddress)))
+        throw std::runtime_error("HeadlessContext() could not load GL functions");
+    }
+
+    ~HeadlessContext() {
+      eglMakeCurrent(display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+      eglDestroyContext(display, context);
+      eglTerminate(display);
+    }
+  };
+
+  // Settings block at uniform binding 0, matching the interactive test's settings object and
+  // the std140 layout of the draw shaders; scalar members are tightly packed 4-byte values
+  struct CheckSettings {
+    alignas(16) eig::Matrix4f projection;
+    uint                      draw_lines     = false;
+    DrawMethod                draw_method    = DrawMethod::eMeanValueCoords;
+    MvcPrecision              draw_precision = MvcPrecision::eExact;
+  };
+
+  // Build a program from preprocessed glsl in the build's shader directory, as the interactive
+  // test loads them; programs go through cache, s.t. checks share its compile, link and error
+  // reporting, and are owned by it. Checks pass a cache without a file, which writes nothing
+  inline
+  uint load_program(ProgramCache &cache, const std::filesystem::path &dir,
+                    std::initializer_list<std::pair<GLenum, const char *>> stages) {
+    std::vector<ProgramStage> program;
+    for (const auto &[type, name] : stages)
+      program.push_back({ type, dir / name });
+    return cache.build(std::span(&program, 1)).front();
+  }
+} // namespace prg
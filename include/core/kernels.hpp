@@ -0,0 +1,123 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+// Note: this header is included by the per-ISA kernel translation units in src/core/kernels,
+// which are compiled with differing instruction set flags. It must therefore not pull in Eigen
+// or other headers whose inline functions could be emitted by, and merged across, those units
+#include <math.h>
+#include <cstddef>
+
+namespace prg {
+  using uint  = unsigned int;
+  using uchar = unsigned char;
+
+  // Instruction set variants of the core geometry kernels; eBaseline targets the
+  // compiler's default (SSE2 on x86-64), and the others are available on x86-64 only
+  enum class KernelIsa : uint {
+    eBaseline = 0,
+    eAVX2     = 1,
+    eAVX512   = 2
+  };
+
+  // Nr. of points evaluated together by batched, vectorizable kernels
+  constexpr uint kernel_block_size = 64;
+
+  // Largest vertex count with a compile-time specialized kernel; polygons of up to this
+  // many vertices are dispatched through a jump table, and larger ones take generic loops
+  constexpr uint kernel_max_fixed_size = 16;
+
+  // Tolerance for detecting points on polygon vertices/edges
+  constexpr float mvc_epsilon = 1e-6f;
+
+  // Function table of one instruction set variant of the core geometry kernels; polygon
+  // vertices and points are passed as interleaved xy floats
+  struct KernelTable {
+    const char *name;
+    KernelIsa   isa;
+
+    // Unnormalized mean value weights of at most kernel_block_size points; weights are
+    // stored per vertex in w (verts * kernel_block_size), their sums and validity per point
+    // in sum and valid. Points on a vertex or edge are invalid, and need a boundary fallback.
+    // Setting generic bypasses the fixed-size kernels, s.t. these can be compared against it
+    void (*mvc_block)(const float *verts, uint n, const float *points, uint size, bool fast,
+                      bool generic, float *w, float *sum, int *valid);
+
+    // Unnormalized Wachspress weights of at most kernel_block_size points, given per-vertex
+    // terms c (twice the area of corner triangles) and e2 (squared edge lengths); layout as
+    // in mvc_block, with points on or outside the boundary marked invalid
+    void (*wachspress_block)(const float *verts, const float *c, const float *e2, uint n,
+                             const float *points, uint size, bool generic, 
+                             float *w, float *sum, int *valid);
+
+    // Even-odd point-in-polygon test over a range of points
+    void (*inside_polygon)(const float *verts, uint n, const float *points, size_t size, uchar *out);
+
+    // Point-in-triangle test over a range of points, given a triangle's three vertices;
+    // points on an edge count as inside, and winding order is irrelevant
+    void (*inside_triangle)(const float *tri, const float *points, size_t size, uchar *out);
+  };
+
+  // Return whether the executing cpu and os support a kernel variant
+  bool is_kernel_supported(KernelIsa isa);
+
+  // Return the table of a specific kernel variant; throws if the variant is not supported
+  const KernelTable &kernel_table(KernelIsa isa);
+
+  // Return the kernel table selected for this process; picked once on first use as the
+  // widest variant supported by cpuid, or forced through the PRG_KERNEL_ISA environment
+  // variable set to 'baseline', 'avx2' or 'avx512' for testing
+  const KernelTable &kernel_table();
+
+  namespace dtl {
+    // Fast math approximations shared by scalar code and kernel variants; these are given
+    // internal linkage, s.t. each kernel variant gets its own instruction set's copy, and use
+    // C library functions only, which compile to plain instructions
+
+    // Approximation of atan2(y, x); Abramowitz & Stegun 4.4.49 minimax polynomial after
+    // reduction to [0, 1], with max. abs. error 1.2e-5 rad. Branch-free, s.t. it vectorizes
+    static inline
+    float atan2_fast(float y, float x) {
+      constexpr float pi = 3.14159265358979323846f;
+      float ax = fabsf(x), ay = fabsf(y);
+      float lo = ax < ay ? ax : ay, hi = ax < ay ? ay : ax;
+      float t  = lo / (hi > 1.17549435e-38f ? hi : 1.17549435e-38f);
+      float t2 = t * t;
+      float a  = t * (0.9998660f + t2 * (-0.3302995f + t2 * (0.1801410f + t2 * (-0.0851330f + t2 * 0.0208351f))));
+      a = ay > ax ? pi * .5f - a : a;
+      a = x < 0.f ? pi - a : a;
+      return y < 0.f ? -a : a;
+    }
+
+    // Approximation of tan(x) for |x| < pi / 2; [5/4] Pade approximant after reduction to
+    // |x| <= pi / 4 through tan(x) = 1 / tan(pi / 2 - x), with max. rel. error 1e-6 for
+    // |x| <= 1.5, growing to 5e-5 towards pi / 2 due to the reduction. Branch-free
+    static inline
+    float tan_fast(float x) {
+      constexpr float pi = 3.14159265358979323846f;
+      bool  is_reduced = fabsf(x) > pi * .25f;
+      float u  = is_reduced ? copysignf(pi * .5f, x) - x : x;
+      float u2 = u * u;
+      float t  = u * (945.f + u2 * (-105.f + u2)) / (945.f + u2 * (-420.f + u2 * 15.f));
+      return is_reduced ? 1.f / t : t;
+    }
+  } // namespace dtl
+} // namespace prg
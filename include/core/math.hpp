@@ -40,6 +40,7 @@
 // Include eigen headers after plugin extensions are specified
 #include <Eigen/Dense>
 #include <Eigen/Geometry>
+#include <span>
 
 namespace prg {
   // Introduce shorthands in the 'prg' namespace
@@ -113,6 +114,13 @@ namespace Eigen {
     }
   };
 
+  /* Define unsigned vector types, used by conversions below */
+
+  using Vector1u = Matrix<unsigned int, 1, 1>;
+  using Vector2u = Matrix<unsigned int, 2, 1>;
+  using Vector3u = Matrix<unsigned int, 3, 1>;
+  using Vector4u = Matrix<unsigned int, 4, 1>;
+
   /* Define some useful conversions */
   
   // Sourced from glm, actuallly
@@ -133,7 +141,8 @@ namespace Eigen {
     return trf;
   }
 
-  // Convert a screen-space vector in [0, 1] to world space
+  // Convert a screen-space vector in [0, 1] to world space; inverts mat on every call,
+  // so prefer ViewTransform below for repeated conversions
   inline
   Vector3f screen_to_world_space(const Vector2f      &v,
                                  const Projective3f  &mat) {
@@ -182,6 +191,111 @@ namespace Eigen {
                                  const Vector2f     &size) { // window size
     return screen_to_window_space(world_to_screen_space(v, mat), offs, size);
   }
+
+  namespace dtl {
+    // Apply a 3x3 homogeneous transform to a span of 2d points; in and out may alias
+    inline
+    void apply_homogeneous(const Matrix3f           &m,
+                           std::span<const Vector2f> in,
+                           std::span<Vector2f>       out) {
+      if (in.empty())
+        return;
+      const float m00 = m(0, 0), m01 = m(0, 1), m02 = m(0, 2);
+      const float m10 = m(1, 0), m11 = m(1, 1), m12 = m(1, 2);
+      const float m20 = m(2, 0), m21 = m(2, 1), m22 = m(2, 2);
+      const float *src = reinterpret_cast<const float *>(in.data());
+      float       *dst = reinterpret_cast<float *>(out.data());
+
+      #pragma omp simd
+      for (size_t i = 0; i < in.size(); ++i) {
+        float x = src[2 * i], y = src[2 * i + 1];
+        float rcp_w = 1.f / (m20 * x + m21 * y + m22);
+        dst[2 * i]     = (m00 * x + m01 * y + m02) * rcp_w;
+        dst[2 * i + 1] = (m10 * x + m11 * y + m12) * rcp_w;
+      }
+    }
+  } // namespace dtl
+
+  // Cached coordinate-space transforms of a single view; holds a camera view/proj matrix and
+  // its inverse, and the window offset/size, s.t. conversions avoid per-call inversion. The
+  // batched forms act on the world-space z = 0 plane, where 2d geometry lives, and fold the 
+  // full conversion chain into one homogeneous 3x3 matrix for a single streaming pass
+  class ViewTransform {
+    Matrix4f m_trf, m_trf_inv;
+    Matrix3f m_plane_to_window, m_window_to_plane;
+    Array2f  m_offs, m_size;
+
+  public:
+    ViewTransform()
+    : ViewTransform(Projective3f::Identity(), Array2f::Zero(), Array2f::Ones())
+    { }
+
+    ViewTransform(const Projective3f &trf,    // camera view/proj matrix
+                  const Array2f      &offs,   // window offset
+                  const Array2f      &size)   // window size
+    : m_trf(trf.matrix()), m_trf_inv(trf.matrix().inverse()), m_offs(offs), m_size(size) {
+      // World-space plane to clip space; drops the z column and row of the camera matrix
+      Matrix3f plane_to_clip;
+      plane_to_clip << m_trf(0, 0), m_trf(0, 1), m_trf(0, 3),
+                       m_trf(1, 0), m_trf(1, 1), m_trf(1, 3),
+                       m_trf(3, 0), m_trf(3, 1), m_trf(3, 3);
+      
+      // Clip space to window space; maps [-1, 1] to the window, flipping y
+      Matrix3f clip_to_window;
+      clip_to_window << .5f * size.x(),  0.f,            offs.x() + .5f * size.x(),
+                        0.f,            -.5f * size.y(), offs.y() + .5f * size.y(),
+                        0.f,             0.f,            1.f;
+
+      m_plane_to_window = clip_to_window * plane_to_clip;
+      m_window_to_plane = m_plane_to_window.inverse();
+    }
+
+    const Matrix4f &matrix()  const { return m_trf;     }
+    const Matrix4f &inverse() const { return m_trf_inv; }
+    const Array2f  &offs()    const { return m_offs;    }
+    const Array2f  &size()    const { return m_size;    }
+
+    // Convert a world-space vector to screen space in [0, 1]
+    Vector2f world_to_screen(const Vector3f &v) const {
+      Array4f trf = m_trf * (Vector4f() << v, 1).finished();
+      return trf.head<2>() / trf.w() * .5f + .5f;
+    }
+
+    // Convert a screen-space vector in [0, 1] to world space
+    Vector3f screen_to_world(const Vector2f &v) const {
+      Array2f v_ = (v.array() - 0.5f) * 2.f;
+      Array4f trf = m_trf_inv * (Vector4f() << v_, 0, 1).finished();
+      return trf.head<3>() / trf[3];
+    }
+
+    Vector2f screen_to_window(const Vector2f &v) const {
+      return screen_to_window_space(v, m_offs, m_size);
+    }
+
+    Vector2f window_to_screen(const Vector2f &v) const {
+      return window_to_screen_space(v, m_offs, m_size);
+    }
+
+    Vector2f world_to_window(const Vector3f &v) const {
+      return screen_to_window(world_to_screen(v));
+    }
+
+    Vector3f window_to_world(const Vector2f &v) const {
+      return screen_to_world(window_to_screen(v));
+    }
+
+    // Batched conversion of points on the world-space z = 0 plane to window space
+    // - out is expected to be of size in.size(), and may alias in
+    void world_to_window(std::span<const Vector2f> in, std::span<Vector2f> out) const {
+      dtl::apply_homogeneous(m_plane_to_window, in, out);
+    }
+
+    // Batched conversion of window-space points to the world-space z = 0 plane
+    // - out is expected to be of size in.size(), and may alias in
+    void window_to_world(std::span<const Vector2f> in, std::span<Vector2f> out) const {
+      dtl::apply_homogeneous(m_window_to_plane, in, out);
+    }
+  };
   
   /* Define useful integer types */
 
@@ -200,11 +314,6 @@ namespace Eigen {
   using Array3u = Array<unsigned int, 3, 1>;
   using Array4u = Array<unsigned int, 4, 1>;
 
-  using Vector1u = Matrix<unsigned int, 1, 1>;
-  using Vector2u = Matrix<unsigned int, 2, 1>;
-  using Vector3u = Matrix<unsigned int, 3, 1>;
-  using Vector4u = Matrix<unsigned int, 4, 1>;
-
   /* Define common aligned vector types */
   
   using AlArray3s  = AlArray<short, 3>;
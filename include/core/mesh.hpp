@@ -2,15 +2,20 @@
 
 #include <core/math.hpp>
 #include <core/utility.hpp>
+#include <algorithm>
+#include <cmath>
 #include <numeric>
 #include <numbers>
+#include <random>
 
 namespace prg {
   namespace dtl {
+    inline
     float outer_product(eig::Vector2f a, eig::Vector2f b) {
       return (a * b.transpose())(0,0);
     }
 
+    inline
     eig::Vector3f get_barycentric_coords(eig::Vector2f a, eig::Vector2f b, eig::Vector2f c, eig::Vector2f p) {
       eig::Vector2f ab = b - a, ac = c - a;
       float a_tri = std::abs(.5f * outer_product(ac, ab));
@@ -19,6 +24,8 @@ namespace prg {
       float a_bc  = std::abs(.5f * outer_product(c - p, b - p));
       return (eig::Vector3f(a_bc, a_ac, a_ab) / a_tri).eval();
     }
+
+    inline
     bool is_inside_triangle(eig::Vector2f a, eig::Vector2f b, eig::Vector2f c, eig::Vector2f p) {
       auto abc = get_barycentric_coords(a, b, c, p).array().eval();
       return (abc <= 1.0f).all() && (abc >= 0.f).all();
@@ -49,63 +56,178 @@ namespace prg {
     }
   } // namespace dtl
 
-  // Triangulate a polygon that is based solely on an ordered set of vertices,
-  // and is possibly concave. Uses ear-clipping algorithm, and badly at that haha!
+  // Test whether a point lies inside a possibly concave polygon, based on an 
+  // ordered set of vertices; uses the even-odd crossing rule
   inline
-  std::vector<eig::Array3u> triangulate_polygon(std::span<const eig::Vector2f> verts) {
-    // Establish initial index list of the polygon's exterior edgess
-    std::vector<uint> elems_polygon(verts.size());
-    std::iota(range_iter(elems_polygon), 0u);
+  bool is_inside_polygon(std::span<const eig::Vector2f> verts, eig::Vector2f p) {
+    bool is_inside = false;
+    for (uint i = 0, j = verts.size() - 1; i < verts.size(); j = i++) {
+      const auto &a = verts[i], &b = verts[j];
+      guard_continue((a.y() > p.y()) != (b.y() > p.y()));
+      float x = a.x() + (p.y() - a.y()) * (b.x() - a.x()) / (b.y() - a.y());
+      if (p.x() < x)
+        is_inside = !is_inside;
+    }
+    return is_inside;
+  }
+
+  // Batched form of is_inside_polygon(...), dispatched to the selected kernel variant in
+  // kernels.hpp and distributed over available threads
+  // - out is expected to be of size points.size()
+  void is_inside_polygon(std::span<const eig::Vector2f> verts,
+                         std::span<const eig::Vector2f> points,
+                         std::span<uchar>               out);
 
-    // Establish empty list of triangle connections, to be filled
-    std::vector<eig::Array3u> elems_triangles;
+  // Batched test whether points lie inside a triangle or on its edges, regardless of
+  // winding order, dispatched to the selected kernel variant in kernels.hpp
+  // - out is expected to be of size points.size()
+  void is_inside_triangle(eig::Vector2f                  a,
+                          eig::Vector2f                  b,
+                          eig::Vector2f                  c,
+                          std::span<const eig::Vector2f> points,
+                          std::span<uchar>               out);
+
+  // Test whether a polygon, based on an ordered set of vertices, is convex; all turns
+  // must share orientation, and the polygon must wind around exactly once, which rejects
+  // self-intersecting polygons such as pentagrams. Collinear vertices are permitted
+  inline
+  bool is_convex_polygon(std::span<const eig::Vector2f> verts) {
+    guard(verts.size() >= 3, false);
     
-    // Loop until the polygon description holds no triangles
-    while (elems_polygon.size() > 2) {
-      // Iterate to search for a valid, clippable triangle
-      uint i_ = 0;
-      for (; i_ < elems_polygon.size(); ++i_) {
-        uint i_prev = (int(i_) - 1 + elems_polygon.size()) % elems_polygon.size();
-        uint i_next = (int(i_) + 1) % elems_polygon.size();
-        
-        // Indices of previous, next, and their vertices
-        uint i = elems_polygon[i_prev], j = elems_polygon[i_], k = elems_polygon[i_next];
-        auto vert_i = verts[i], vert_j = verts[j], vert_k = verts[k];
-        
-        // Test local convexity of resulting triangle w.r.t CCW orientation
-        /* {
-          eig::Vector2f a = vert_i - vert_j, b = vert_k - vert_j;
-          float angle = std::atan2(dtl::outer_product(b, a), b.dot(a));
-          if (angle < 0.f)
-            angle += 2.f * std::numbers::pi_v<float>;
-          guard_continue(angle <= std::numbers::pi_v<float>);
-        } */
-
-        // Test potential overlap of other vertices inside resulting triangle
-        {
-          bool is_overlapping = false;
-          for (uint l = 0; l < elems_polygon.size(); ++l) {
-            guard_continue(l != i_ && l != i_prev && l != i_next);
-            auto p = verts[elems_polygon[l]];
-            if (dtl::is_inside_triangle(vert_i, vert_j, vert_k, p)) {
-              is_overlapping = true;
-              break;
-            }
-          }
-          guard_continue(!is_overlapping);
-        }
-
-        // If triangle is an ear, clip it from the polygon
-        elems_polygon.erase(elems_polygon.begin() + i_);
-        elems_triangles.push_back({ i, j, k });
-        break;
-      }
-
-      // If this was reached, no triangulation is available
-      if (i_ == elems_polygon.size())
-        return {};
+    float sign = 0.f, angle_sum = 0.f;
+    for (uint i = 0; i < verts.size(); ++i) {
+      eig::Vector2f a = verts[(i + 1) % verts.size()] - verts[i];
+      eig::Vector2f b = verts[(i + 2) % verts.size()] - verts[(i + 1) % verts.size()];
+      float cross = a.x() * b.y() - a.y() * b.x();
+      guard_continue(cross != 0.f);
+      guard(sign == 0.f || (cross > 0.f) == (sign > 0.f), false);
+      sign       = cross;
+      angle_sum += std::atan2(cross, a.dot(b));
+    }
+    return std::abs(std::abs(angle_sum) - 2.f * std::numbers::pi_v<float>) < 1e-3f;
+  }
+
+  // Generate a convex, regular polygon of n vertices in counter-clockwise order,
+  // centered inside [0, 1]^2
+  inline
+  std::vector<eig::Vector2f> generate_regular_polygon(uint n, float radius = .4f) {
+    std::vector<eig::Vector2f> verts(n);
+    for (uint i = 0; i < n; ++i) {
+      float phi = 2.f * std::numbers::pi_v<float> * static_cast<float>(i) / static_cast<float>(n);
+      verts[i] = eig::Vector2f(.5f + radius * std::cos(phi), .5f + radius * std::sin(phi));
+    }
+    return verts;
+  }
+
+  // Generate a concave, star-shaped polygon of n vertices in counter-clockwise order,
+  // alternating between outer and inner radii
+  inline
+  std::vector<eig::Vector2f> generate_star_polygon(uint n, float radius_outer = .45f, float radius_inner = .2f) {
+    auto verts = generate_regular_polygon(n, 1.f);
+    for (uint i = 0; i < n; ++i) {
+      float radius = (i % 2) ? radius_inner : radius_outer;
+      verts[i] = (eig::Vector2f(.5f, .5f) + radius * (verts[i] - eig::Vector2f(.5f, .5f))).eval();
+    }
+    return verts;
+  }
+
+  // Generate a random, possibly concave, star-shaped polygon of n vertices in
+  // counter-clockwise order, with radii drawn uniformly from [radius_min, radius_max]
+  inline
+  std::vector<eig::Vector2f> generate_random_polygon(uint n, uint seed = 0, float radius_min = .1f, float radius_max = .45f) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> distr(radius_min, radius_max);
+    auto verts = generate_regular_polygon(n, 1.f);
+    for (auto &vert : verts)
+      vert = (eig::Vector2f(.5f, .5f) + distr(rng) * (vert - eig::Vector2f(.5f, .5f))).eval();
+    return verts;
+  }
+
+  // Generate a star-shaped polygon of n vertices in counter-clockwise order, whose boundary
+  // resembles a coastline; radii follow a periodic midpoint displacement over vertex indices,
+  // where displacements scale with the index range's length to the power of roughness
+  inline
+  std::vector<eig::Vector2f> generate_coastline_polygon(uint n, uint seed = 0, float roughness = .6f) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> distr(-1.f, 1.f);
+    std::vector<float> radii(n + 1);
+    radii[0] = radii[n] = .3f;
+
+    std::vector<std::pair<uint, uint>> ranges = { { 0, n } };
+    while (!ranges.empty()) {
+      auto [first, last] = ranges.back();
+      ranges.pop_back();
+      guard_continue(last - first > 1);
+      uint  mid   = (first + last) / 2;
+      float scale = .15f * std::pow(static_cast<float>(last - first) / static_cast<float>(n), roughness);
+      radii[mid]  = std::clamp(.5f * (radii[first] + radii[last]) + scale * distr(rng), .05f, .45f);
+      ranges.push_back({ first, mid });
+      ranges.push_back({ mid, last });
     }
 
-    return elems_triangles;
+    auto verts = generate_regular_polygon(n, 1.f);
+    for (uint i = 0; i < n; ++i)
+      verts[i] = (eig::Vector2f(.5f, .5f) + radii[i] * (verts[i] - eig::Vector2f(.5f, .5f))).eval();
+    return verts;
+  }
+
+  // Vertex range [first, last) of ring r of a polygon with holes, whose rings' vertices are
+  // concatenated; ring 0 is the outer ring, and hole_offsets holds the first vertex of each hole
+  inline
+  std::pair<uint, uint> polygon_ring(std::span<const uint> hole_offsets, uint n, uint r) {
+    uint first = r == 0 ? 0 : hole_offsets[r - 1];
+    uint last  = r < hole_offsets.size() ? hole_offsets[r] : n;
+    return { first, last };
+  }
+
+  // Generate a polygon with holes of n vertices in total; half of these form a regular outer
+  // ring in counter-clockwise order, and the remainder is split over random, star-shaped holes
+  // in clockwise order, placed on a jittered grid inside the outer ring. Hole start offsets
+  // are written to hole_offsets, as in polygon_ring(...)
+  inline
+  std::vector<eig::Vector2f> generate_holed_polygon(uint n, uint n_holes, std::vector<uint> &hole_offsets, uint seed = 0) {
+    uint n_hole  = n_holes > 0 ? std::max((n - n / 2) / n_holes, 3u) : 0;
+    uint n_outer = std::max(n - n_holes * n_hole, 3u);
+    auto verts   = generate_regular_polygon(n_outer, .45f);
+
+    // Holes occupy cells of a k x k grid in a square inscribed in the outer ring
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> distr(0.f, 1.f);
+    uint  k    = static_cast<uint>(std::ceil(std::sqrt(static_cast<float>(n_holes))));
+    float cell = .6f / std::max(k, 1u);
+    hole_offsets.clear();
+    for (uint h = 0; h < n_holes; ++h) {
+      eig::Vector2f center = eig::Vector2f(.2f, .2f) 
+                           + cell * eig::Vector2f(h % k + .4f + .2f * distr(rng), h / k + .4f + .2f * distr(rng));
+      auto hole = generate_random_polygon(n_hole, seed + h + 1, .15f, .35f);
+      hole_offsets.push_back(verts.size());
+      for (auto it = hole.rbegin(); it != hole.rend(); ++it)
+        verts.push_back((center + cell * (*it - eig::Vector2f(.5f, .5f))).eval());
+    }
+    return verts;
   }
+
+  // Execution of triangulate_polygon(...); eParallel splits large polygons into pieces along
+  // interior diagonals, which are then triangulated concurrently
+  enum class TriangulateMode : uint {
+    eSerial   = 0,
+    eParallel = 1
+  };
+
+  // Triangulate a possibly concave polygon with holes, given as in polygon_ring(...); rings
+  // may be in either winding order, and output triangles index verts in counter-clockwise
+  // order. Holes are processed in order of their leftmost vertex, and each is bridged to the
+  // nearest visible vertex to its left on the outer ring, which by then includes previously
+  // bridged holes; bridge targets are found through a uniform grid over the rings' edges.
+  // The resulting single ring is ear-clipped, where ear tests only visit reflex vertices near
+  // the ear through a kd-tree. Ear clipping falls back to removing degeneracies and splitting
+  // the ring if it stalls, e.g. for self-intersecting input. Near-linear in practice.
+  // In parallel mode, rings above a size threshold are first split along valid diagonals
+  // into a few pieces per thread, largest ring first; diagonals are found by casting rays
+  // across the ring from a few of its nodes, where passes over its edges run in parallel.
+  // Pieces are ear-clipped concurrently and concatenated; the triangulation may differ from
+  // the serial one, but covers the same area with the same nr. of triangles
+  std::vector<eig::Array3u> triangulate_polygon(std::span<const eig::Vector2f> verts,
+                                                std::span<const uint>          hole_offsets = { },
+                                                TriangulateMode                mode = TriangulateMode::eSerial);
 } // namespace prg
\ No newline at end of file
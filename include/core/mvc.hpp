@@ -0,0 +1,139 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <core/math.hpp>
+#include <core/utility.hpp>
+#include <span>
+#include <vector>
+
+namespace prg {
+  // Generalized barycentric coordinates available to CPU evaluation; eAuto selects
+  // Wachspress coordinates for convex polygons, and mean value coordinates otherwise
+  enum class CoordMethod : uint {
+    eMeanValue  = 0,
+    eWachspress = 1,
+    eAuto       = 2
+  };
+
+  // Precision of transcendental functions in mean value coordinate evaluation; eExact uses
+  // the standard library, while eFast uses a minimax polynomial for atan2 (max. abs. error 
+  // 1.2e-5 rad) and a Pade approximant for tan (max. rel. error 1e-6 for |x| <= 1.5), both 
+  // branch-free s.t. they vectorize. On the polygon generators in mesh.hpp with up to 64 
+  // vertices, max. abs. weight error against eExact is below 5e-5 inside the polygon
+  enum class MvcPrecision : uint {
+    eExact = 0,
+    eFast  = 1
+  };
+
+  // Evaluate mean value coordinates of a point w.r.t. a closed polygon, based on an ordered
+  // set of vertices; the polygon is possibly concave. Follows Floater's formulation using
+  // signed angles, s.t. weights are well-defined inside and outside the polygon. Points on
+  // a vertex or edge fall back to the (linear) boundary interpolant.
+  // - weights is expected to be of size verts.size()
+  void eval_mvc(std::span<const eig::Vector2f> verts,
+                eig::Vector2f                  p,
+                std::span<float>               weights,
+                MvcPrecision                   precision = MvcPrecision::eExact);
+
+  // Batched form of eval_mvc(...), which evaluates blocks of points in a vectorizable
+  // structure-of-arrays layout, and distributes blocks over available threads;
+  // weights is expected to be of size points.size() * verts.size(), and is laid out
+  // per point, s.t. the weights of point i start at weights[i * verts.size()]
+  void eval_mvc(std::span<const eig::Vector2f> verts,
+                std::span<const eig::Vector2f> points,
+                std::span<float>               weights,
+                MvcPrecision                   precision = MvcPrecision::eExact);
+
+  // Evaluate mean value coordinates and their analytic gradients w.r.t. p in a single pass
+  // over the polygon's edges, reusing per-edge terms; gradients are zero for points on the
+  // boundary, where they are undefined
+  // - weights and grads are expected to be of size verts.size()
+  void eval_mvc(std::span<const eig::Vector2f> verts,
+                eig::Vector2f                  p,
+                std::span<float>               weights,
+                std::span<eig::Vector2f>       grads,
+                MvcPrecision                   precision = MvcPrecision::eExact);
+
+  // Batched form of eval_mvc(...) with gradients; layout of weights and grads
+  // matches the batched weights-only form
+  void eval_mvc(std::span<const eig::Vector2f> verts,
+                std::span<const eig::Vector2f> points,
+                std::span<float>               weights,
+                std::span<eig::Vector2f>       grads,
+                MvcPrecision                   precision = MvcPrecision::eExact);
+
+  // Orientation signs of a polygon's rings, given as in polygon_ring(...) in mesh.hpp, by
+  // which eval_mvc(...) scales their weights s.t. holes wind opposite to the outer ring;
+  // reversing a ring's winding order negates its weights
+  std::vector<float> mvc_ring_signs(std::span<const eig::Vector2f> verts,
+                                    std::span<const uint>          hole_offsets);
+
+  // Evaluate mean value coordinates of a point w.r.t. a polygon with holes, given as in
+  // polygon_ring(...) in mesh.hpp; each ring holds at least three vertices. Following Hormann
+  // and Floater, unnormalized weights of all rings are summed before normalization, with holes
+  // oriented opposite to the outer ring; rings may be in either winding order. Points on any
+  // ring's vertex or edge fall back to that ring's boundary interpolant.
+  // - weights is expected to be of size verts.size()
+  void eval_mvc(std::span<const eig::Vector2f> verts,
+                std::span<const uint>          hole_offsets,
+                eig::Vector2f                  p,
+                std::span<float>               weights,
+                MvcPrecision                   precision = MvcPrecision::eExact);
+
+  // Batched form of eval_mvc(...) for polygons with holes, distributed over available threads
+  // per point; layout of weights matches the batched form of eval_mvc(...)
+  void eval_mvc(std::span<const eig::Vector2f> verts,
+                std::span<const uint>          hole_offsets,
+                std::span<const eig::Vector2f> points,
+                std::span<float>               weights,
+                MvcPrecision                   precision = MvcPrecision::eExact);
+
+  // Evaluate Wachspress coordinates of a point w.r.t. a closed, convex polygon, based on an
+  // ordered set of vertices; these are rational and need no trigonometry. Points on the
+  // boundary, or outside the polygon where coordinates degenerate, fall back to eval_mvc(...)
+  // - weights is expected to be of size verts.size()
+  void eval_wachspress(std::span<const eig::Vector2f> verts,
+                       eig::Vector2f                  p,
+                       std::span<float>               weights);
+
+  // Batched form of eval_wachspress(...), which evaluates blocks of points in a vectorizable
+  // structure-of-arrays layout, and distributes blocks over available threads; layout of
+  // weights matches the batched form of eval_mvc(...)
+  void eval_wachspress(std::span<const eig::Vector2f> verts,
+                       std::span<const eig::Vector2f> points,
+                       std::span<float>               weights);
+  
+  // Batched evaluation of generalized barycentric coordinates through a selected method;
+  // layout of weights matches the batched form of eval_mvc(...)
+  void eval_coords(CoordMethod                    method,
+                   std::span<const eig::Vector2f> verts,
+                   std::span<const eig::Vector2f> points,
+                   std::span<float>               weights);
+
+  // Interpolate a polygon's vertex colors at a point using mean value coordinates;
+  // weights acts as scratch space of size verts.size()
+  eig::Array3f eval_mvc_colr(std::span<const eig::Vector2f>  verts,
+                             std::span<const eig::AlArray3f> colrs,
+                             eig::Vector2f                   p,
+                             std::span<float>                weights,
+                             MvcPrecision                    precision = MvcPrecision::eExact);
+} // namespace prg
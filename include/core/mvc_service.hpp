@@ -0,0 +1,181 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <core/math.hpp>
+#include <core/mvc.hpp>
+#include <core/utility.hpp>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string_view>
+
+namespace prg {
+  // Local evaluation service for mean value coordinates and triangulations; a server accepts
+  // clients over a Unix domain socket, and each client hands it a shared memory arena once,
+  // on connection. Requests then only carry offsets into that arena, s.t. polygons, query
+  // points and results never pass through the socket. POSIX only
+  enum class MvcRequestType : uint {
+    eTriangulate = 0, // Write triangulate_polygon(...) of the polygon to out
+    eEvalMvc     = 1  // Write batched eval_mvc(...) weights of all points to out
+  };
+
+  enum class MvcStatus : uint {
+    eOk        = 0,
+    eInvalid   = 1, // Ranges outside the arena, a misaligned output range, or an invalid polygon
+    eTooSmall  = 2  // Output range cannot hold the result; count holds the required size
+  };
+
+  // Request message; ranges are byte offsets into the client's arena, and holes are given
+  // as in polygon_ring(...) in mesh.hpp
+  struct MvcRequest {
+    MvcRequestType type;
+    MvcPrecision   precision = MvcPrecision::eExact;
+    uint           n_verts   = 0;
+    uint           n_holes   = 0;
+    uint           n_points  = 0;
+    uint           padding   = 0;
+    uint64_t       verts_offset  = 0;
+    uint64_t       holes_offset  = 0;
+    uint64_t       points_offset = 0;
+    uint64_t       out_offset    = 0;
+    uint64_t       out_size      = 0; // In bytes
+  };
+
+  // Reply message to a request
+  struct MvcReply {
+    MvcStatus status;
+    uint      count;        // Nr. of triangles or weights written
+    uint64_t  polygon_hash; // Hash over the polygon's sizes, vertices and holes
+    uint      is_cached;    // Result was served from the server's cache
+    uint      batch_size;   // Nr. of requests coalesced into the same evaluation
+  };
+
+  struct MvcServerInfo {
+    std::filesystem::path path;                       // Socket path; an existing socket is replaced
+    size_t                cache_size   = 256ull << 20; // Upper bound on cached results, in bytes
+    uint                  batch_window = 200;          // Time to wait for further requests, in µs
+    uint                  max_batch    = 256;          // Max. nr. of requests coalesced at once
+  };
+
+  // Server statistics, accumulated since construction
+  struct MvcServerStats {
+    uint64_t requests    = 0;
+    uint64_t batches     = 0; // Nr. of times pending requests were processed together
+    uint64_t evaluations = 0; // Nr. of batched eval_mvc(...) calls
+    uint64_t coalesced   = 0; // Requests served by another request's evaluation
+    uint64_t hits        = 0; // Requests served from cache
+    uint64_t misses      = 0;
+    uint     clients     = 0; // Nr. of currently connected clients
+  };
+
+  // Evaluation server; run() serves clients on the calling thread until stop() is called.
+  // Requests that arrive within a short window are processed together; evaluation requests on
+  // the same polygon, across clients, are concatenated into a single batched eval_mvc(...)
+  // call, and identical requests are evaluated once. Triangulations and weights are cached
+  // by polygon hash, and weights additionally by a hash over the query points, in a least
+  // recently used cache bounded in bytes
+  class MvcServer {
+    struct Impl;
+
+    Impl *m_impl = nullptr;
+
+  public:
+    explicit MvcServer(MvcServerInfo info);
+    ~MvcServer();
+
+    MvcServer(const MvcServer &) = delete;
+    MvcServer &operator=(const MvcServer &) = delete;
+
+    // Serve clients until stop() is called; blocks the calling thread
+    void run();
+
+    // Make run() return; safe to call from other threads and from signal handlers
+    void stop();
+
+    MvcServerStats stats() const;
+  };
+
+  // Client connection to an MvcServer, with its own shared memory arena; requests are
+  // synchronous, and a client must not be shared between threads. Arena memory is handed out
+  // by alloc(...) in a bump allocator, and released all at once by reset()
+  class MvcClient {
+    int        m_socket = -1;
+    std::byte *m_arena  = nullptr;
+    size_t     m_size   = 0;
+    size_t     m_head   = 0;
+
+    // Offset into the arena of a byte range; throws if the range does not lie inside of it
+    uint64_t offset_of(std::span<const std::byte> data) const;
+
+    MvcReply request(const MvcRequest &request);
+
+  public:
+    MvcClient() = default;
+    MvcClient(const std::filesystem::path &path, size_t arena_size = 64ull << 20);
+    ~MvcClient();
+
+    MvcClient(MvcClient &&o) noexcept { swap(o); }
+    MvcClient &operator=(MvcClient &&o) noexcept { swap(o); return *this; }
+    MvcClient(const MvcClient &) = delete;
+    MvcClient &operator=(const MvcClient &) = delete;
+
+    // Allocate n values in the arena, aligned to 64 bytes; throws if the arena is full
+    template <typename T>
+    std::span<T> alloc(size_t n) {
+      size_t offset = ceil_div(m_head, 64) * 64;
+      if (offset + n * sizeof(T) > m_size)
+        dtl::throw_keyed_error("MvcClient::alloc(...) failed", "allocation exceeds arena size");
+      m_head = offset + n * sizeof(T);
+      return { reinterpret_cast<T *>(m_arena + offset), n };
+    }
+
+    // Copy values into a new arena allocation
+    template <typename T>
+    std::span<T> alloc(std::span<const T> data) {
+      auto s = alloc<T>(data.size());
+      std::ranges::copy(data, s.begin());
+      return s;
+    }
+
+    // Release all arena allocations
+    void reset() { m_head = 0; }
+
+    // Triangulate a polygon with holes into elems; all spans must lie in the arena
+    MvcReply triangulate(std::span<const eig::Vector2f> verts,
+                         std::span<const uint>          hole_offsets,
+                         std::span<eig::Array3u>        elems);
+
+    // Evaluate mean value coordinates of points w.r.t. a polygon with holes into weights,
+    // laid out as in the batched eval_mvc(...); all spans must lie in the arena
+    MvcReply eval_mvc(std::span<const eig::Vector2f> verts,
+                      std::span<const uint>          hole_offsets,
+                      std::span<const eig::Vector2f> points,
+                      std::span<float>               weights,
+                      MvcPrecision                   precision = MvcPrecision::eExact);
+
+    bool is_connected() const { return m_socket >= 0; }
+
+    void swap(MvcClient &o);
+  };
+} // namespace prg
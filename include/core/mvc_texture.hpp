@@ -0,0 +1,96 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <core/edit_session.hpp>
+#include <core/math.hpp>
+#include <core/utility.hpp>
+#include <span>
+#include <vector>
+
+namespace prg {
+  // Maximum nr. of polygon vertices the weight texture holds; matches N_MAX in
+  // eval_mvc_weights.comp. Weights of 4 vertices are packed per layer
+  constexpr uint mvc_texture_max_verts = 16;
+
+  // Workgroup size of eval_mvc_weights.comp along both axes
+  constexpr uint mvc_texture_group_size = 16;
+
+  // Per-pixel generalized barycentric weights of the viewport, held in an rgba32f texture
+  // array and evaluated by the eval_mvc_weights.comp compute shader; weights only depend on
+  // vertex positions, view and method, s.t. they are re-evaluated only when one of these
+  // changes, and color edits only need a blend pass over the cached weights
+  class MvcWeightTexture {
+    uint         m_texture = 0;
+    eig::Array2u m_size    = 0;
+    uint         m_layers  = 0;
+    uint         m_evals   = 0; // Nr. of evaluations, for diagnostics
+
+    // Key of the cached weights
+    bool                       m_is_valid   = false;
+    std::vector<eig::Vector2f> m_verts;
+    eig::Matrix4f              m_projection = eig::Matrix4f::Zero();
+    DrawMethod                 m_method     = DrawMethod::eBarycentric;
+
+    void destroy();
+
+  public:
+    MvcWeightTexture() = default;
+    ~MvcWeightTexture();
+
+    MvcWeightTexture(MvcWeightTexture &&o) noexcept { swap(o); }
+    MvcWeightTexture &operator=(MvcWeightTexture &&o) noexcept { swap(o); return *this; }
+    MvcWeightTexture(const MvcWeightTexture &) = delete;
+    MvcWeightTexture &operator=(const MvcWeightTexture &) = delete;
+
+    // Whether a polygon of n vertices fits in the texture
+    static bool supports(uint n) { return n >= 3 && n <= mvc_texture_max_verts; }
+
+    // Whether the cached weights were evaluated for different vertices, view or method
+    bool is_stale(std::span<const eig::Vector2f> verts,
+                  eig::Array2u                   size,
+                  const eig::Matrix4f           &projection,
+                  DrawMethod                     method) const;
+
+    // Evaluate weights over a viewport of the given size, (re)allocating the texture if its
+    // size or layer count changed; expects eval_mvc_weights.comp to be bound, alongside the
+    // vertices at storage binding 0 and the settings block at uniform binding 0, whose
+    // projection and method match the given ones. Weights are visible to texture fetches
+    // issued after this call
+    void eval(std::span<const eig::Vector2f> verts,
+              eig::Array2u                   size,
+              const eig::Matrix4f           &projection,
+              DrawMethod                     method);
+
+    // Drop the cached weights, s.t. the next is_stale(...) holds
+    void invalidate() { m_is_valid = false; }
+
+    // Bind the texture for texel fetches to a texture unit
+    void bind(uint unit) const;
+
+    uint         object() const { return m_texture; }
+    eig::Array2u size()   const { return m_size;    }
+    uint         layers() const { return m_layers;  }
+    uint         evals()  const { return m_evals;   }
+
+    void swap(MvcWeightTexture &o);
+  };
+} // namespace prg
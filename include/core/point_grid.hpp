@@ -0,0 +1,56 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <core/math.hpp>
+#include <core/utility.hpp>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace prg {
+  // Uniform grid over a static set of 2d points, for nearest-point queries within a radius;
+  // points are bucketed into square cells in a row-compressed layout, s.t. a query only visits
+  // cells overlapping its radius. Intended for screen-space picking, rebuilt on changes
+  class PointGrid {
+    eig::Array2f               m_origin    = 0.f;
+    eig::Array2i               m_dims      = 0;
+    float                      m_cell_size = 1.f;
+    std::vector<uint>          m_offsets;   // Cell c holds points [offsets[c], offsets[c + 1])
+    std::vector<uint>          m_indices;   // Original point indices, in cell order
+    std::vector<eig::Vector2f> m_points;    // Point data, in cell order
+
+  public:
+    PointGrid() = default;
+
+    // Build a grid over points with a given cell size, ideally the typical query radius;
+    // the cell size grows if needed to keep the nr. of cells proportional to the nr. of points.
+    // Non-finite points, and points beyond a quarter of the float range, are skipped
+    PointGrid(std::span<const eig::Vector2f> points, float cell_size);
+
+    bool empty() const { return m_points.empty(); }
+    uint size()  const { return static_cast<uint>(m_points.size()); }
+
+    // Return the index of the point nearest to p within radius, if one exists; ties
+    // resolve towards the lower index
+    std::optional<uint> find_nearest(eig::Vector2f p, float radius) const;
+  };
+} // namespace prg
@@ -0,0 +1,97 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <core/math.hpp>
+#include <core/mvc.hpp>
+#include <core/utility.hpp>
+#include <span>
+#include <vector>
+
+namespace prg {
+  // Polygon id returned by queries for points outside all polygons
+  constexpr uint polygon_none = static_cast<uint>(-1);
+
+  // Collection of colored polygons, possibly with holes, for point-to-polygon lookup followed
+  // by mean value interpolation of the containing polygon's colors. Polygons are added one by
+  // one, after which build() bulk-loads an R-tree over their bounding boxes through sort-tile-
+  // recursive packing; nodes of each level are stored contiguously, with the root last
+  class PolygonCollection {
+    // Polygon data; vertices and colors of all polygons are concatenated
+    struct Entry {
+      uint              first, size;             // Vertex range [first, first + size)
+      uint              holes_first, holes_size; // Range in m_hole_offsets; offsets are relative to first
+      eig::AlignedBox2f bbox;
+    };
+
+    // R-tree node; children are nodes [first, first + size) of the level below, or for
+    // leaves, entries m_order[first, first + size)
+    struct Node {
+      eig::AlignedBox2f bbox;
+      uint              first, size;
+      bool              is_leaf;
+    };
+
+    std::vector<eig::Vector2f>  m_verts;
+    std::vector<eig::AlArray3f> m_colrs;
+    std::vector<uint>           m_hole_offsets;
+    std::vector<Entry>          m_entries;
+    std::vector<uint>           m_order; // Entry indices in leaf order
+    std::vector<Node>           m_nodes;
+    uint                        m_max_size = 0;    // Largest polygon's vertex count
+    bool                        m_is_built = true;
+
+  public:
+    PolygonCollection() = default;
+
+    // Add a polygon, with holes given as in polygon_ring(...) in mesh.hpp, and return its id;
+    // ids are assigned in order of addition. Invalidates the R-tree until build() is called
+    uint add(std::span<const eig::Vector2f>  verts,
+             std::span<const eig::AlArray3f> colrs,
+             std::span<const uint>           hole_offsets = { });
+
+    // Bulk-load the R-tree over all added polygons; O(m log m) for m polygons
+    void build();
+
+    // Return the id of the polygon containing p, or polygon_none; where polygons overlap, the
+    // lowest id is returned. Containment follows the even-odd rule over a polygon's rings
+    uint find(eig::Vector2f p) const;
+
+    // Batched point query; for each point, write the containing polygon's id as in find(...),
+    // and its colors interpolated at the point using mean value coordinates. Points outside
+    // all polygons receive zero colors. Points are distributed over available threads in chunks
+    // - ids and colrs are expected to be of size points.size()
+    void query(std::span<const eig::Vector2f> points,
+               std::span<uint>                ids,
+               std::span<eig::AlArray3f>      colrs,
+               MvcPrecision                   precision = MvcPrecision::eExact) const;
+
+    bool empty()    const { return m_entries.empty();                   }
+    uint size()     const { return static_cast<uint>(m_entries.size()); }
+    bool is_built() const { return m_is_built;                          }
+
+    // Per-polygon accessors; hole offsets are relative to the polygon's first vertex
+    std::span<const eig::Vector2f>  verts(uint id)        const;
+    std::span<const eig::AlArray3f> colrs(uint id)        const;
+    std::span<const uint>           hole_offsets(uint id) const;
+    const eig::AlignedBox2f        &bbox(uint id)         const { return m_entries[id].bbox; }
+  };
+} // namespace prg
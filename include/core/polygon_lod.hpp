@@ -0,0 +1,65 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <core/math.hpp>
+#include <core/utility.hpp>
+#include <optional>
+#include <span>
+#include <vector>
+
+namespace prg {
+  // Settings for building a polygon's LOD chain
+  struct PolygonLodInfo {
+    float ratio     = 4.f; // Reduction in vertex count between consecutive levels
+    uint  min_verts = 64;  // Vertex count of the coarsest level, if the polygon is larger
+  };
+
+  // Level of a polygon LOD chain, as a subset of the original polygon's vertices
+  struct PolygonLodLevel {
+    std::vector<uint> indices; // Indices of retained vertices, ascending
+    float             error;   // Largest effective area of a removed vertex
+  };
+
+  // Build a LOD chain through Visvalingam-Whyatt simplification; vertices are removed in
+  // order of the area of the triangle they form with their neighbours, which is kept in a
+  // priority queue and updated as neighbours are removed. Effective areas are made monotone,
+  // s.t. a level's error bounds the area of any vertex it removed. Levels are ordered from
+  // fine to coarse, and exclude the original polygon; O(n log n)
+  std::vector<PolygonLodLevel> build_polygon_lod(std::span<const eig::Vector2f> verts,
+                                                 PolygonLodInfo                 info = { });
+
+  // Return the finest level with at most max_verts vertices, or the coarsest level if none
+  // qualifies; levels must be nonempty
+  const PolygonLodLevel &select_lod_level(std::span<const PolygonLodLevel> levels, uint max_verts);
+
+  // Gather a level's vertices from the original polygon, and resample colors s.t. each retained
+  // vertex takes a tent-filtered average, by arc length, of the original colors up to its
+  // retained neighbours. A pinned vertex is retained even if the level removed it, e.g. a
+  // vertex that is being dragged. Vertex positions are taken from verts, s.t. a level can be
+  // reused while vertices move, as long as the polygon's structure does not change; O(n)
+  void extract_lod_level(const PolygonLodLevel          &level,
+                         std::span<const eig::Vector2f>  verts,
+                         std::span<const eig::AlArray3f> colrs,
+                         std::vector<eig::Vector2f>     &verts_out,
+                         std::vector<eig::AlArray3f>    &colrs_out,
+                         std::optional<uint>             pinned = { });
+} // namespace prg
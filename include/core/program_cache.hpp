@@ -0,0 +1,96 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <core/utility.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace prg {
+  // Shader stage of a program; type is a GL shader type, and path points to preprocessed glsl
+  struct ProgramStage {
+    uint                  type;
+    std::filesystem::path path;
+  };
+
+  struct ProgramCacheInfo {
+    std::filesystem::path path;            // Cache file; missing or stale files are ignored
+    bool                  parallel = true; // Let the driver compile on its own threads, if supported
+  };
+
+  // Summary of the last ProgramCache::build(...)
+  struct ProgramCacheStats {
+    uint   hits        = 0;     // Programs loaded from cached binaries
+    uint   misses      = 0;     // Programs compiled and linked from glsl
+    bool   is_parallel = false; // Driver compiled through KHR_parallel_shader_compile
+    double time_ms     = 0.0;
+  };
+
+  // Cache of linked program binaries, keyed by a hash over the driver string and each stage's
+  // type and source, s.t. edited shaders or a driver update miss the cache instead of loading
+  // stale binaries. Missing programs are compiled together; all compiles and links are
+  // issued before any status is queried, s.t. drivers supporting KHR_parallel_shader_compile
+  // process them concurrently. The cache owns the programs it builds
+  class ProgramCache {
+    struct Entry {
+      uint                   format;
+      std::vector<std::byte> binary;
+    };
+
+    std::filesystem::path               m_path;
+    bool                                m_parallel = false;
+    std::string                         m_driver;
+    std::unordered_map<uint64_t, Entry> m_entries;
+    std::vector<uint>                   m_programs;
+    ProgramCacheStats                   m_stats;
+    bool                                m_is_dirty = false;
+
+  public:
+    ProgramCache() = default;
+    explicit ProgramCache(ProgramCacheInfo info);
+    ~ProgramCache();
+
+    ProgramCache(ProgramCache &&o) noexcept { swap(o); }
+    ProgramCache &operator=(ProgramCache &&o) noexcept { swap(o); return *this; }
+    ProgramCache(const ProgramCache &) = delete;
+    ProgramCache &operator=(const ProgramCache &) = delete;
+
+    // Build a program per list of stages, loading cached binaries where the driver accepts
+    // them and compiling the rest; returns GL program objects in order of input. Throws if
+    // a shader fails to compile or link
+    std::vector<uint> build(std::span<const std::vector<ProgramStage>> programs);
+
+    // Write the cache file if programs were added since it was read; returns false if the
+    // file could not be written, in which case the next run compiles again
+    bool save();
+
+    const std::string       &driver() const { return m_driver; }
+    const ProgramCacheStats &stats()  const { return m_stats;  }
+    uint                     size()   const { return static_cast<uint>(m_entries.size()); }
+
+    void swap(ProgramCache &o);
+  };
+} // namespace prg
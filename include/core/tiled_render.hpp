@@ -0,0 +1,75 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <core/math.hpp>
+#include <core/utility.hpp>
+#include <filesystem>
+#include <span>
+#include <vector>
+
+namespace prg {
+  // Settings for an out-of-core render of a polygon's mean value coordinate color field;
+  // the image is walked in tiles, each of which is compressed and streamed to disk as soon
+  // as it is finished, s.t. memory use is bounded by mem_budget regardless of image size
+  struct TiledRenderInfo {
+    std::filesystem::path           path;                          // Output file path
+    eig::Array2u                    size        = { 4096, 4096 };  // Image resolution in pixels
+    eig::Array2u                    tile_size   = { 256, 256 };    // Tile resolution in pixels
+    eig::AlignedBox2f               bounds      = { eig::Vector2f(0, 0), eig::Vector2f(1, 1) }; // Rendered region of polygon space
+    size_t                          mem_budget  = 256ull << 20;    // Upper bound on in-flight tile memory, in bytes
+    int                             compression = 6;               // Zlib compression level in [0, 9]
+    bool                            resume      = true;            // Continue a matching, interrupted render at path
+    std::span<const eig::Vector2f>  verts;                         // Polygon vertices
+    std::span<const eig::AlArray3f> colrs;                         // Polygon vertex colors
+  };
+
+  // Summary of a tiled render; tiles found complete in a resumed file are skipped
+  struct TiledRenderResult {
+    uint tiles_total;
+    uint tiles_rendered;
+    uint tiles_skipped;
+  };
+
+  // Header of the tiled render file format; pixels are stored as rgba8, with zero alpha
+  // outside the polygon. The header is followed by a table of tile entries in row-major
+  // tile order, and then by zlib-compressed tile data in order of completion
+  struct TiledImageHeader {
+    std::array<char, 8> magic = { 'P', 'R', 'G', 'T', 'I', 'L', 'E', '1' };
+    uint                size_x, size_y;
+    uint                tile_x, tile_y;
+    uint64_t            hash;   // Hash over render settings, used to validate resumes
+  };
+
+  // Entry in the tile table of the tiled render file format; zero size denotes a missing tile
+  struct TiledImageEntry {
+    uint64_t offset;
+    uint     size;
+    uint     crc;
+  };
+
+  // Render a polygon's mean value coordinate color field to a tiled, compressed file
+  TiledRenderResult render_mvc_tiled(const TiledRenderInfo &info);
+
+  // Read back and decompress a single rgba8 tile from a tiled render file; returns an
+  // empty vector if the tile is missing. Edge tiles are cropped to the image size
+  std::vector<eig::Array4<uchar>> read_mvc_tile(const std::filesystem::path &path, eig::Array2u tile);
+} // namespace prg
@@ -0,0 +1,203 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <core/utility.hpp>
+#include <algorithm>
+#include <memory>
+#include <span>
+#include <unordered_set>
+#include <vector>
+
+namespace prg {
+  // Target nr. of elements per chunk of a ChunkedVector; chunks split once they double
+  constexpr uint chunked_vector_size = 1024;
+
+  // Sequence stored as a rope of fixed-capacity chunks, which copies of the sequence share;
+  // a copy costs O(n / chunk size), and writes copy a chunk first if another copy holds it,
+  // s.t. copies that differ in k chunks hold O(k) chunks of their own. Element access by
+  // position costs O(log(n / chunk size))
+  template <typename T>
+  class ChunkedVector {
+    using Chunk = std::vector<T>;
+
+    std::vector<std::shared_ptr<Chunk>> m_chunks;
+    std::vector<uint>                   m_offsets = { 0 }; // Chunk c holds [offsets[c], offsets[c + 1])
+
+    // Chunk holding position i, for i < size(); i == size() resolves to the last chunk
+    uint chunk_of(uint i) const {
+      auto it = std::ranges::upper_bound(m_offsets, i);
+      return std::min(static_cast<uint>(std::distance(m_offsets.begin(), it)) - 1,
+                      static_cast<uint>(m_chunks.size()) - 1);
+    }
+
+    // Chunk c, copied first if it is shared with another sequence
+    Chunk &chunk_mut(uint c) {
+      if (m_chunks[c].use_count() > 1)
+        m_chunks[c] = std::make_shared<Chunk>(*m_chunks[c]);
+      return *m_chunks[c];
+    }
+
+  public:
+    ChunkedVector() = default;
+
+    explicit ChunkedVector(std::span<const T> data) {
+      for (size_t first = 0; first < data.size(); first += chunked_vector_size) {
+        auto chunk = data.subspan(first, std::min<size_t>(chunked_vector_size, data.size() - first));
+        m_chunks.push_back(std::make_shared<Chunk>(range_iter(chunk)));
+        m_offsets.push_back(m_offsets.back() + static_cast<uint>(chunk.size()));
+      }
+    }
+
+    uint size()  const { return m_offsets.back(); }
+    bool empty() const { return size() == 0;      }
+
+    const T &operator[](uint i) const {
+      uint c = chunk_of(i);
+      return (*m_chunks[c])[i - m_offsets[c]];
+    }
+
+    void set(uint i, const T &value) {
+      uint c = chunk_of(i);
+      chunk_mut(c)[i - m_offsets[c]] = value;
+    }
+
+    // Insert a value before position i; i == size() appends. A chunk that grows to twice the
+    // target size is split in two
+    void insert(uint i, const T &value) {
+      if (m_chunks.empty()) {
+        m_chunks.push_back(std::make_shared<Chunk>(1, value));
+        m_offsets.push_back(1);
+        return;
+      }
+
+      uint c = chunk_of(i);
+      auto &chunk = chunk_mut(c);
+      chunk.insert(chunk.begin() + (i - m_offsets[c]), value);
+      for (uint d = c + 1; d < m_offsets.size(); ++d)
+        m_offsets[d]++;
+
+      guard(chunk.size() >= 2 * chunked_vector_size);
+      auto tail = std::make_shared<Chunk>(chunk.begin() + chunked_vector_size, chunk.end());
+      chunk.resize(chunked_vector_size);
+      m_chunks.insert(m_chunks.begin() + c + 1, std::move(tail));
+      m_offsets.insert(m_offsets.begin() + c + 1, m_offsets[c] + chunked_vector_size);
+    }
+
+    // Erase the value at position i; chunks that become empty are removed
+    void erase(uint i) {
+      uint c = chunk_of(i);
+      auto &chunk = chunk_mut(c);
+      chunk.erase(chunk.begin() + (i - m_offsets[c]));
+      for (uint d = c + 1; d < m_offsets.size(); ++d)
+        m_offsets[d]--;
+
+      guard(chunk.empty());
+      m_chunks.erase(m_chunks.begin() + c);
+      m_offsets.erase(m_offsets.begin() + c + 1);
+    }
+
+    // Write all values in order to a contiguous buffer
+    void flatten(std::vector<T> &data) const {
+      data.resize(size());
+      for (uint c = 0; c < m_chunks.size(); ++c)
+        std::ranges::copy(*m_chunks[c], data.begin() + m_offsets[c]);
+    }
+
+    // Chunk layout; sequences whose offsets match hold equal values in chunks they share
+    std::span<const std::shared_ptr<Chunk>> chunks()  const { return m_chunks;  }
+    std::span<const uint>                   offsets() const { return m_offsets; }
+  };
+
+  // Memory held by an undo history; bytes_flat gives the memory full copies per version
+  // would require instead
+  struct UndoMemory {
+    uint   versions;
+    size_t chunks;
+    size_t bytes;
+    size_t bytes_flat;
+  };
+
+  // Linear undo history over versions of a ChunkedVector, which share unchanged chunks; a
+  // version costs its chunk table, plus the chunks written since the previous version.
+  // Moving between versions is O(1); redo versions are dropped once a new step begins
+  template <typename T>
+  class UndoHistory {
+    std::vector<ChunkedVector<T>> m_versions;
+    uint                          m_current   = 0;
+    uint                          m_max_steps = 0;
+
+  public:
+    UndoHistory() = default;
+
+    // Start from an initial version; the oldest versions are dropped beyond max_steps steps
+    explicit UndoHistory(std::span<const T> data, uint max_steps = 256)
+    : m_versions({ ChunkedVector<T>(data) }),
+      m_max_steps(max_steps) { }
+
+    // Current version; writes to it amend the current step
+    const ChunkedVector<T> &current() const { return m_versions[m_current]; }
+    ChunkedVector<T>       &current()       { return m_versions[m_current]; }
+
+    // Begin a new step, as a copy of the current version that shares its chunks; returns the
+    // copy, which becomes the current version
+    ChunkedVector<T> &begin_step() {
+      m_versions.resize(m_current + 1);
+      m_versions.push_back(m_versions.back());
+      if (m_versions.size() > m_max_steps + 1)
+        m_versions.erase(m_versions.begin());
+      m_current = static_cast<uint>(m_versions.size()) - 1;
+      return m_versions.back();
+    }
+
+    bool can_undo() const { return m_current > 0;                      }
+    bool can_redo() const { return m_current + 1 < m_versions.size(); }
+
+    // Move to the previous or next version, and return it
+    const ChunkedVector<T> &undo() {
+      dbg::check_expr(can_undo(), "UndoHistory::undo() has no step to undo");
+      return m_versions[--m_current];
+    }
+    const ChunkedVector<T> &redo() {
+      dbg::check_expr(can_redo(), "UndoHistory::redo() has no step to redo");
+      return m_versions[++m_current];
+    }
+
+    uint steps()        const { return static_cast<uint>(m_versions.size()) - 1; }
+    uint current_step() const { return m_current;                               }
+
+    // Memory use over all versions; shared chunks are counted once. O(versions * chunks)
+    UndoMemory memory() const {
+      UndoMemory memory = { .versions = static_cast<uint>(m_versions.size()), .chunks = 0, .bytes = 0, .bytes_flat = 0 };
+      std::unordered_set<const void *> counted;
+      for (const auto &version : m_versions) {
+        memory.bytes      += version.chunks().size_bytes() + version.offsets().size_bytes();
+        memory.bytes_flat += version.size() * sizeof(T);
+        for (const auto &chunk : version.chunks()) {
+          guard_continue(counted.insert(chunk.get()).second);
+          memory.chunks++;
+          memory.bytes += chunk->capacity() * sizeof(T);
+        }
+      }
+      return memory;
+    }
+  };
+} // namespace prg
@@ -25,6 +25,8 @@
 #include <fmt/compile.h>
 #include <fmt/ranges.h>
 #include <concepts>
+#include <cstdint>
+#include <initializer_list>
 #include <iterator>
 #include <span>
 #include <source_location>
@@ -85,6 +87,14 @@ namespace prg {
     return (n + static_cast<T>(div) - T(1)) / static_cast<T>(div);
   }
 
+  // FNV-1a hash over a byte range, chained through seed
+  inline
+  uint64_t hash_bytes(std::span<const std::byte> data, uint64_t seed = 14695981039346656037ull) {
+    for (auto b : data)
+      seed = (seed ^ static_cast<uint64_t>(b)) * 1099511628211ull;
+    return seed;
+  }
+
   // Helpers for debug utility
   namespace dtl {
     // Message buffer which accepts keyed strings
@@ -115,6 +125,21 @@ namespace prg {
         return _what.c_str();
       }
     };
+
+    // Throw an Exception holding source and message, followed by further keyed strings in
+    // the order provided; keys with empty strings are left out
+    [[noreturn]] inline
+    void throw_keyed_error(std::string_view src, 
+                           std::string_view msg,
+                           std::initializer_list<std::pair<std::string_view, std::string_view>> keys = { }) {
+      Exception e;
+      e.put("src",     src);
+      e.put("message", msg);
+      for (const auto &[key, value] : keys)
+        if (!value.empty())
+          e.put(key, value);
+      throw e;
+    }
   } // namespace dtl
 
   // Debug utility
@@ -136,7 +161,10 @@ namespace prg {
       throw e;
     }
 #else
-  #define check_expr(expr, msg, sl)
+    inline
+    void check_expr(bool, 
+                    const std::string_view & = "",
+                    const std::source_location = std::source_location::current()) { }
 #endif
   } // namespace dbg
 } // namespace prg
\ No newline at end of file
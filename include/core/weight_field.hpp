@@ -0,0 +1,151 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <core/math.hpp>
+#include <core/utility.hpp>
+#include <filesystem>
+#include <memory>
+#include <mutex>
+#include <span>
+#include <unordered_map>
+#include <vector>
+
+namespace prg {
+  // Settings for exporting a polygon's mean value coordinate weights, evaluated over a regular
+  // grid of samples, to a compressed and chunked file. Per sample, only the top-k weights by
+  // magnitude are retained, renormalized, and quantized to 16 bits; samples outside the
+  // polygon retain no weights
+  struct WeightFieldInfo {
+    std::filesystem::path          path;                          // Output file path
+    eig::Array2u                   size        = { 1024, 1024 };  // Sample grid resolution
+    eig::Array2u                   chunk_size  = { 64, 64 };      // Chunk resolution in samples
+    eig::AlignedBox2f              bounds      = { eig::Vector2f(0, 0), eig::Vector2f(1, 1) }; // Sampled region of polygon space
+    uint                           k           = 8;               // Max. nr. of retained weights per sample
+    int                            compression = 6;               // Zlib compression level in [0, 9]
+    std::span<const eig::Vector2f> verts;                         // Polygon vertices
+  };
+
+  // Header of the weight field file format. The header is followed by a table of chunk
+  // entries in row-major chunk order, and then by zlib-compressed chunk data. Uncompressed,
+  // a chunk stores a nr. of weights per sample (uint8), followed by all vertex indices (uint32)
+  // and all quantized weights (uint16) in sample order
+  struct WeightFieldHeader {
+    std::array<char, 8> magic = { 'P', 'R', 'G', 'W', 'F', 'L', 'D', '1' };
+    uint                n_verts, k;
+    uint                size_x,  size_y;
+    uint                chunk_x, chunk_y;
+    std::array<float, 4> bounds; // Min. and max. of the sampled region
+  };
+
+  // Entry in the chunk table of the weight field file format; weights are dequantized
+  // as w = w_min + w_scale * q
+  struct WeightFieldEntry {
+    uint64_t offset;
+    uint     size, size_raw;
+    float    w_min, w_scale;
+  };
+
+  // Export a polygon's mean value coordinate weights to a weight field file
+  void export_weight_field(const WeightFieldInfo &info);
+
+  // Decompressed chunk of a weight field; samples are row-major, and the weights of
+  // sample i occupy [offsets[i], offsets[i + 1]) of indices/weights
+  struct WeightChunk {
+    eig::Array2u       origin, size;
+    std::vector<uint>  offsets;
+    std::vector<uint>  indices;
+    std::vector<float> weights;
+
+    // Index/weight ranges of a sample, relative to the chunk's origin
+    std::span<const uint> sample_indices(eig::Array2u xy) const {
+      uint i = xy.y() * size.x() + xy.x();
+      return std::span(indices).subspan(offsets[i], offsets[i + 1] - offsets[i]);
+    }
+    std::span<const float> sample_weights(eig::Array2u xy) const {
+      uint i = xy.y() * size.x() + xy.x();
+      return std::span(weights).subspan(offsets[i], offsets[i + 1] - offsets[i]);
+    }
+  };
+
+  namespace dtl {
+    // Read-only memory mapping of a file; pages are loaded by the os on access
+    class MappedFile {
+      std::span<const std::byte> m_data;
+      void                      *m_handle = nullptr;
+
+    public:
+      MappedFile() = default;
+      MappedFile(const std::filesystem::path &path);
+      ~MappedFile();
+
+      MappedFile(const MappedFile &) = delete;
+      MappedFile & operator=(const MappedFile &) = delete;
+      MappedFile(MappedFile &&o) { swap(o); }
+      MappedFile & operator=(MappedFile &&o) { swap(o); return *this; }
+      void swap(MappedFile &o) { std::swap(m_data, o.m_data); std::swap(m_handle, o.m_handle); }
+
+      std::span<const std::byte> data() const { return m_data; }
+    };
+  } // namespace dtl
+
+  // Memory-mapped weight field file; only the header and chunk table are read on load,
+  // and chunks are decompressed on first access and kept in a bounded cache, s.t. load
+  // cost scales with the accessed region instead of the file size
+  class WeightField {
+    using ChunkPtr = std::shared_ptr<const WeightChunk>;
+    
+    std::filesystem::path                m_path;
+    dtl::MappedFile                      m_file;
+    WeightFieldHeader                    m_header;
+    std::span<const WeightFieldEntry>    m_table;
+    eig::Array2u                         m_n_chunks;
+    size_t                               m_cache_size = 64;
+    mutable std::mutex                   m_cache_mutex;
+    mutable std::unordered_map<uint, ChunkPtr> m_cache;
+
+  public:
+    WeightField() = default;
+    WeightField(const std::filesystem::path &path, size_t cache_size = 64);
+
+    uint              n_verts() const { return m_header.n_verts; }
+    eig::Array2u      size()    const { return { m_header.size_x, m_header.size_y }; }
+    eig::Array2u      chunk_size() const { return { m_header.chunk_x, m_header.chunk_y }; }
+    eig::AlignedBox2f bounds()  const;
+
+    // Access the decompressed chunk covering a given sample
+    ChunkPtr chunk_at(eig::Array2u xy) const;
+
+    // Interpolate vertex colors over a region of samples, in row-major order;
+    // out is expected to be of size region_size.prod()
+    void eval_colr(eig::Array2u                    region_origin,
+                   eig::Array2u                    region_size,
+                   std::span<const eig::AlArray3f> colrs,
+                   std::span<eig::Array3f>         out) const;
+    
+    // Interpolate (deformed) vertex positions over a region of samples, in row-major order;
+    // out is expected to be of size region_size.prod()
+    void eval_verts(eig::Array2u                   region_origin,
+                    eig::Array2u                   region_size,
+                    std::span<const eig::Vector2f> verts,
+                    std::span<eig::Vector2f>       out) const;
+  };
+} // namespace prg
@@ -0,0 +1,19 @@
+#ifndef MVC_GLSL_GUARD
+#define MVC_GLSL_GUARD
+
+// Boundary tolerance; matches mvc_epsilon in kernels.hpp
+const float MVC_EPSILON = 1e-6f;
+
+float cross_2d(vec2 a, vec2 b) {
+  return a.x * b.y - a.y * b.x;
+}
+
+// Tangent of half the signed angle of an edge as seen from p, given the cross and dot
+// products and the lengths' product of the vectors from p to the edge's vertices; as
+// sin / (1 + cos) for acute angles and (1 - cos) / sin for obtuse ones, which avoids
+// cancellation near either end, and needs no transcendentals
+float half_tan(float cross, float dot, float r) {
+  return dot >= 0.f ? cross / (r + dot) : (r - dot) / cross;
+}
+
+#endif // MVC_GLSL_GUARD
@@ -0,0 +1,28 @@
+#include <preamble.glsl>
+
+// Buffer layout declarations
+layout(std140) uniform;
+layout(std430) buffer;
+
+// Stage declarations; in_rings is per-draw data, selected by the command's base instance
+layout(location = 0) in  vec2  in_vert;
+layout(location = 1) in  vec3  in_colr;
+layout(location = 2) in  uvec2 in_rings;
+layout(location = 0) out vec3  out_colr;
+layout(location = 1) out vec2  out_value;
+layout(location = 2) out flat uvec2 out_rings;
+
+// Uniform buffer declarations
+layout(binding = 0) uniform b_buffer_settings {
+  mat4 projection;
+  bool draw_lines;
+  uint draw_method;
+  uint draw_precision;
+} settings;
+
+void main() {
+  out_colr    = in_colr;
+  out_value   = in_vert;
+  out_rings   = in_rings;
+  gl_Position = settings.projection * vec4(in_vert * 2.f - 1.f , 0, 1);
+}
@@ -0,0 +1,78 @@
+#include <preamble.glsl>
+#include <mvc.glsl>
+
+// Buffer layout declarations
+layout(std140) uniform;
+layout(std430) buffer;
+
+// Storage buffer declarations; vertices and colors of all polygons in a batch, and their
+// rings, whose weights are scaled by sign s.t. holes wind opposite to the outer ring
+struct Ring {
+  uint  first;
+  uint  size;
+  float sign;
+  uint  padding;
+};
+layout(binding = 0) restrict readonly buffer b_buffer_verts {
+  vec2 data[];
+} verts;
+layout(binding = 1) restrict readonly buffer b_buffer_colrs {
+  vec3 data[];
+} colrs;
+layout(binding = 2) restrict readonly buffer b_buffer_rings {
+  Ring data[];
+} rings;
+
+// Uniform buffer declarations
+layout(binding = 0) uniform b_buffer_settings {
+  mat4 projection;
+  bool draw_lines;
+  uint draw_method;
+  uint draw_precision;
+} settings;
+
+// Stage declarations
+layout(location = 1) in      vec2  in_value;
+layout(location = 2) in flat uvec2 in_rings;
+layout(location = 0) out     vec4  out_value;
+
+// Mean value interpolation of the polygon's colors over all of its rings; colors are
+// accumulated alongside weights, s.t. polygons of any size need no weight storage. Points
+// on a ring's vertex or edge take the linear boundary interpolant
+vec3 mvc_colr(vec2 p) {
+  vec3  colr_sum    = vec3(0.f);
+  float weights_sum = 0.f;
+  for (uint r = in_rings.x; r < in_rings.x + in_rings.y; ++r) {
+    Ring ring = rings.data[r];
+    uint n    = ring.size;
+
+    vec2  s_curr = verts.data[ring.first] - p;
+    float r_curr = length(s_curr);
+    vec2  s_prev = verts.data[ring.first + n - 1] - p;
+    float t_prev = half_tan(cross_2d(s_prev, s_curr), dot(s_prev, s_curr), length(s_prev) * r_curr);
+    for (uint i = 0; i < n; ++i) {
+      uint  j      = ring.first + (i + 1) % n;
+      vec2  s_next = verts.data[j] - p;
+      float r_next = length(s_next);
+
+      // Boundary case; p lies on a vertex or edge
+      float c = cross_2d(s_curr, s_next), d = dot(s_curr, s_next);
+      if (r_curr <= MVC_EPSILON || (abs(c) <= MVC_EPSILON * r_curr * r_next && d < 0.f))
+        return (r_next * colrs.data[ring.first + i] + r_curr * colrs.data[j]) / (r_curr + r_next);
+
+      float t_curr = half_tan(c, d, r_curr * r_next);
+      float w      = ring.sign * (t_prev + t_curr) / r_curr;
+      colr_sum    += w * colrs.data[ring.first + i];
+      weights_sum += w;
+
+      s_curr = s_next;
+      r_curr = r_next;
+      t_prev = t_curr;
+    }
+  }
+  return colr_sum / weights_sum;
+}
+
+void main() {
+  out_value = vec4(mvc_colr(in_value), 1);
+}
@@ -1,4 +1,5 @@
 #include <preamble.glsl>
+#include <mvc.glsl>
 
 // Buffer layout declarations
 layout(std140) uniform;
@@ -17,21 +18,38 @@ layout(binding = 0) uniform b_buffer_settings {
   mat4 projection;
   bool draw_lines;
   uint draw_method;
+  uint draw_precision;
 } settings;
 
 // Stage declarations
 layout(location = 0) in  vec2 in_value;
 layout(location = 0) out vec4 out_value;
 
-float cross_2d(vec2 a, vec2 b) {
-  // return cross(vec3(a, 0), vec3(b, 0)).z;
-  return a.x * b.y - a.y * b.x;
-}
-
 float get_angle(vec2 a, vec2 b) {
   return atan(cross_2d(a, b), dot(a, b));
 }
 
+// Approximation of acos; Abramowitz & Stegun 4.4.45, max. abs. error 6.7e-5 rad
+float acos_fast(float x) {
+  float ax = abs(x);
+  float a  = sqrt(1.f - ax) * (1.5707288f + ax * (-0.2121144f + ax * (0.0742610f - 0.0187293f * ax)));
+  return x < 0.f ? 3.14159265f - a : a;
+}
+
+// Approximation of tan for |x| < pi / 2; [5/4] Pade approximant after reduction to
+// |x| <= pi / 4, with max. rel. error 1e-6 for |x| <= 1.5
+float tan_fast(float x) {
+  bool  is_reduced = abs(x) > 0.78539816f;
+  float u  = is_reduced ? sign(x) * 1.57079633f - x : x;
+  float u2 = u * u;
+  float t  = u * (945.f + u2 * (-105.f + u2)) / (945.f + u2 * (-420.f + u2 * 15.f));
+  return is_reduced ? 1.f / t : t;
+}
+
+// Selects exact or fast-math transcendentals through the uniform precision setting
+float acos_p(float x) { return settings.draw_precision == 1 ? acos_fast(x) : acos(x); }
+float tan_p(float x)  { return settings.draw_precision == 1 ? tan_fast(x)  : tan(x);  }
+
 // Hardcoded maximum nr. of weights
 const uint N_MAX = 8u;
 
@@ -58,12 +76,12 @@ float[N_MAX] mvc(vec2 p) {
       dir_curr /= nrm_curr;
 
       // Get angles between (p -> vt_curr) and (p -> prev/next)
-      float angle_prev = acos(dot(dir_curr, normalize(vt_prev - p)));
-      float angle_next = acos(dot(dir_curr, normalize(vt_next - p)));
+      float angle_prev = acos_p(dot(dir_curr, normalize(vt_prev - p)));
+      float angle_next = acos_p(dot(dir_curr, normalize(vt_next - p)));
 
       // Compute w_i 
-      float t_prev = tan(angle_prev * .5f);
-      float t_next = tan(angle_next * .5f);
+      float t_prev = tan_p(angle_prev * .5f);
+      float t_next = tan_p(angle_next * .5f);
       weights[i] = (t_prev + t_next) / nrm_curr;
     }
 
@@ -103,8 +121,75 @@ float[N_MAX] mvc(vec2 p) {
   return weights;
 }
 
+// Wachspress coordinates; rational and trig-free, but only valid inside convex polygons.
+// Points on an edge take the linear boundary interpolant, and points outside get zero weights
+float[N_MAX] wachspress(vec2 p) {
+  // Output weights and cumulative sum used to normalize
+  float[N_MAX] weights;
+  float weights_sum = 0.0;
+
+  // Actual polytope size is buffer size
+  int n = min(verts.data.length(), int(N_MAX));
+
+  // Twice the signed area of triangle (p, prev, curr)
+  vec2 dir_prev = verts.data[n - 1] - p;
+  vec2 dir_curr = verts.data[0] - p;
+  float A_prev  = cross_2d(dir_prev, dir_curr);
+  float A_min   = A_prev, A_max = A_prev;
+
+  // Iterate polytope vertices; w_i = C_i / (A_{i-1} * A_i)
+  for (int i = 0; i < n; i++) {
+    int j         = (i + 1) % n;
+    vec2 dir_next = verts.data[j] - p;
+    vec2 e_next   = dir_next - dir_curr;
+    float A_next  = cross_2d(dir_curr, dir_next);
+
+    // Boundary case; p lies on a vertex or edge
+    if (abs(A_next) <= MVC_EPSILON * dot(e_next, e_next) && dot(dir_curr, dir_next) <= 0.f) {
+      float r_curr = length(dir_curr), r_next = length(dir_next);
+      for (uint k = 0; k < N_MAX; ++k)
+        weights[k] = 0.f;
+      weights[i] = r_next / (r_curr + r_next);
+      weights[j] = r_curr / (r_curr + r_next);
+      return weights;
+    }
+
+    float C = cross_2d(dir_curr - dir_prev, e_next);
+    weights[i]   = C / (A_prev * A_next);
+    weights_sum += weights[i];
+    A_min = min(A_min, A_next);
+    A_max = max(A_max, A_next);
+    
+    dir_prev = dir_curr;
+    dir_curr = dir_next;
+    A_prev   = A_next;
+  }
+
+  // Exterior case
+  if (A_min < 0.f && A_max > 0.f) {
+    for (uint i = 0; i < N_MAX; ++i)
+      weights[i] = 0.f;
+    return weights;
+  }
+
+  // Normalize w_i over sum of w_j
+  float rcp = 1.f / weights_sum;
+  for (uint i = 0; i < n; ++i)
+    weights[i] *= rcp;
+
+  // Set unused weights to 0
+  for (uint i = n; i < N_MAX; ++i)
+    weights[i] = 0.f;
+
+  return weights;
+}
+
 vec3 mvc_colr(in vec2 p) {
-  float[N_MAX] weights = mvc(p);
+  float[N_MAX] weights;
+  if (settings.draw_method == 2)
+    weights = wachspress(p);
+  else
+    weights = mvc(p);
   int n = min(verts.data.length(), int(N_MAX));
 
   vec3 colr = vec3(0.f);
@@ -13,6 +13,7 @@ layout(binding = 0) uniform b_buffer_settings {
   mat4 projection;
   bool draw_lines;
   uint draw_method;
+  uint draw_precision;
 } settings;
 
 void main() {
@@ -0,0 +1,42 @@
+#include <preamble.glsl>
+
+// Buffer layout declarations
+layout(std140) uniform;
+layout(std430) buffer;
+
+// Storage buffer declarations
+layout(binding = 1) restrict readonly buffer b_buffer_colrs {
+  vec3 data[];
+} colrs;
+
+// Uniform buffer declarations
+layout(binding = 0) uniform b_buffer_settings {
+  mat4 projection;
+  bool draw_lines;
+  uint draw_method;
+  uint draw_precision;
+} settings;
+
+// Sampler declarations; weights as written by eval_mvc_weights.comp
+layout(binding = 0) uniform sampler2DArray s_weights;
+
+// Stage declarations
+layout(location = 0) in  vec2 in_value;
+layout(location = 0) out vec4 out_value;
+
+void main() {
+  ivec2 xy = ivec2(gl_FragCoord.xy);
+  int   n  = min(colrs.data.length(), 4 * textureSize(s_weights, 0).z);
+
+  vec3 colr = vec3(0.f);
+  for (int l = 0; 4 * l < n; ++l) {
+    vec4 weights = texelFetch(s_weights, ivec3(xy, l), 0);
+    for (int c = 0; c < 4 && 4 * l + c < n; ++c) {
+      // Grid lines, bad hack
+      if (!settings.draw_lines || fract(weights[c] * 30) < 0.1)
+        colr += weights[c] * colrs.data[4 * l + c];
+    }
+  }
+
+  out_value = vec4(colr, 1);
+}
@@ -0,0 +1,212 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdlib>
+#include <exception>
+#include <core/batch_renderer.hpp>
+#include <core/draw_batch.hpp>
+#include <core/edit_session.hpp>
+#include <core/headless_context.hpp>
+#include <core/math.hpp>
+#include <core/mesh.hpp>
+#include <core/mvc.hpp>
+#include <core/polygon_collection.hpp>
+#include <core/utility.hpp>
+#include <glad/glad.h>
+#include <chrono>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <string_view>
+
+namespace prg {
+  // Application main code; packs a k x k grid of polygons, alternating with holed polygons,
+  // into a draw batch, and draws it through single multi-draw calls for the barycentric, mean
+  // value and line passes. Each pass is compared against drawing polygons one command at a
+  // time, and mean value colors are compared per pixel against the collection's CPU query.
+  // Then, frames are timed for the multi-draw call against one draw call per polygon.
+  // Fails if passes differ, or if any color error exceeds tolerance
+  int run_batch_render_check(std::span<const char *> args) {
+    std::filesystem::path shader_dir = args.size() > 1 ? args[1] : "shaders";
+    uint                  k          = args.size() > 2 ? static_cast<uint>(std::stoul(args[2])) : 32u;
+    uint                  n_frames   = args.size() > 3 ? static_cast<uint>(std::stoul(args[3])) : 50u;
+    constexpr uint        n_verts    = 32;
+    constexpr float       tolerance  = 1e-3f;
+
+    HeadlessContext context;
+    fmt::print("Renderer: {}\n", reinterpret_cast<const char *>(glGetString(GL_RENDERER)));
+
+    // Offscreen float target, s.t. colors are compared without quantization
+    const eig::Array2u target_size = { 512, 512 };
+    GLuint texture, framebuffer;
+    glCreateTextures(GL_TEXTURE_2D, 1, &texture);
+    glTextureStorage2D(texture, 1, GL_RGBA32F, target_size.x(), target_size.y());
+    glCreateFramebuffers(1, &framebuffer);
+    glNamedFramebufferTexture(framebuffer, GL_COLOR_ATTACHMENT0, texture, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, target_size.x(), target_size.y());
+
+    // Programs are owned by the cache, which has no file and only shares the build path
+    ProgramCache programs;
+    GLuint bary_program  = load_program(programs, shader_dir, {{ GL_VERTEX_SHADER,   "draw_batch.vert"     },
+                                                               { GL_FRAGMENT_SHADER, "draw_bary.frag"      }});
+    GLuint mvc_program   = load_program(programs, shader_dir, {{ GL_VERTEX_SHADER,   "draw_batch.vert"     },
+                                                               { GL_FRAGMENT_SHADER, "draw_batch_mvc.frag" }});
+    GLuint lines_program = load_program(programs, shader_dir, {{ GL_VERTEX_SHADER,   "draw_batch.vert"     },
+                                                               { GL_FRAGMENT_SHADER, "draw_polygon.frag"   }});
+
+    // Settings are uploaded once; the projection maps the unit square onto the target
+    CheckSettings settings = { .projection = eig::ortho(-1.f, 1.f, -1.f, 1.f, -1.f, 1.f).matrix() };
+    GLuint settings_buffer;
+    glCreateBuffers(1, &settings_buffer);
+    glNamedBufferStorage(settings_buffer, sizeof(CheckSettings), &settings, 0);
+    glBindBufferBase(GL_UNIFORM_BUFFER, 0, settings_buffer);
+
+    // k x k grid of polygons in random colors; polygons do not overlap, s.t. each covered
+    // pixel belongs to the polygon the CPU query finds
+    PolygonCollection collection;
+    {
+      std::mt19937 rng(k);
+      std::uniform_real_distribution<float> distr(0.f, 1.f);
+      for (uint i = 0; i < k * k; ++i) {
+        std::vector<uint> hole_offsets;
+        auto verts = i % 2 ? generate_random_polygon(n_verts, i)
+                           : generate_holed_polygon(n_verts, 2, hole_offsets, i);
+        eig::Vector2f offset = eig::Vector2f(i % k, i / k) / static_cast<float>(k);
+        for (auto &v : verts)
+          v = (v / static_cast<float>(k) + offset).eval();
+        std::vector<eig::AlArray3f> colrs(verts.size());
+        for (auto &c : colrs)
+          c = { distr(rng), distr(rng), distr(rng) };
+        collection.add(verts, colrs, hole_offsets);
+      }
+      collection.build();
+    }
+
+    auto time_start = std::chrono::steady_clock::now();
+    DrawBatch     batch    = pack_draw_batch(collection);
+    BatchRenderer renderer(batch);
+    double time_pack = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - time_start).count();
+    fmt::print("{} polygons, {} vertices, {} triangles, packed and uploaded in {:.2f} ms\n",
+      collection.size(), batch.verts.size(), batch.elems.size(), time_pack);
+
+    // Render a pass through the multi-draw call, or through one call per polygon, and read back
+    auto render = [&](GLuint program, GLenum polygon_mode, bool is_multi_draw) {
+      glClearColor(0, 0, 0, 0);
+      glClear(GL_COLOR_BUFFER_BIT);
+      glUseProgram(program);
+      glPolygonMode(GL_FRONT_AND_BACK, polygon_mode);
+      renderer.bind();
+      if (is_multi_draw) {
+        renderer.draw(GL_TRIANGLES);
+      } else {
+        for (uint i = 0; i < collection.size(); ++i)
+          renderer.draw(GL_TRIANGLES, i);
+      }
+      glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+
+      std::vector<eig::Array4f> out(target_size.prod());
+      glGetTextureImage(texture, 0, GL_RGBA, GL_FLOAT,
+        static_cast<GLsizei>(out.size() * sizeof(eig::Array4f)), out.data());
+      return out;
+    };
+
+    // Passes must match exactly between the multi-draw call and per-polygon draws
+    bool is_valid = true;
+    struct CheckPass { std::string_view name; GLuint program; GLenum polygon_mode; };
+    std::vector<eig::Array4f> mvc_colrs;
+    fmt::print("{:<12} {:>10} {:>10}\n", "pass", "pixels", "equal");
+    for (const auto &pass : { CheckPass { "barycentric", bary_program,  GL_FILL },
+                              CheckPass { "mean value",  mvc_program,   GL_FILL },
+                              CheckPass { "lines",       lines_program, GL_LINE } }) {
+      auto multi  = render(pass.program, pass.polygon_mode, true);
+      auto single = render(pass.program, pass.polygon_mode, false);
+      bool is_equal = std::ranges::equal(multi, single, [](const auto &a, const auto &b) { return (a == b).all(); });
+      uint n_pixels = std::ranges::count_if(multi, [](const auto &v) { return v.w() != 0.f; });
+      fmt::print("{:<12} {:>10} {:>10}\n", pass.name, n_pixels, is_equal);
+      is_valid = is_valid && is_equal && n_pixels > 0;
+      if (pass.program == mvc_program)
+        mvc_colrs = std::move(multi);
+    }
+
+    // Mean value colors must match the CPU query at covered pixel centers
+    {
+      std::vector<eig::Vector2f> pixels(target_size.prod());
+      for (uint y = 0; y < target_size.y(); ++y)
+        for (uint x = 0; x < target_size.x(); ++x)
+          pixels[y * target_size.x() + x] = (eig::Vector2f(x, y) + eig::Vector2f::Constant(.5f))
+                                            .cwiseQuotient(target_size.cast<float>().matrix());
+      std::vector<uint>           ids(pixels.size());
+      std::vector<eig::AlArray3f> colrs(pixels.size());
+      collection.query(pixels, ids, colrs);
+
+      float error = 0.f;
+      uint  n_pixels = 0;
+      for (uint i = 0; i < pixels.size(); ++i) {
+        guard_continue(ids[i] != polygon_none && mvc_colrs[i].w() == 1.f);
+        n_pixels++;
+        error = std::max(error, (mvc_colrs[i].head<3>() - colrs[i].head<3>()).abs().maxCoeff());
+      }
+      fmt::print("mean value: {} pixels, max color error {:.3e}\n", n_pixels, error);
+      is_valid = is_valid && n_pixels > 0 && error <= tolerance;
+    }
+
+    // Frames drawn through one multi-draw call, against one draw call per polygon
+    auto run = [&](std::string_view name, uint n_calls, auto draw) {
+      glUseProgram(bary_program);
+      renderer.bind();
+      glFinish();
+      auto time_start = std::chrono::steady_clock::now();
+      for (uint f = 0; f < n_frames; ++f) {
+        glClear(GL_COLOR_BUFFER_BIT);
+        draw();
+      }
+      glFinish();
+      double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - time_start).count();
+      fmt::print("{:<12} {:>8} calls {:>10.3f} ms/frame\n", name, n_calls, time / n_frames);
+    };
+    run("multi-draw", 1, [&]() {
+      renderer.draw(GL_TRIANGLES);
+    });
+    run("per-polygon", collection.size(), [&]() {
+      for (uint i = 0; i < collection.size(); ++i)
+        renderer.draw(GL_TRIANGLES, i);
+    });
+
+    glDeleteBuffers(1, &settings_buffer);
+    glDeleteFramebuffers(1, &framebuffer);
+    glDeleteTextures(1, &texture);
+    renderer = { };
+
+    if (!is_valid)
+      fmt::print(stderr, "multi-draw passes differ from per-polygon draws, or colors do not match the CPU query\n");
+    return is_valid ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+} // namespace prg
+
+// Application entry point
+int main(int argc, const char *argv[]) {
+  try {
+    return prg::run_batch_render_check({ argv, static_cast<size_t>(argc) });
+  } catch (const std::exception &e) {
+    fmt::print(stderr, "{}\n", e.what());
+    return EXIT_FAILURE;
+  }
+}
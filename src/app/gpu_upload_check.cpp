@@ -0,0 +1,268 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdlib>
+#include <exception>
+#include <core/gpu_ring.hpp>
+#include <core/headless_context.hpp>
+#include <core/math.hpp>
+#include <core/utility.hpp>
+#include <glad/glad.h>
+#include <array>
+#include <chrono>
+#include <numbers>
+#include <stdexcept>
+#include <string>
+
+namespace prg {
+  // Draw program following the interactive test's bindings; attributes carry vertices and
+  // colors, settings sit at uniform binding 0, and vertex and color storage at bindings 0
+  // and 1. The output mixes all four sources, s.t. a wrong range shows up in the readback
+  constexpr auto check_vert_glsl = R"GLSL(
+    #version 450 core
+    layout(location = 0) in  vec2 in_vert;
+    layout(location = 1) in  vec3 in_colr;
+    layout(location = 0) out vec3 out_colr;
+    layout(binding = 0, std140) uniform b_buffer_settings {
+      mat4  projection;
+      vec2  first_vert;
+    } settings;
+    void main() {
+      out_colr    = in_colr;
+      gl_Position = settings.projection * vec4(in_vert * 2.f - 1.f, 0, 1);
+    }
+  )GLSL";
+  constexpr auto check_frag_glsl = R"GLSL(
+    #version 450 core
+    layout(location = 0) in  vec3 in_colr;
+    layout(location = 0) out vec4 out_colr;
+    layout(binding = 0, std140) uniform b_buffer_settings {
+      mat4  projection;
+      vec2  first_vert;
+    } settings;
+    layout(binding = 0, std430) restrict readonly buffer b_buffer_verts { vec2 data[]; } verts;
+    layout(binding = 1, std430) restrict readonly buffer b_buffer_colrs { vec4 data[]; } colrs;
+    void main() {
+      float is_match = verts.data[0] == settings.first_vert ? 1.f : 0.f;
+      out_colr = vec4(in_colr.rg, colrs.data[0].b, is_match);
+    }
+  )GLSL";
+
+  // Settings block of the check program above, in place of the draw shaders' CheckSettings
+  struct UploadSettings {
+    alignas(16) eig::Matrix4f projection;
+    alignas(8)  eig::Vector2f first_vert;
+  };
+
+  uint compile_check_program() {
+    auto compile = [](GLenum type, const char *glsl) {
+      GLuint shader = glCreateShader(type);
+      glShaderSource(shader, 1, &glsl, nullptr);
+      glCompileShader(shader);
+      GLint is_compiled = 0;
+      glGetShaderiv(shader, GL_COMPILE_STATUS, &is_compiled);
+      if (!is_compiled) {
+        std::string log(1024, '\0');
+        glGetShaderInfoLog(shader, static_cast<GLsizei>(log.size()), nullptr, log.data());
+        throw std::runtime_error(fmt::format("compile_check_program() failed: {}", log.c_str()));
+      }
+      return shader;
+    };
+
+    GLuint program = glCreateProgram();
+    GLuint vert = compile(GL_VERTEX_SHADER, check_vert_glsl);
+    GLuint frag = compile(GL_FRAGMENT_SHADER, check_frag_glsl);
+    glAttachShader(program, vert);
+    glAttachShader(program, frag);
+    glLinkProgram(program);
+    glDeleteShader(vert);
+    glDeleteShader(frag);
+    return program;
+  }
+
+  // Frame data; a fan-triangulated regular n-gon in a uniform color that varies per frame
+  struct CheckFrame {
+    std::vector<eig::Array3u>   elems;
+    std::vector<eig::Vector2f>  verts;
+    std::vector<eig::AlArray3f> colrs;
+    UploadSettings              settings;
+    eig::Array3f                colr;
+
+    CheckFrame(uint n, uint f) {
+      colr = { static_cast<float>(f % 7) / 6.f, static_cast<float>(f % 5) / 4.f, static_cast<float>(f % 3) / 2.f };
+      for (uint i = 0; i < n; ++i) {
+        float a = 2.f * std::numbers::pi_v<float> * static_cast<float>(i) / static_cast<float>(n);
+        verts.push_back(eig::Vector2f(.5f + .4f * std::cos(a), .5f + .4f * std::sin(a)));
+        colrs.push_back(eig::AlArray3f(colr));
+      }
+      for (uint i = 1; i + 1 < n; ++i)
+        elems.push_back(eig::Array3u(0, i, i + 1));
+      settings = { .projection = eig::Matrix4f::Identity(), .first_vert = verts[0] };
+    }
+  };
+
+  // Draw a frame by creating buffers and a vertex array, as the interactive test used to
+  void draw_legacy(const CheckFrame &frame) {
+    auto create = [](std::span<const std::byte> data) {
+      GLuint buffer;
+      glCreateBuffers(1, &buffer);
+      glNamedBufferData(buffer, static_cast<GLsizeiptr>(data.size()), data.data(), GL_STATIC_DRAW);
+      return buffer;
+    };
+    std::array<GLuint, 4> buffers = {
+      create(cnt_span<const std::byte>(frame.elems)),
+      create(cnt_span<const std::byte>(frame.verts)),
+      create(cnt_span<const std::byte>(frame.colrs)),
+      create(obj_span<const std::byte>(frame.settings))
+    };
+
+    GLuint array;
+    glCreateVertexArrays(1, &array);
+    glEnableVertexArrayAttrib(array, 0);
+    glEnableVertexArrayAttrib(array, 1);
+    glVertexArrayAttribFormat(array, 0, 2, GL_FLOAT, GL_FALSE, 0);
+    glVertexArrayAttribFormat(array, 1, 3, GL_FLOAT, GL_FALSE, 0);
+    glVertexArrayAttribBinding(array, 0, 0);
+    glVertexArrayAttribBinding(array, 1, 1);
+    glVertexArrayVertexBuffer(array, 0, buffers[1], 0, sizeof(eig::Vector2f));
+    glVertexArrayVertexBuffer(array, 1, buffers[2], 0, sizeof(eig::AlArray3f));
+    glVertexArrayElementBuffer(array, buffers[0]);
+
+    glBindVertexArray(array);
+    glBindBufferBase(GL_UNIFORM_BUFFER,        0, buffers[3]);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, buffers[1]);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, buffers[2]);
+    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(frame.elems.size()) * 3, GL_UNSIGNED_INT, nullptr);
+
+    glDeleteVertexArrays(1, &array);
+    glDeleteBuffers(static_cast<GLsizei>(buffers.size()), buffers.data());
+  }
+
+  // Application main code; draws a sequence of polygons of varying size through either the
+  // upload ring or per-frame buffer creation, and reports GL objects created per frame and
+  // frame times. Every few frames, the frame is read back and validated. Fails if the ring
+  // creates objects in frames where it did not grow, or if a readback does not match
+  int run_gpu_upload_check(std::span<const char *> args) {
+    uint n_frames = args.size() > 1 ? static_cast<uint>(std::stoul(args[1])) : 600u;
+    uint n_verts  = args.size() > 2 ? static_cast<uint>(std::stoul(args[2])) : 20000u;
+
+    HeadlessContext context;
+    fmt::print("Renderer: {}\n", reinterpret_cast<const char *>(glGetString(GL_RENDERER)));
+    install_gl_object_counters();
+
+    // Offscreen target and program are created once, outside the measured frames
+    constexpr uint target_size = 64;
+    GLuint texture, framebuffer;
+    glCreateTextures(GL_TEXTURE_2D, 1, &texture);
+    glTextureStorage2D(texture, 1, GL_RGBA8, target_size, target_size);
+    glCreateFramebuffers(1, &framebuffer);
+    glNamedFramebufferTexture(framebuffer, GL_COLOR_ATTACHMENT0, texture, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, target_size, target_size);
+    GLuint program = compile_check_program();
+    glUseProgram(program);
+
+    // Polygon sizes cycle, with a rare large frame that forces the ring to grow once
+    std::vector<CheckFrame> frames;
+    for (uint f = 0; f < 16; ++f)
+      frames.emplace_back(f == 11 ? 4 * n_verts : std::max(3u, (n_verts >> (f % 8))), f);
+
+    bool is_valid = true;
+    auto run = [&](std::string_view name, auto draw_frame) {
+      uint objects = 0, objects_steady = 0, fences = 0, mismatches = 0;
+      auto time_start = std::chrono::steady_clock::now();
+      for (uint f = 0; f < n_frames; ++f) {
+        const auto &frame = frames[f % frames.size()];
+        auto counts_start = gl_object_counts();
+
+        glClearColor(0, 0, 0, 0);
+        glClear(GL_COLOR_BUFFER_BIT);
+        bool is_grown = draw_frame(frame);
+
+        auto counts = gl_object_counts() - counts_start;
+        objects += counts.objects();
+        fences  += counts.fences;
+        if (!is_grown)
+          objects_steady += counts.objects();
+
+        // Read back the polygon's center; red and green pass through attributes, blue
+        // through color storage, and alpha tests vertex storage against the settings block
+        guard_continue(f % 16 == 0 || f < 16);
+        std::array<uint8_t, 4> pixel;
+        glReadPixels(target_size / 2, target_size / 2, 1, 1, GL_RGBA, GL_UNSIGNED_BYTE, pixel.data());
+        eig::Array4f expected = { frame.colr.x(), frame.colr.y(), frame.colr.z(), 1.f };
+        for (uint i = 0; i < 4; ++i)
+          if (std::abs(static_cast<float>(pixel[i]) / 255.f - expected[i]) > 1.f / 128.f) {
+            mismatches++;
+            break;
+          }
+      }
+      glFinish();
+      double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - time_start).count();
+
+      fmt::print("{:<8} {:>10.2f} ms/frame {:>8.2f} objects/frame {:>6} steady-state objects {:>6.2f} fences/frame {:>4} mismatches\n",
+        name, time / n_frames, static_cast<double>(objects) / n_frames, objects_steady,
+        static_cast<double>(fences) / n_frames, mismatches);
+      is_valid = is_valid && mismatches == 0;
+      return objects_steady;
+    };
+
+    // Per-frame buffer and vertex array creation, as baseline
+    run("legacy", [](const CheckFrame &frame) {
+      draw_legacy(frame);
+      return false;
+    });
+
+    // Persistent mapped ring; a deliberately small initial slot size exercises growth
+    uint ring_objects;
+    {
+      DrawUploads uploads({ .slot_size = 1 << 12, .slots = 3 });
+      ring_objects = run("ring", [&](const CheckFrame &frame) {
+        uint grows = uploads.ring().grows();
+        uploads.upload(frame.elems, frame.verts, frame.colrs, obj_span<const std::byte>(frame.settings));
+        uploads.bind();
+        uploads.draw(GL_TRIANGLES);
+        return uploads.ring().grows() != grows;
+      });
+      fmt::print("ring: {} slots of {} bytes, {} grows, {} stalls\n",
+        uploads.ring().slots(), uploads.ring().slot_size(), uploads.ring().grows(), uploads.ring().stalls());
+    }
+
+    glDeleteProgram(program);
+    glDeleteFramebuffers(1, &framebuffer);
+    glDeleteTextures(1, &texture);
+
+    if (ring_objects > 0)
+      fmt::print(stderr, "ring created {} GL objects outside of growth\n", ring_objects);
+    if (!is_valid)
+      fmt::print(stderr, "readback did not match expected colors\n");
+    return is_valid && ring_objects == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+} // namespace prg
+
+// Application entry point
+int main(int argc, const char *argv[]) {
+  try {
+    return prg::run_gpu_upload_check({ argv, static_cast<size_t>(argc) });
+  } catch (const std::exception &e) {
+    fmt::print(stderr, "{}\n", e.what());
+    return EXIT_FAILURE;
+  }
+}
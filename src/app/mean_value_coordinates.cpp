@@ -20,9 +20,15 @@
 
 #include <cstdlib>
 #include <exception>
+#include <core/edit_session.hpp>
+#include <core/frame_pacer.hpp>
+#include <core/gpu_ring.hpp>
 #include <core/imgui.hpp>
 #include <core/math.hpp>
 #include <core/mesh.hpp>
+#include <core/mvc.hpp>
+#include <core/mvc_texture.hpp>
+#include <core/program_cache.hpp>
 #include <core/utility.hpp>
 #include <small_gl/array.hpp>
 #include <small_gl/buffer.hpp>
@@ -30,6 +36,8 @@
 #include <small_gl/texture.hpp>
 #include <small_gl/utility.hpp>
 #include <small_gl/window.hpp>
+#include <glad/glad.h>
+#include <algorithm>
 
 namespace prg {
   // List of default flags to have a simple, antialiased, movable/sizeable window
@@ -39,68 +47,96 @@ namespace prg {
     | gl::WindowFlags::eMSAA prg_debug_insert(| gl::WindowFlags::eDebug); 
   
   // Initial polygonal data layout
-  std::vector<eig::Vector2f> verts = {
+  std::vector<eig::Vector2f> verts_init = {
     eig::Array2f { .25, .5 },
     eig::Array2f { .5, .25 },
     eig::Array2f { .75, .5 },
     eig::Array2f { .5, .75 }
   };
-  std::vector<eig::AlArray3f> colrs = {
+  std::vector<eig::AlArray3f> colrs_init = {
     eig::AlArray3f { 1, 0, 0 },
     eig::AlArray3f { 0, 1, 0 },
     eig::AlArray3f { 0, 0, 1 },
     eig::AlArray3f { 1, 1, 0 }
   };
 
-
-  // Method settings flags
-  enum class Method : uint {
-    eBarycentric     = 0,
-    eMeanValueCoords = 1
-  };
-
-  // Unnamed settings object, pushed to shaders through uniform data
+  // Polygon editing state; all edits go through the session, s.t. they can be recorded to
+  // trace_path and replayed headless by replay_edits, which shares the derived data updates
+  EditSession           session;
+  EditFrame             session_frame;
+  UndoMemory            history_memory   = { };
+  uint                  history_revision = static_cast<uint>(-1);
+  constexpr const char *trace_path = "edit_trace.json";
+
+  // Unnamed settings object, pushed to shaders through uniform data; scalar members
+  // are tightly packed 4-byte values to match the std140 layout, so bools are stored as uint;
+  // headless checks mirror this layout through CheckSettings in headless_context.hpp
   struct {
     alignas(16) eig::Matrix4f projection;
-    alignas(16) bool          draw_lines  = false;
-    alignas(16) Method        draw_method = Method::eBarycentric;
+    uint                      draw_lines     = false;
+    DrawMethod                draw_method    = DrawMethod::eBarycentric;
+    MvcPrecision              draw_precision = MvcPrecision::eExact;
   } settings;
   
   // Draw objects
   gl::Window  window;
+  FramePacer  frame_pacer;
   gl::Array   default_array; // Empty VAO as we'll be doing vertex pulling
-  gl::Program polygon_program;
-  gl::Program mvc_program;
-  gl::Program bary_program;
+
+  // Shader programs are owned by the program cache, which reuses linked binaries of a
+  // previous run; the build removes shaders.bin whenever shaders are recompiled
+  ProgramCache program_cache;
+  uint         polygon_program     = 0;
+  uint         mvc_program         = 0;
+  uint         bary_program        = 0;
+  uint         mvc_weights_program = 0; // Compute pass writing mvc_weights
+  uint         mvc_blend_program   = 0; // Blends colors over mvc_weights
+
+  // Per-frame draw data goes through persistent mapped ring buffers and a single vertex
+  // array; GL object creations over the last frame are counted to keep it that way
+  DrawUploads    draw_uploads;
+  GlObjectCounts gl_counts_frame = { };
+
+  // Cached per-pixel weights, re-evaluated only if vertex positions, view or method change
+  MvcWeightTexture mvc_weights;
   
   // Vertex selection/editing data 
   std::optional<uint> vert_mouseover;
   std::optional<uint> vert_selected;
   ImGui::Gizmo2D      vert_gizmo;
 
+  // Vertex table state; the table shows this many rows, and scrolls to vert_scroll_to
+  // once on the next frame, if the selection was changed from outside the table
+  constexpr uint      vert_table_rows = 16;
+  std::optional<uint> vert_scroll_to;
+  int                 vert_jump = 0;
+
   void init_mean_value_coordinates() {
+    session = EditSession(verts_init, colrs_init);
+
     // Load VAO; leave empty for now and just do vertex pulling
     default_array = {{}};
 
-    // Load shader programs
-    polygon_program = {{ .type       = gl::ShaderType::eVertex,
-                         .glsl_path  = "shaders/draw_polygon.vert",
-                         .cross_path = "shaders/draw_polygon.vert.json" },
-                       { .type       = gl::ShaderType::eFragment,
-                         .glsl_path  = "shaders/draw_polygon.frag",
-                         .cross_path = "shaders/draw_polygon.frag.json" }};
-    mvc_program = {{ .type       = gl::ShaderType::eVertex,
-                     .glsl_path  = "shaders/draw_mvc.vert",
-                     .cross_path = "shaders/draw_mvc.vert.json" },
-                   { .type       = gl::ShaderType::eFragment,
-                     .glsl_path  = "shaders/draw_mvc.frag",
-                     .cross_path = "shaders/draw_mvc.frag.json" }};
-    bary_program = {{ .type       = gl::ShaderType::eVertex,
-                      .glsl_path  = "shaders/draw_bary.vert",
-                      .cross_path = "shaders/draw_bary.vert.json" },
-                    { .type       = gl::ShaderType::eFragment,
-                      .glsl_path  = "shaders/draw_bary.frag",
-                      .cross_path = "shaders/draw_bary.frag.json" }};
+    // Count GL object creations, and create the upload ring and vertex array once
+    install_gl_object_counters();
+    draw_uploads = DrawUploads({ .slot_size = 1 << 20, .slots = 3 });
+
+    // Load shader programs, from cached binaries where possible, and write back new ones
+    program_cache = ProgramCache({ .path = "shaders/shaders.bin" });
+    auto programs = program_cache.build(std::vector<std::vector<ProgramStage>> {
+      {{ GL_VERTEX_SHADER,  "shaders/draw_polygon.vert"     }, { GL_FRAGMENT_SHADER, "shaders/draw_polygon.frag"   }},
+      {{ GL_VERTEX_SHADER,  "shaders/draw_mvc.vert"         }, { GL_FRAGMENT_SHADER, "shaders/draw_mvc.frag"       }},
+      {{ GL_VERTEX_SHADER,  "shaders/draw_bary.vert"        }, { GL_FRAGMENT_SHADER, "shaders/draw_bary.frag"      }},
+      {{ GL_COMPUTE_SHADER, "shaders/eval_mvc_weights.comp" }},
+      {{ GL_VERTEX_SHADER,  "shaders/draw_mvc.vert"         }, { GL_FRAGMENT_SHADER, "shaders/draw_mvc_blend.frag" }}
+    });
+    polygon_program     = programs[0];
+    mvc_program         = programs[1];
+    bary_program        = programs[2];
+    mvc_weights_program = programs[3];
+    mvc_blend_program   = programs[4];
+    if (!program_cache.save())
+      fmt::print(stderr, "Could not write program cache shaders/shaders.bin\n");
   }
 
   void update_mean_value_coordinates() {
@@ -109,90 +145,187 @@ namespace prg {
 
     // Spawn small settings/vertex config window
     if (ImGui::Begin("ImGui")) {
+      ImGui::SeparatorText("Frames");
+
+      constexpr std::array<const char *, 2> redraw_names = { "Continuous", "On demand" };
+      int redraw = static_cast<int>(frame_pacer.info().mode);
+      if (ImGui::Combo("Redraw", &redraw, redraw_names.data(), redraw_names.size()))
+        frame_pacer.set_mode(static_cast<RedrawMode>(redraw));
+      bool vsync = frame_pacer.info().vsync;
+      if (ImGui::Checkbox("Vsync", &vsync))
+        frame_pacer.set_vsync(vsync);
+      float frame_budget = frame_pacer.info().frame_budget * 1000.f;
+      if (ImGui::SliderFloat("Frame budget", &frame_budget, 0.f, 100.f, "%.1f ms"))
+        frame_pacer.set_frame_budget(frame_budget * .001f);
+      const auto &stats = frame_pacer.stats();
+      ImGui::Text("%.1f fps, cpu %.1f%%, idle cpu %.1f%%", 
+        stats.frame_rate, stats.cpu_usage * 100.f, stats.idle_cpu_usage * 100.f);
+      ImGui::Text("GL objects/frame %u, upload stalls %u, grows %u",
+        gl_counts_frame.objects(), draw_uploads.ring().stalls(), draw_uploads.ring().grows());
+      const auto &program_stats = program_cache.stats();
+      ImGui::Text("Programs: %u cached, %u compiled%s, %.1f ms",
+        program_stats.hits, program_stats.misses, program_stats.is_parallel ? " in parallel" : "", program_stats.time_ms);
+
+      ImGui::SeparatorText("Recording");
+
+      if (!session.is_recording()) {
+        if (ImGui::Button("Start recording"))
+          session.start_recording(window.window_size().cast<uint>());
+      } else {
+        if (ImGui::Button("Stop and save"))
+          save_edit_trace(trace_path, session.stop_recording());
+        ImGui::SameLine();
+        ImGui::Text("Recording edits to %s", trace_path);
+      }
+
       ImGui::SeparatorText("Settings");
 
-      bool is_mvc = (settings.draw_method == Method::eMeanValueCoords);
-      ImGui::Checkbox("Draw mean value coords", &is_mvc);
-      if (is_mvc)
-        ImGui::Checkbox("Draw grid lines", &settings.draw_lines);
-      settings.draw_method = is_mvc ? Method::eMeanValueCoords : Method::eBarycentric;
+      auto edit_settings = session.settings();
+      constexpr std::array<const char *, 3> method_names = { "Barycentric", "Mean value coords", "Wachspress" };
+      int method = static_cast<int>(edit_settings.draw_method);
+      ImGui::Combo("Method", &method, method_names.data(), method_names.size());
+      edit_settings.draw_method = static_cast<DrawMethod>(method);
+      if (edit_settings.draw_method == DrawMethod::eMeanValueCoords)
+        ImGui::Checkbox("Use Wachspress if convex", &edit_settings.auto_wachspress);
+      if (edit_settings.draw_method != DrawMethod::eBarycentric)
+        ImGui::Checkbox("Draw grid lines", &edit_settings.draw_lines);
+      if (edit_settings.draw_method == DrawMethod::eMeanValueCoords) {
+        bool is_fast = edit_settings.draw_precision == MvcPrecision::eFast;
+        ImGui::Checkbox("Fast-math approximations", &is_fast);
+        edit_settings.draw_precision = is_fast ? MvcPrecision::eFast : MvcPrecision::eExact;
+      }
+      if (edit_settings != session.settings()) {
+        session.set_settings(edit_settings);
+        frame_pacer.invalidate();
+      }
       
       ImGui::SeparatorText("Vertices");
 
-      if (ImGui::Button("Add vertex")) {
-        // Search for longest edge
-        float edge_l = (verts[1] - verts[0]).norm();
-        uint  vert_i = 0;
-        for (uint i = 0; i < verts.size(); ++i) {
-          float edge_l_ = (verts[(i + 1) % verts.size()] - verts[i]).norm();
-          guard_continue(edge_l_ > edge_l);
-          edge_l = edge_l_;
-          vert_i = i;
-        }
-        fmt::print("{}\n", vert_i);
-        
-        // Generate spliting vertex on longest edge
-        auto vert = (.5f * verts[vert_i].array() + .5f * verts[(vert_i + 1) % verts.size()].array()).eval();
-        auto colr = (.5f * colrs[vert_i].array() + .5f * colrs[(vert_i + 1) % verts.size()].array()).eval();
-        
-        // Insert splitting vertex in between vertices of longest edge
-        verts.insert(verts.begin() + vert_i + 1, vert);
-        colrs.insert(colrs.begin() + vert_i + 1, colr);
+      // Insert splitting vertex halfway along the longest edge
+      if (ImGui::Button("Add vertex"))
+        session.split_longest_edge();
+
+      // Undo/redo through buttons or Ctrl+Z/Ctrl+Y, unless a text field has focus
+      bool is_shortcut = io.KeyCtrl && !io.WantTextInput;
+      ImGui::SameLine();
+      ImGui::BeginDisabled(!session.history().can_undo());
+      if (ImGui::Button("Undo") || (is_shortcut && ImGui::IsKeyPressed(ImGuiKey_Z, false) && session.history().can_undo()))
+        session.undo();
+      ImGui::EndDisabled();
+      ImGui::SameLine();
+      ImGui::BeginDisabled(!session.history().can_redo());
+      if (ImGui::Button("Redo") || (is_shortcut && ImGui::IsKeyPressed(ImGuiKey_Y, false) && session.history().can_redo()))
+        session.redo();
+      ImGui::EndDisabled();
+
+      // Undo may remove the selected vertex
+      if (vert_selected && *vert_selected >= session.verts().size()) {
+        vert_selected = { };
+        vert_gizmo.set_active(false);
+      }
+
+      // Memory use of the history, recounted only after edits
+      if (history_revision != session.revision()) {
+        history_memory   = session.history().memory();
+        history_revision = session.revision();
+      }
+      ImGui::Text("History: step %u of %u, %.2f MiB (%.2f MiB as full copies)",
+        session.history().current_step(), session.history().steps(),
+        history_memory.bytes / 1048576.0, history_memory.bytes_flat / 1048576.0);
+
+      auto verts = session.verts();
+      auto colrs = session.colrs();
+      
+      // Jump to vertex by index; selects the vertex, and scrolls the table to it
+      if (ImGui::InputInt("Jump to", &vert_jump, 1, 100, ImGuiInputTextFlags_EnterReturnsTrue) && !verts.empty()) {
+        vert_jump      = std::clamp(vert_jump, 0, static_cast<int>(verts.size()) - 1);
+        vert_selected  = static_cast<uint>(vert_jump);
+        vert_scroll_to = vert_selected;
+        vert_gizmo.set_active(false);
       }
       
-      // List of vertex color data
-      if (ImGui::BeginTable("'##data_table", 3, ImGuiTableFlags_SizingStretchProp)) {
+      // List of vertex color data; virtualized, s.t. only visible rows are submitted
+      std::optional<uint> vert_erased;
+      auto table_size = ImVec2(0.f, ImGui::GetFrameHeightWithSpacing() * (vert_table_rows + 1));
+      if (ImGui::BeginTable("'##data_table", 4, ImGuiTableFlags_SizingStretchProp | ImGuiTableFlags_ScrollY, table_size)) {
         // Setup table header
         ImGui::TableSetupScrollFreeze(0, 1);
         ImGui::TableNextRow();
-        ImGui::TableSetColumnIndex(0); ImGui::Text("Position");
-        ImGui::TableSetColumnIndex(1); ImGui::Text("Color");
-
-        for (uint i = 0; i < verts.size(); ++i) {
-          ImGui::PushID(i);
-          ImGui::TableNextRow();
-
-          // Position column
-          ImGui::TableSetColumnIndex(0);
-          ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x);
-          ImGui::DragFloat2("##data_vert", verts[i].data(), .05f);
-
-          // Color column
-          ImGui::TableSetColumnIndex(1);
-          ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x);
-          ImGui::ColorEdit3("##data_colr", colrs[i].data(), ImGuiColorEditFlags_NoInputs | ImGuiColorEditFlags_InputRGB);
-
-          ImGui::TableSetColumnIndex(2);
-          if (ImGui::Button("X")) {
-          // Delete button (exits mesh early)
-            verts.erase(verts.begin() + i);
-            colrs.erase(colrs.begin() + i);
+        ImGui::TableSetColumnIndex(0); ImGui::Text("Index");
+        ImGui::TableSetColumnIndex(1); ImGui::Text("Position");
+        ImGui::TableSetColumnIndex(2); ImGui::Text("Color");
+
+        ImGuiListClipper clipper;
+        clipper.Begin(static_cast<int>(verts.size()));
+        if (vert_scroll_to && *vert_scroll_to < verts.size())
+          clipper.IncludeItemByIndex(static_cast<int>(*vert_scroll_to));
+        while (clipper.Step()) {
+          for (uint i = clipper.DisplayStart; i < static_cast<uint>(clipper.DisplayEnd); ++i) {
+            ImGui::PushID(i);
+            ImGui::TableNextRow();
+
+            // Index column; selecting a row selects the vertex for the gizmo
+            ImGui::TableSetColumnIndex(0);
+            if (ImGui::Selectable(fmt::format("{}", i).c_str(), vert_selected == i)) {
+              vert_selected = i;
+              vert_gizmo.set_active(false);
+            }
+            if (vert_scroll_to == i) {
+              ImGui::SetScrollHereY(.5f);
+              vert_scroll_to = { };
+            }
+
+            // Position column
+            ImGui::TableSetColumnIndex(1);
+            ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x);
+            if (eig::Vector2f vert = verts[i]; ImGui::DragFloat2("##data_vert", vert.data(), .05f))
+              session.set_vert(i, vert);
+
+            // Color column
+            ImGui::TableSetColumnIndex(2);
+            ImGui::SetNextItemWidth(ImGui::GetContentRegionAvail().x);
+            if (eig::AlArray3f colr = colrs[i]; ImGui::ColorEdit3("##data_colr", colr.data(), ImGuiColorEditFlags_NoInputs | ImGuiColorEditFlags_InputRGB))
+              session.set_colr(i, colr);
+
+            // Delete button; deferred until the table is done
+            ImGui::TableSetColumnIndex(3);
+            if (ImGui::Button("X"))
+              vert_erased = i;
+
             ImGui::PopID();
-            break;
           }
-
-          ImGui::PopID();
         }
         ImGui::EndTable();
       }
+
+      // Delete vertex, and keep the selection on the same vertex if it survives
+      if (vert_erased) {
+        session.erase_vert(*vert_erased);
+        if (vert_selected == vert_erased) {
+          vert_selected = { };
+          vert_gizmo.set_active(false);
+        } else if (vert_selected && *vert_selected > *vert_erased) {
+          vert_selected = *vert_selected - 1;
+        }
+      }
     } 
     ImGui::End();
 
+    // Keep redrawing while widgets are held, and blink the text cursor
+    if (ImGui::IsAnyItemActive())
+      frame_pacer.invalidate();
+    if (io.WantTextInput)
+      frame_pacer.invalidate_after(.5f);
+
     // Handle gizmo input to move vertices
     {
-      // Projection matrix
-      float aspect = static_cast<float>(window.framebuffer_size().x())
-                  / static_cast<float>(window.framebuffer_size().y());
-      auto proj = eig::ortho(-aspect, aspect, -1.f, 1.f, -1.f, 1.f);
-
-      // Iterate polygon vertices; find closest mouseover candidate
-      vert_mouseover = { };
-      for (uint i = 0; i < verts.size(); ++i) {
-        auto v = (eig::Vector3f() << verts[i].array() * 2.f - 1.f, 0).finished();
-        auto p = eig::world_to_window_space(v, proj, { 0, 0 }, window.window_size().cast<float>().eval());
-        guard_continue((p - mouse_pos).norm() <= 8.f);
-        vert_mouseover = i;
-      }
+      // Rebuild picking grid over window-space vertices on edits or view changes
+      auto view = edit_view_transform(window.window_size().cast<float>());
+      if (session.update_pick(session_frame, view, edit_pick_radius))
+        frame_pacer.invalidate();
+
+      // Find nearest mouseover candidate
+      vert_mouseover = session_frame.pick_grid.find_nearest(mouse_pos, edit_pick_radius);
 
       // On mouseclick and no near vertex/gizmo, deselect and kill gizmo
       if (io.MouseClicked[0] && !vert_gizmo.is_over() && !vert_mouseover) {
@@ -202,19 +335,21 @@ namespace prg {
 
       // On mouseclick and near vertex and no gizmo, set as selected
       if (io.MouseClicked[0] && vert_mouseover) {
-        vert_selected = vert_mouseover;
+        vert_selected  = vert_mouseover;
+        vert_scroll_to = vert_mouseover;
       }
 
       // Register gizmo use start, do nothing else
       guard(vert_selected);
-      auto vert = verts[*vert_selected];
+      auto vert = session.verts()[*vert_selected];
       eig::Affine3f trf_init(eig::Translation3f((eig::Array3f() << vert, 0).finished()));
       if (vert_gizmo.begin_delta(window, trf_init)) { /* ... */ }
 
       // Register continuous gizmo use; apply transform to vertex
       if (auto [active, delta] = vert_gizmo.eval_delta(); active) {
-        auto &vert = verts[*vert_selected];
-        vert = (delta * (eig::Vector3f() << vert, 0).finished()).head<2>();      
+        auto vert = session.verts()[*vert_selected];
+        session.set_vert(*vert_selected, (delta * (eig::Vector3f() << vert, 0).finished()).head<2>());
+        frame_pacer.invalidate();
       }
 
       // Register gizmo use end; do nothing else
@@ -223,34 +358,27 @@ namespace prg {
   }
 
   void draw_mean_value_coordinates() {
-    // Triangulate the polygon on the fly; not a good or stable triangulation, but whatever
-    auto elems = triangulate_polygon(cnt_span<const eig::Vector2f>(verts));
+    // Regenerate triangulation and effective draw method, if the polygon changed; not a good
+    // or stable triangulation, but whatever. Large polygons draw a coarse preview during drags
+    bool is_dragging = vert_gizmo.is_active() || ImGui::IsAnyItemActive();
+    session.update_draw(session_frame, is_dragging, vert_selected);
+    auto elems = session_frame.draw_elems();
+    auto verts = session_frame.draw_verts(session.verts());
+    auto colrs = session_frame.draw_colrs(session.colrs());
     guard(!elems.empty());
-
-    // Generate aligned block of color data
-    std::vector<eig::AlArray3f> colrs_aligned(range_iter(colrs));
     
-    // Update projection matrix
+    // Update projection matrix and draw settings
     float aspect = static_cast<float>(window.framebuffer_size().x())
                  / static_cast<float>(window.framebuffer_size().y());
-    settings.projection = eig::ortho(-aspect, aspect, -1.f, 1.f, -1.f, 1.f).matrix();
-
-    // Push fresh vertex/element/color/settings data to new buffers;
-    // we're eating the cost of per-frame buffer creation for simplicity
-    gl::Buffer polygon_elems   = {{ .data = cnt_span<const std::byte>(elems)         }};
-    gl::Buffer polygon_verts   = {{ .data = cnt_span<const std::byte>(verts)         }};
-    gl::Buffer polygon_colrs   = {{ .data = cnt_span<const std::byte>(colrs_aligned) }};
-    gl::Buffer settings_buffer = {{ .data = obj_span<const std::byte>(settings)      }};
-
-    // Declare fresh VAO assembling polygon buffers;
-    // we're eating the cost of per-frame VAO creation for simplicity
-    gl::Array polygon_array = {{
-      .buffers  = {{ .buffer = &polygon_verts, .index = 0, .stride = sizeof(eig::Vector2f)  },
-                   { .buffer = &polygon_colrs, .index = 1, .stride = sizeof(eig::Vector4f)  }},
-      .attribs  = {{ .attrib_index = 0, .buffer_index = 0, .size = gl::VertexAttribSize::e2 },
-                   { .attrib_index = 1, .buffer_index = 1, .size = gl::VertexAttribSize::e3 }},
-      .elements = &polygon_elems
-    }};
+    settings.projection     = eig::ortho(-aspect, aspect, -1.f, 1.f, -1.f, 1.f).matrix();
+    settings.draw_lines     = session.settings().draw_lines;
+    settings.draw_method    = session_frame.draw_method;
+    settings.draw_precision = session.settings().draw_precision;
+
+    // Push vertex/element/color/settings data into this frame's ring slot, and point the
+    // vertex array at it; no GL objects are created in steady state
+    draw_uploads.upload(elems, verts, colrs, obj_span<const std::byte>(settings));
+    draw_uploads.bind();
 
     // Set draw state; we'll be drawing to the default framebuffer directly,
     // no funny business whatsoever
@@ -262,51 +390,41 @@ namespace prg {
     gl::state::set_viewport(window.framebuffer_size());
     gl::state::set_line_width(2.f);
 
-    // Draw fullscreen quad, which generates the MVC background
-    if (settings.draw_method == Method::eBarycentric) {
-      // Bind relevant resources using program names
-      bary_program.bind("b_buffer_settings", settings_buffer);
-
-      // Submit draw info
-      gl::dispatch_draw({ 
-        .type             = gl::PrimitiveType::eTriangles, 
-        .vertex_count     = static_cast<uint>(elems.size()) * 3,
-        .draw_op          = gl::DrawOp::eFill,
-        .bindable_array   = &polygon_array,
-        .bindable_program = &bary_program
-      });
-    } else if (settings.draw_method == Method::eMeanValueCoords) {
-      // Bind relevant resources using program names
-      mvc_program.bind("b_buffer_verts",    polygon_verts);
-      mvc_program.bind("b_buffer_colrs",    polygon_colrs);
-      mvc_program.bind("b_buffer_settings", settings_buffer);
-
-      // Submit draw info
-      gl::dispatch_draw({ 
-        .type             = gl::PrimitiveType::eTriangleStrip, 
-        .vertex_count     = static_cast<uint>(elems.size()) * 3,
-        .draw_op          = gl::DrawOp::eFill,
-        .bindable_array   = &polygon_array,
-        .bindable_program = &mvc_program
-      });
+    // Draw fullscreen quad, which generates the MVC background; resources are bound by
+    // draw_uploads at the shaders' explicit bindings
+    if (settings.draw_method == DrawMethod::eBarycentric) {
+      glUseProgram(bary_program);
+      glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+      draw_uploads.draw(GL_TRIANGLES);
+    } else if ((settings.draw_method == DrawMethod::eMeanValueCoords
+             || settings.draw_method == DrawMethod::eWachspress)
+             && MvcWeightTexture::supports(verts.size())) {
+      // Re-evaluate weights only if geometry, view or method changed, then blend colors
+      // over the triangulation
+      eig::Array2u size = window.framebuffer_size().cast<uint>();
+      if (mvc_weights.is_stale(verts, size, settings.projection, settings.draw_method)) {
+        glUseProgram(mvc_weights_program);
+        mvc_weights.eval(verts, size, settings.projection, settings.draw_method);
+      }
+      mvc_weights.bind(0);
+      glUseProgram(mvc_blend_program);
+      glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+      draw_uploads.draw(GL_TRIANGLES);
+    } else if (settings.draw_method == DrawMethod::eMeanValueCoords
+            || settings.draw_method == DrawMethod::eWachspress) {
+      // Larger polygons evaluate weights per pixel in the fragment shader
+      glUseProgram(mvc_program);
+      glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+      draw_uploads.draw(GL_TRIANGLES);
     } else {
       /* ... */
     }
 
     // Draw polygon lines over background
-    {
-      // Bind relevant resources using program names
-      polygon_program.bind("b_buffer_settings", settings_buffer);
-
-      // Submit draw info
-      gl::dispatch_draw({ 
-        .type             = gl::PrimitiveType::eTriangles, 
-        .vertex_count     = static_cast<uint>(elems.size()) * 3,
-        .draw_op          = gl::DrawOp::eLine,
-        .bindable_array   = &polygon_array,
-        .bindable_program = &polygon_program,
-      });
-    }
+    glUseProgram(polygon_program);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+    draw_uploads.draw(GL_TRIANGLES);
+    glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
   }
 
   // Application main code
@@ -324,6 +442,9 @@ namespace prg {
       gl::debug::insert_message("OpenGL messages enabled", gl::DebugMessageSeverity::eLow);
     }
 
+    // Setup frame pacing; precedes ImGui, s.t. both receive window events
+    frame_pacer = {window, { .mode = RedrawMode::eOnDemand, .vsync = true }};
+
     // Setup ImGui
     ImGui::Initialize(window);
 
@@ -331,7 +452,9 @@ namespace prg {
     init_mean_value_coordinates();
 
     while (!window.should_close()) { 
-      window.poll_events();
+      // Block until the next frame is invalidated, in on-demand mode
+      frame_pacer.wait_frame(window);
+      guard_break(!window.should_close());
     // Primary window mesh
       ImGui::BeginFrame();
       // First window mesh components
@@ -341,14 +464,27 @@ namespace prg {
       default_framebuffer.clear(gl::FramebufferType::eColor, eig::Array4f(0, 0, 0, 1));
 
       // Primary code components go here 
+      auto gl_counts = gl_object_counts();
       update_mean_value_coordinates();
       draw_mean_value_coordinates();
+      session.next_frame();
+      gl_counts_frame = gl_object_counts() - gl_counts;
 
       ImGui::DrawFrame();
       window.swap_buffers();
       // Last window mesh components
     }
 
+    // Save a recording still in progress
+    if (session.is_recording())
+      save_edit_trace(trace_path, session.stop_recording());
+
+    // Release the upload ring, weights and programs while their context is current; waits on frames
+    // in flight
+    draw_uploads  = { };
+    mvc_weights   = { };
+    program_cache = { };
+
     // Tear down ImGui before window destruction
     ImGui::Destroy();
   }
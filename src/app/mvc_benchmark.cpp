@@ -0,0 +1,1681 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdlib>
+#include <exception>
+#include <core/curved_polygon.hpp>
+#include <core/deform.hpp>
+#include <core/draw_batch.hpp>
+#include <core/edit_session.hpp>
+#include <core/editable_polygon.hpp>
+#include <core/kernels.hpp>
+#include <core/math.hpp>
+#include <core/mesh.hpp>
+#include <core/mvc.hpp>
+#include <core/point_grid.hpp>
+#include <core/polygon_collection.hpp>
+#include <core/polygon_lod.hpp>
+#include <core/tiled_render.hpp>
+#include <core/utility.hpp>
+#include <core/weight_field.hpp>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <limits>
+#include <numeric>
+#include <omp.h>
+#include <optional>
+#include <random>
+#include <string>
+#include <string_view>
+#include <tuple>
+
+namespace prg {
+  // Benchmark settings
+  constexpr uint bench_grid_size = 512; // Evaluated points form a grid of this resolution
+  constexpr uint bench_runs      = 7;   // Timings are the median over this nr. of runs
+  
+  // Polygon generators under test, keyed by name
+  const std::vector<std::pair<std::string, std::function<std::vector<eig::Vector2f>(uint)>>> 
+  bench_polygons = {
+    { "regular", [](uint n) { return generate_regular_polygon(n); } },
+    { "star",    [](uint n) { return generate_star_polygon(n);    } },
+    { "random",  [](uint n) { return generate_random_polygon(n);  } }
+  };
+
+  // Time a callable over bench_runs, returning the median in milliseconds
+  template <typename F>
+  double time_median(F f) {
+    std::vector<double> times(bench_runs);
+    for (auto &time : times) {
+      auto time_start = std::chrono::steady_clock::now();
+      f();
+      time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - time_start).count();
+    }
+    std::ranges::nth_element(times, times.begin() + times.size() / 2);
+    return times[times.size() / 2];
+  }
+  
+  // Regular grid of points over [0, 1]^2, with points on pixel centers
+  std::vector<eig::Vector2f> generate_grid_points(uint size) {
+    std::vector<eig::Vector2f> points(size * size);
+    for (uint y = 0; y < size; ++y)
+      for (uint x = 0; x < size; ++x)
+        points[y * size + x] = (eig::Array2f(x, y) + .5f) / static_cast<float>(size);
+    return points;
+  }
+
+  // Compare weights-only against fused weight/gradient evaluation; analytic gradients must
+  // match central differences at interior points spread over the polygon, which keep a
+  // margin to the boundary as differences are unreliable close to it
+  bool run_gradient_benchmark(std::span<const eig::Vector2f> points) {
+    constexpr float h              = 1e-3f;
+    constexpr float grad_margin    = 2e-2f;
+    constexpr float grad_err_bound = 1e-3f;
+
+    fmt::print("Fused MVC weights and gradients, {} points\n", points.size());
+    fmt::print("  {:<8} {:>4} {:>12} {:>12} {:>8} {:>12}\n", "polygon", "n", "weights (ms)", "fused (ms)", "ratio", "grad error");
+    
+    // Distance from a point to the nearest polygon edge
+    auto boundary_distance = [](std::span<const eig::Vector2f> verts, const eig::Vector2f &p) {
+      float dist = std::numeric_limits<float>::max();
+      for (uint j = 0; j < verts.size(); ++j) {
+        eig::Vector2f a = verts[j], ab = verts[(j + 1) % verts.size()] - a;
+        float t = std::clamp((p - a).dot(ab) / ab.squaredNorm(), 0.f, 1.f);
+        dist = std::min(dist, (a + t * ab - p).norm());
+      }
+      return dist;
+    };
+
+    bool is_valid = true;
+    for (const auto &[name, generate] : bench_polygons) {
+      for (uint n : { 4u, 8u, 16u, 64u }) {
+        auto verts = generate(n);
+        std::vector<float>         weights(points.size() * n);
+        std::vector<eig::Vector2f> grads(points.size() * n);
+
+        double time_weights = time_median([&] { eval_mvc(verts, points, weights); });
+        double time_fused   = time_median([&] { eval_mvc(verts, points, weights, grads); });
+
+        // Relative gradient error against fourth-order central differences
+        float grad_err = 0.f;
+        std::vector<float> w_lo(n), w_hi(n), w_lo2(n), w_hi2(n);
+        for (uint i = 0; i < points.size(); i += 7) {
+          guard_continue(is_inside_polygon(verts, points[i]));
+          guard_continue(boundary_distance(verts, points[i]) >= grad_margin);
+          auto grads_i = std::span(grads).subspan(i * n, n);
+          for (uint d = 0; d < 2; ++d) {
+            eig::Vector2f dp = eig::Vector2f::Unit(d) * h;
+            eval_mvc(verts, (points[i] - dp).eval(),       w_lo);
+            eval_mvc(verts, (points[i] + dp).eval(),       w_hi);
+            eval_mvc(verts, (points[i] - 2.f * dp).eval(), w_lo2);
+            eval_mvc(verts, (points[i] + 2.f * dp).eval(), w_hi2);
+            for (uint j = 0; j < n; ++j) {
+              float fd = (8.f * (w_hi[j] - w_lo[j]) - (w_hi2[j] - w_lo2[j])) / (12.f * h);
+              grad_err = std::max(grad_err, std::abs(fd - grads_i[j][d]) / std::max(1.f, std::abs(fd)));
+            }
+          }
+        }
+
+        is_valid &= grad_err <= grad_err_bound;
+        fmt::print("  {:<8} {:>4} {:>12.2f} {:>12.2f} {:>8.2f} {:>12.2e}\n", 
+          name, n, time_weights, time_fused, time_fused / time_weights, grad_err);
+      }
+    }
+
+    if (!is_valid)
+      fmt::print(stderr, "MVC gradients failed validation\n");
+    return is_valid;
+  }
+
+  // Compare Wachspress against mean value coordinates on convex polygons, for points inside
+  // the polygon; Wachspress coordinates must keep partition of unity and linear precision
+  bool run_wachspress_benchmark(std::span<const eig::Vector2f> points_) {
+    constexpr float unity_err_bound  = 1e-5f;
+    constexpr float linear_err_bound = 1e-5f;
+
+    fmt::print("Wachspress against MVC on convex polygons, interior points\n");
+    fmt::print("  {:>4} {:>12} {:>12} {:>8} {:>12} {:>12}\n", "n", "mvc (ms)", "wp (ms)", "speedup", "unity error", "linear error");
+
+    bool is_valid = true;
+    for (uint n : { 4u, 8u, 16u, 64u }) {
+      auto verts = generate_regular_polygon(n);
+      std::vector<eig::Vector2f> points;
+      std::ranges::copy_if(points_, std::back_inserter(points), 
+        [&](const auto &p) { return is_inside_polygon(verts, p); });
+      std::vector<float> weights(points.size() * n);
+      
+      double time_mvc = time_median([&] { eval_mvc(verts, points, weights); });
+      double time_wp  = time_median([&] { eval_wachspress(verts, points, weights); });
+
+      float unity_err = 0.f, linear_err = 0.f;
+      for (uint i = 0; i < points.size(); ++i) {
+        auto weights_i = std::span(weights).subspan(i * n, n);
+        
+        float         sum = 0.f;
+        eig::Vector2f p   = eig::Vector2f::Zero();
+        for (uint j = 0; j < n; ++j) {
+          sum += weights_i[j];
+          p   += weights_i[j] * verts[j];
+        }
+        unity_err  = std::max(unity_err,  std::abs(sum - 1.f));
+        linear_err = std::max(linear_err, (p - points[i]).norm());
+      }
+
+      is_valid &= unity_err <= unity_err_bound && linear_err <= linear_err_bound;
+      fmt::print("  {:>4} {:>12.2f} {:>12.2f} {:>8.2f} {:>12.2e} {:>12.2e}\n", 
+        n, time_mvc, time_wp, time_mvc / time_wp, unity_err, linear_err);
+    }
+
+    if (!is_valid)
+      fmt::print(stderr, "Wachspress coordinates failed validation\n");
+    return is_valid;
+  }
+
+  // Compare exact against fast-math mean value coordinates; reports the max. abs. weight
+  // error of fast-math evaluation inside the polygon, which must stay within the bound
+  // documented for MvcPrecision::eFast, and fails the run otherwise
+  bool run_precision_benchmark(std::span<const eig::Vector2f> points) {
+    constexpr float weight_err_bound = 5e-5f;
+
+    fmt::print("Exact against fast-math MVC, {} points\n", points.size());
+    fmt::print("  {:<8} {:>4} {:>12} {:>12} {:>8} {:>12}\n", "polygon", "n", "exact (ms)", "fast (ms)", "speedup", "weight error");
+
+    bool is_valid = true;
+    for (const auto &[name, generate] : bench_polygons) {
+      for (uint n : { 4u, 8u, 16u, 64u }) {
+        auto verts = generate(n);
+        std::vector<float> weights_exact(points.size() * n), weights_fast(points.size() * n);
+
+        double time_exact = time_median([&] { eval_mvc(verts, points, weights_exact, MvcPrecision::eExact); });
+        double time_fast  = time_median([&] { eval_mvc(verts, points, weights_fast,  MvcPrecision::eFast);  });
+
+        float weight_err = 0.f;
+        for (uint i = 0; i < points.size(); ++i) {
+          guard_continue(is_inside_polygon(verts, points[i]));
+          for (uint j = i * n; j < (i + 1) * n; ++j)
+            weight_err = std::max(weight_err, std::abs(weights_exact[j] - weights_fast[j]));
+        }
+        is_valid &= weight_err <= weight_err_bound;
+
+        fmt::print("  {:<8} {:>4} {:>12.2f} {:>12.2f} {:>8.2f} {:>12.2e}\n", 
+          name, n, time_exact, time_fast, time_exact / time_fast, weight_err);
+      }
+    }
+    
+    if (!is_valid)
+      fmt::print(stderr, "Fast-math weight error exceeds bound of {:.0e}\n", weight_err_bound);
+    return is_valid;
+  }
+
+  // Evaluate normalized MVC or Wachspress weights through one kernel variant on a single
+  // thread; points which the kernel marks invalid take the scalar path. Setting generic
+  // bypasses the kernel's fixed-size specializations
+  void eval_kernel_weights(const KernelTable             &kernels,
+                           CoordMethod                    method,
+                           std::span<const eig::Vector2f> verts,
+                           std::span<const eig::Vector2f> points,
+                           std::span<float>               weights,
+                           MvcPrecision                   precision,
+                           bool                           generic = false) {
+    const uint n = verts.size();
+    std::vector<float> c(n), e2(n), w(n * kernel_block_size);
+    for (uint i = 0; i < n; ++i) {
+      const auto &v_prev = verts[(i + n - 1) % n], &v_curr = verts[i], &v_next = verts[(i + 1) % n];
+      eig::Vector2f a = v_curr - v_prev, b = v_next - v_curr;
+      c[i]  = a.x() * b.y() - a.y() * b.x();
+      e2[i] = b.squaredNorm();
+    }
+
+    std::array<float, kernel_block_size> sum;
+    std::array<int,   kernel_block_size> valid;
+    auto verts_f  = cast_span<const float>(verts);
+    auto points_f = cast_span<const float>(points);
+    for (uint first = 0; first < points.size(); first += kernel_block_size) {
+      uint size = std::min(kernel_block_size, static_cast<uint>(points.size()) - first);
+      if (method == CoordMethod::eWachspress)
+        kernels.wachspress_block(verts_f.data(), c.data(), e2.data(), n, &points_f[2 * first], 
+          size, generic, w.data(), sum.data(), valid.data());
+      else
+        kernels.mvc_block(verts_f.data(), n, &points_f[2 * first], size, 
+          precision == MvcPrecision::eFast, generic, w.data(), sum.data(), valid.data());
+      
+      for (uint b = 0; b < size; ++b) {
+        auto weights_b = weights.subspan((first + b) * n, n);
+        if (!valid[b]) {
+          if (method == CoordMethod::eWachspress)
+            eval_wachspress(verts, points[first + b], weights_b);
+          else
+            eval_mvc(verts, points[first + b], weights_b, precision);
+          continue;
+        }
+        for (uint i = 0; i < n; ++i)
+          weights_b[i] = w[i * kernel_block_size + b] / sum[b];
+      }
+    }
+  }
+
+  // Time batched MVC and Wachspress evaluation over vertex counts around the largest fixed-size
+  // specialization, reporting time per point per vertex; also validates partition of unity and
+  // linear precision of both methods inside regular polygons, and fails the run otherwise.
+  // Up to the largest specialization, the selected kernel variant is additionally timed on a
+  // single thread with and without its fixed-size kernels, which must agree on the weights
+  bool run_fixed_size_benchmark(std::span<const eig::Vector2f> points_) {
+    constexpr float coord_err_bound = 1e-5f;
+    const auto &kernels = kernel_table();
+    
+    fmt::print("Fixed-size kernels up to n = {}, interior points of regular polygons; {} kernels single-threaded\n", 
+      kernel_max_fixed_size, kernels.name);
+    fmt::print("  {:>4} {:>12} {:>12} {:>12} {:>12} {:>12} {:>12} {:>12} {:>12} {:>12}\n", "n", "mvc (ns)", "mvc fast", "wp (ns)", 
+      "mvc fixed", "mvc generic", "wp fixed", "wp generic", "mvc error", "wp error");
+
+    bool is_valid = true;
+    for (uint n = 3; n <= kernel_max_fixed_size + 4; ++n) {
+      auto verts = generate_regular_polygon(n);
+      std::vector<eig::Vector2f> points;
+      std::ranges::copy_if(points_, std::back_inserter(points), 
+        [&](const auto &p) { return is_inside_polygon(verts, p); });
+      std::vector<float> weights(points.size() * n);
+      
+      // Max. deviation from partition of unity and linear precision
+      auto coord_error = [&]() {
+        float err = 0.f;
+        for (uint i = 0; i < points.size(); ++i) {
+          auto weights_i = std::span(weights).subspan(i * n, n);
+          float         sum = 0.f;
+          eig::Vector2f p   = eig::Vector2f::Zero();
+          for (uint j = 0; j < n; ++j) {
+            sum += weights_i[j];
+            p   += weights_i[j] * verts[j];
+          }
+          err = std::max({ err, std::abs(sum - 1.f), (p - points[i]).norm() });
+        }
+        return err;
+      };
+
+      double rcp_count = 1e6 / static_cast<double>(points.size() * n);
+      double time_fast = time_median([&] { eval_mvc(verts, points, weights, MvcPrecision::eFast); });
+      double time_wp   = time_median([&] { eval_wachspress(verts, points, weights); });
+      float  err_wp    = coord_error();
+      double time_mvc  = time_median([&] { eval_mvc(verts, points, weights); });
+      float  err_mvc   = coord_error();
+      is_valid &= err_mvc <= coord_err_bound && err_wp <= coord_err_bound;
+
+      // Fixed-size against generic kernels at the same n; both take the same scalar fallbacks
+      std::array<double, 4> time_kernel;
+      if (n <= kernel_max_fixed_size) {
+        std::vector<float> weights_generic(weights.size());
+        uint i = 0;
+        for (auto method : { CoordMethod::eMeanValue, CoordMethod::eWachspress }) {
+          time_kernel[i++] = time_median([&] { 
+            eval_kernel_weights(kernels, method, verts, points, weights, MvcPrecision::eExact); });
+          time_kernel[i++] = time_median([&] { 
+            eval_kernel_weights(kernels, method, verts, points, weights_generic, MvcPrecision::eExact, true); });
+          is_valid &= std::ranges::equal(weights, weights_generic, 
+            [&](float a, float b) { return std::abs(a - b) <= coord_err_bound; });
+        }
+        fmt::print("  {:>4} {:>12.3f} {:>12.3f} {:>12.3f} {:>12.3f} {:>12.3f} {:>12.3f} {:>12.3f} {:>12.2e} {:>12.2e}\n", 
+          n, time_mvc * rcp_count, time_fast * rcp_count, time_wp * rcp_count, 
+          time_kernel[0] * rcp_count, time_kernel[1] * rcp_count, time_kernel[2] * rcp_count, time_kernel[3] * rcp_count,
+          err_mvc, err_wp);
+      } else {
+        fmt::print("  {:>4} {:>12.3f} {:>12.3f} {:>12.3f} {:>12} {:>12} {:>12} {:>12} {:>12.2e} {:>12.2e}\n", 
+          n, time_mvc * rcp_count, time_fast * rcp_count, time_wp * rcp_count, "", "", "", "", err_mvc, err_wp);
+      }
+    }
+    
+    if (!is_valid)
+      fmt::print(stderr, "Coordinate error, or fixed-size and generic kernel difference, exceeds bound of {:.0e}\n", coord_err_bound);
+    return is_valid;
+  }
+
+  // Distance from a point to a polygon's boundary, used to exclude points on which
+  // inside tests may legitimately disagree due to rounding
+  float boundary_distance(std::span<const eig::Vector2f> verts, eig::Vector2f p) {
+    float dist = std::numeric_limits<float>::max();
+    for (uint i = 0; i < verts.size(); ++i) {
+      eig::Vector2f a = verts[i], ab = verts[(i + 1) % verts.size()] - a;
+      float t = std::clamp((p - a).dot(ab) / std::max(ab.squaredNorm(), 1e-20f), 0.f, 1.f);
+      dist = std::min(dist, (a + t * ab - p).norm());
+    }
+    return dist;
+  }
+
+  // Run every kernel variant supported by this cpu single-threaded, and validate each against
+  // the scalar reference implementations; fails the run if any variant disagrees. Weight 
+  // errors are compared inside the polygon, and inside tests away from its boundary. Points
+  // within 1e-6 of the mvc polygon's edges are added, on which kernels and scalar boundary
+  // tests may disagree; the batched eval_mvc must still produce normalized weights there
+  bool run_isa_benchmark(std::span<const eig::Vector2f> grid) {
+    constexpr float weight_err_bound   = 1e-5f;
+    constexpr float boundary_tolerance = 1e-5f;
+    constexpr float edge_offset        = 1e-6f;
+    
+    // Reference data; polygons are star-shaped (mvc), convex (wachspress, interior points
+    // only as others fall back to mvc) and random (inside tests)
+    auto verts_mvc = generate_star_polygon(16), verts_wp = generate_regular_polygon(16);
+    auto verts_in  = generate_random_polygon(64);
+
+    // Grid points, followed by points on and to either side of the mvc polygon's edges, at
+    // offsets up to 1e-6 which straddle the boundary tolerance
+    std::vector<eig::Vector2f> points_edge;
+    for (uint i = 0; i < verts_mvc.size(); ++i) {
+      eig::Vector2f a = verts_mvc[i], ab = verts_mvc[(i + 1) % verts_mvc.size()] - a;
+      eig::Vector2f normal = eig::Vector2f(ab.y(), -ab.x()).normalized();
+      for (uint k = 1; k < 32; ++k)
+        for (int j = -16; j <= 16; ++j)
+          points_edge.push_back(a + (k / 32.f) * ab + (j / 16.f) * edge_offset * normal);
+    }
+    std::vector<eig::Vector2f> points_(grid.begin(), grid.end());
+    points_.insert(points_.end(), range_iter(points_edge));
+    std::span<const eig::Vector2f> points = points_;
+    
+    fmt::print("Kernel variants, single-threaded, {} points, selected variant is \"{}\"\n", 
+      points.size(), kernel_table().name);
+    fmt::print("  {:<10} {:>12} {:>12} {:>12} {:>12} {:>12}\n", 
+      "variant", "mvc (ms)", "mvc fast", "wp (ms)", "polygon (ms)", "tri. (ms)");
+
+    std::vector<eig::Vector2f> points_wp;
+    std::ranges::copy_if(points, std::back_inserter(points_wp), 
+      [&](const auto &p) { return is_inside_polygon(verts_wp, p); });
+    std::array<eig::Vector2f, 3> tri = { eig::Vector2f(.1f, .2f), eig::Vector2f(.9f, .35f), eig::Vector2f(.4f, .85f) };
+    std::vector<float> weights_mvc(points.size() * 16), weights_fast(points.size() * 16), weights_wp(points_wp.size() * 16);
+    std::vector<uchar> inside_mvc(points.size()), inside_wp(points_wp.size(), 1), inside_in(points.size()), inside_tri(points.size());
+    for (uint i = 0; i < points.size(); ++i) {
+      auto weights_i = std::span(weights_mvc).subspan(i * 16, 16);
+      eval_mvc(verts_mvc, points[i], weights_i);
+      eval_mvc(verts_mvc, points[i], std::span(weights_fast).subspan(i * 16, 16), MvcPrecision::eFast);
+      inside_mvc[i] = is_inside_polygon(verts_mvc, points[i]);
+      inside_in[i]  = is_inside_polygon(verts_in, points[i]);
+      inside_tri[i] = is_inside_polygon(tri, points[i]);
+    }
+    for (uint i = 0; i < points_wp.size(); ++i)
+      eval_wachspress(verts_wp, points_wp[i], std::span(weights_wp).subspan(i * 16, 16));
+    
+    // Max. abs. weight error inside the polygon, and inside test mismatches away from the boundary
+    auto weight_error = [&](std::span<const float> a, std::span<const float> b, std::span<const uchar> inside) {
+      float err = 0.f;
+      for (uint i = 0; i < inside.size(); ++i) {
+        guard_continue(inside[i]);
+        for (uint j = i * 16; j < (i + 1) * 16; ++j)
+          err = std::max(err, std::abs(a[j] - b[j]));
+      }
+      return err;
+    };
+    auto inside_mismatches = [&](std::span<const eig::Vector2f> verts, std::span<const uchar> a, std::span<const uchar> b) {
+      uint count = 0;
+      for (uint i = 0; i < points.size(); ++i)
+        count += (a[i] != b[i]) && boundary_distance(verts, points[i]) > boundary_tolerance;
+      return count;
+    };
+    
+    bool is_valid = true;
+    for (KernelIsa isa : { KernelIsa::eBaseline, KernelIsa::eAVX2, KernelIsa::eAVX512 }) {
+      guard_continue(is_kernel_supported(isa));
+      const auto &kernels = kernel_table(isa);
+      auto points_f = cast_span<const float>(points);
+
+      std::vector<float> weights(points.size() * 16);
+      std::vector<uchar> inside(points.size());
+      
+      double time_mvc = time_median([&] { 
+        eval_kernel_weights(kernels, CoordMethod::eMeanValue, verts_mvc, points, weights, MvcPrecision::eExact); });
+      float err_mvc = weight_error(weights, weights_mvc, inside_mvc);
+      
+      double time_fast = time_median([&] { 
+        eval_kernel_weights(kernels, CoordMethod::eMeanValue, verts_mvc, points, weights, MvcPrecision::eFast); });
+      float err_fast = weight_error(weights, weights_fast, inside_mvc);
+      
+      double time_wp = time_median([&] { 
+        eval_kernel_weights(kernels, CoordMethod::eWachspress, verts_wp, points_wp, weights, MvcPrecision::eExact); });
+      float err_wp = weight_error(weights, weights_wp, inside_wp);
+
+      double time_in = time_median([&] { 
+        kernels.inside_polygon(cast_span<const float>(std::span(verts_in)).data(), verts_in.size(), 
+          points_f.data(), points.size(), inside.data()); });
+      uint miss_in = inside_mismatches(verts_in, inside, inside_in);
+      
+      std::array<float, 6> tri_f = { tri[0].x(), tri[0].y(), tri[1].x(), tri[1].y(), tri[2].x(), tri[2].y() };
+      double time_tri = time_median([&] { 
+        kernels.inside_triangle(tri_f.data(), points_f.data(), points.size(), inside.data()); });
+      uint miss_tri = inside_mismatches(tri, inside, inside_tri);
+
+      fmt::print("  {:<10} {:>12.2f} {:>12.2f} {:>12.2f} {:>12.2f} {:>12.2f}\n", 
+        kernels.name, time_mvc, time_fast, time_wp, time_in, time_tri);
+      
+      bool is_variant_valid = err_mvc <= weight_err_bound && err_fast <= weight_err_bound 
+                           && err_wp <= weight_err_bound && miss_in == 0 && miss_tri == 0;
+      if (!is_variant_valid)
+        fmt::print(stderr, "  {} disagrees with scalar reference; weight errors {:.2e}, {:.2e}, {:.2e}, inside mismatches {}, {}\n",
+          kernels.name, err_mvc, err_fast, err_wp, miss_in, miss_tri);
+      is_valid &= is_variant_valid;
+    }
+
+    // Batched evaluation through the selected variant must write normalized weights for
+    // every point near the edges, including those its kernel flags but the scalar test does not
+    float edge_err = 0.f;
+    for (auto precision : { MvcPrecision::eExact, MvcPrecision::eFast }) {
+      std::vector<float> weights(points_edge.size() * 16, std::numeric_limits<float>::quiet_NaN());
+      eval_mvc(verts_mvc, points_edge, weights, precision);
+      for (uint i = 0; i < points_edge.size(); ++i) {
+        auto weights_i = std::span(weights).subspan(i * 16, 16);
+        float sum = std::reduce(range_iter(weights_i), 0.f);
+        edge_err = std::max(edge_err, std::isfinite(sum) ? std::abs(sum - 1.f) : 1.f);
+      }
+    }
+    if (edge_err > weight_err_bound) {
+      fmt::print(stderr, "  Batched eval_mvc near polygon edges has partition of unity error {:.2e}\n", edge_err);
+      is_valid = false;
+    }
+    return is_valid;
+  }
+
+  // Compare polygon edits through EditablePolygon against vector-based editing, as pairs of
+  // split-longest-edge and erase-at-random operations, and time the same edits through an
+  // EditSession, which the editor and replay use; fails the run if the flattened result or
+  // the session's buffers differ from the vectors' contents
+  bool run_editing_benchmark() {
+    constexpr uint n_edits = 1000;
+
+    fmt::print("Polygon editing, {} split-longest-edge and erase pairs\n", n_edits);
+    fmt::print("  {:>8} {:>12} {:>12} {:>8} {:>12} {:>12} {:>8}\n",
+      "n", "vector (ms)", "treap (ms)", "speedup", "flatten (ms)", "session (ms)", "equal");
+
+    bool is_equal = true;
+    for (uint n : { 1'000u, 100'000u, 1'000'000u }) {
+      auto verts_ = generate_random_polygon(n);
+      std::vector<eig::AlArray3f> colrs_(n);
+      for (uint i = 0; i < n; ++i)
+        colrs_[i] = eig::AlArray3f(static_cast<float>(i) / n, 0.f, 1.f);
+
+      // Erased indices are drawn up front, s.t. both approaches perform identical edits;
+      // each split adds a vertex before the erase, so index n is valid
+      std::mt19937 rng(n);
+      std::vector<uint> erased(n_edits);
+      for (auto &i : erased)
+        i = std::uniform_int_distribution<uint>(0, n)(rng);
+
+      // Single runs, as edits are destructive
+      auto verts = verts_;
+      auto colrs = colrs_;
+      auto time_start = std::chrono::steady_clock::now();
+      for (uint k = 0; k < n_edits; ++k) {
+        uint  i = 0;
+        float l = -1.f;
+        for (uint j = 0; j < verts.size(); ++j) {
+          float l_ = (verts[(j + 1) % verts.size()] - verts[j]).squaredNorm();
+          guard_continue(l_ > l);
+          l = l_;
+          i = j;
+        }
+        uint j = (i + 1) % verts.size();
+        eig::Vector2f  vert = .5f * (verts[i] + verts[j]);
+        eig::AlArray3f colr = .5f * (colrs[i] + colrs[j]);
+        verts.insert(verts.begin() + i + 1, vert);
+        colrs.insert(colrs.begin() + i + 1, colr);
+        verts.erase(verts.begin() + erased[k]);
+        colrs.erase(colrs.begin() + erased[k]);
+      }
+      double time_vector = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - time_start).count();
+
+      EditablePolygon polygon(verts_, colrs_);
+      time_start = std::chrono::steady_clock::now();
+      for (uint k = 0; k < n_edits; ++k) {
+        polygon.split_longest_edge();
+        polygon.erase(erased[k]);
+      }
+      double time_treap = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - time_start).count();
+
+      std::vector<eig::Vector2f>  verts_flat;
+      std::vector<eig::AlArray3f> colrs_flat;
+      double time_flatten = time_median([&] { polygon.flatten(verts_flat, colrs_flat); });
+
+      EditSession session(verts_, colrs_);
+      time_start = std::chrono::steady_clock::now();
+      for (uint k = 0; k < n_edits; ++k) {
+        session.split_longest_edge();
+        session.erase_vert(erased[k]);
+      }
+      double time_session = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - time_start).count();
+
+      auto colr_eq = [](const auto &a, const auto &b) { return (a == b).all(); };
+      bool is_equal_n = verts_flat == verts && std::ranges::equal(colrs_flat, colrs, colr_eq)
+                     && std::ranges::equal(session.verts(), verts)
+                     && std::ranges::equal(session.colrs(), colrs, colr_eq);
+      is_equal &= is_equal_n;
+
+      fmt::print("  {:>8} {:>12.2f} {:>12.2f} {:>8.1f} {:>12.2f} {:>12.2f} {:>8}\n",
+        n, time_vector, time_treap, time_vector / time_treap, time_flatten, time_session, is_equal_n);
+    }
+    return is_equal;
+  }
+
+  // Triangulate polygons with holes over increasing vertex and hole counts, validating the
+  // triangle count and that triangles cover the outer ring's area minus the holes'; then
+  // validate partition of unity and linear precision of mean value coordinates with holes,
+  // at grid points inside the domain. Fails the run if either check does not pass
+  bool run_holes_benchmark(std::span<const eig::Vector2f> points_) {
+    constexpr float area_err_bound   = 1e-4f;
+    constexpr float weight_err_bound = 1e-4f;
+
+    fmt::print("Triangulation of polygons with holes\n");
+    fmt::print("  {:>8} {:>8} {:>12} {:>12} {:>10} {:>12} {:>8}\n",
+      "n", "holes", "time (ms)", "ns / vert", "triangles", "area error", "valid");
+
+    bool is_valid = true;
+    const std::array<std::pair<uint, uint>, 7> configs = {{
+      { 1'000u, 10u }, { 10'000u, 100u }, { 100'000u, 0u }, { 100'000u, 1'000u },
+      { 1'000'000u, 0u }, { 1'000'000u, 100u }, { 1'000'000u, 10'000u }
+    }};
+    for (auto [n_, n_holes] : configs) {
+      std::vector<uint> hole_offsets;
+      auto verts = generate_holed_polygon(n_, n_holes, hole_offsets);
+      uint n     = verts.size();
+
+      std::vector<eig::Array3u> elems;
+      double time = time_median([&] { elems = triangulate_polygon(verts, hole_offsets); });
+
+      // Expected area is the outer ring's, minus the holes'
+      auto ring_area = [&](uint r) {
+        auto [first, last] = polygon_ring(hole_offsets, n, r);
+        double area = 0.0;
+        for (uint i = first, j = last - 1; i < last; j = i++)
+          area += static_cast<double>(verts[j].x()) * verts[i].y() - static_cast<double>(verts[i].x()) * verts[j].y();
+        return .5 * std::abs(area);
+      };
+      double area_expected = ring_area(0);
+      for (uint r = 1; r <= hole_offsets.size(); ++r)
+        area_expected -= ring_area(r);
+      double area = 0.0;
+      for (const auto &elem : elems) {
+        eig::Vector2d a = verts[elem[0]].cast<double>(), b = verts[elem[1]].cast<double>(), c = verts[elem[2]].cast<double>();
+        area += .5 * std::abs((b - a).x() * (c - a).y() - (b - a).y() * (c - a).x());
+      }
+
+      float area_err   = static_cast<float>(std::abs(area - area_expected) / area_expected);
+      bool  is_valid_n = area_err <= area_err_bound && elems.size() == n + 2 * hole_offsets.size() - 2;
+      is_valid &= is_valid_n;
+
+      fmt::print("  {:>8} {:>8} {:>12.2f} {:>12.1f} {:>10} {:>12.2e} {:>8}\n",
+        n, hole_offsets.size(), time, 1e6 * time / n, elems.size(), area_err, is_valid_n);
+    }
+
+    fmt::print("MVC with holes, {} points\n", points_.size());
+    fmt::print("  {:>8} {:>8} {:>12} {:>12} {:>12}\n", "n", "holes", "time (ms)", "unity err", "linear err");
+    for (auto [n_, n_holes] : { std::pair { 16u, 0u }, std::pair { 64u, 4u }, std::pair { 256u, 16u } }) {
+      std::vector<uint> hole_offsets;
+      auto verts = generate_holed_polygon(n_, n_holes, hole_offsets);
+      uint n     = verts.size();
+
+      // Points inside the outer ring, and outside all holes
+      std::vector<eig::Vector2f> points;
+      for (const auto &p : points_) {
+        bool is_inside = true;
+        for (uint r = 0; r <= hole_offsets.size() && is_inside; ++r) {
+          auto [first, last] = polygon_ring(hole_offsets, n, r);
+          is_inside = is_inside_polygon(std::span(verts).subspan(first, last - first), p) == (r == 0);
+        }
+        if (is_inside)
+          points.push_back(p);
+      }
+
+      std::vector<float> weights(points.size() * n);
+      double time = time_median([&] { eval_mvc(verts, hole_offsets, points, weights); });
+
+      float unity_err = 0.f, linear_err = 0.f;
+      for (uint i = 0; i < points.size(); ++i) {
+        float         sum = 0.f;
+        eig::Vector2f p   = eig::Vector2f::Zero();
+        for (uint j = 0; j < n; ++j) {
+          sum += weights[i * n + j];
+          p   += weights[i * n + j] * verts[j];
+        }
+        unity_err  = std::max(unity_err,  std::abs(sum - 1.f));
+        linear_err = std::max(linear_err, (p - points[i]).norm());
+      }
+      is_valid &= unity_err <= weight_err_bound && linear_err <= weight_err_bound;
+
+      fmt::print("  {:>8} {:>8} {:>12.2f} {:>12.2e} {:>12.2e}\n", 
+        n, hole_offsets.size(), time, unity_err, linear_err);
+    }
+
+    if (!is_valid)
+      fmt::print(stderr, "Triangulation or MVC with holes failed validation\n");
+    return is_valid;
+  }
+
+  // Compare serial and parallel triangulation of large polygons over thread counts; both modes
+  // must cover the same area with the same nr. of triangles
+  bool run_parallel_triangulation_benchmark() {
+    constexpr float area_err_bound = 1e-5f;
+
+    fmt::print("Parallel triangulation, up to {} threads\n", omp_get_max_threads());
+    fmt::print("  {:>10} {:>8} {:>8} {:>12} {:>12} {:>10} {:>12} {:>8}\n",
+      "polygon", "n", "threads", "time (ms)", "speedup", "triangles", "area error", "valid");
+
+    // Unsigned area covered by a triangulation
+    auto elems_area = [](std::span<const eig::Vector2f> verts, std::span<const eig::Array3u> elems) {
+      double area = 0.0;
+      for (const auto &elem : elems) {
+        eig::Vector2d a = verts[elem[0]].cast<double>(), b = verts[elem[1]].cast<double>(), c = verts[elem[2]].cast<double>();
+        area += .5 * std::abs((b - a).x() * (c - a).y() - (b - a).y() * (c - a).x());
+      }
+      return area;
+    };
+
+    bool is_valid    = true;
+    int  threads_max = omp_get_max_threads();
+    const std::array<std::tuple<std::string, uint, uint>, 3> configs = {{
+      { "coastline", 1'000'000u, 0u }, { "holed", 100'000u, 100u }, { "holed", 1'000'000u, 100u }
+    }};
+    for (const auto &[name, n_, n_holes] : configs) {
+      std::vector<uint> hole_offsets;
+      auto verts = name == "coastline" ? generate_coastline_polygon(n_)
+                                       : generate_holed_polygon(n_, n_holes, hole_offsets);
+      uint n     = verts.size();
+
+      std::vector<eig::Array3u> elems;
+      double time_serial = time_median([&] { elems = triangulate_polygon(verts, hole_offsets); });
+      double area_serial = elems_area(verts, elems);
+      uint   size_serial = elems.size();
+      fmt::print("  {:>10} {:>8} {:>8} {:>12.2f} {:>12.2f} {:>10} {:>12.2e} {:>8}\n",
+        name, n, "serial", time_serial, 1.0, size_serial, 0.f, true);
+
+      for (int threads = 1; threads <= threads_max; threads *= 2) {
+        omp_set_num_threads(threads);
+        double time = time_median([&] {
+          elems = triangulate_polygon(verts, hole_offsets, TriangulateMode::eParallel);
+        });
+
+        float area_err   = static_cast<float>(std::abs(elems_area(verts, elems) - area_serial) / area_serial);
+        bool  is_valid_n = area_err <= area_err_bound && elems.size() == size_serial;
+        is_valid &= is_valid_n;
+
+        fmt::print("  {:>10} {:>8} {:>8} {:>12.2f} {:>12.2f} {:>10} {:>12.2e} {:>8}\n",
+          name, n, threads, time, time_serial / time, elems.size(), area_err, is_valid_n);
+      }
+      omp_set_num_threads(threads_max);
+    }
+
+    if (!is_valid)
+      fmt::print(stderr, "Parallel triangulation failed validation\n");
+    return is_valid;
+  }
+
+  // k x k grid of random star-shaped polygons of n vertices, alternating with holed polygons,
+  // in random colors; neighbouring polygons overlap
+  PolygonCollection generate_bench_collection(uint k, uint n) {
+    std::mt19937 rng(k);
+    std::uniform_real_distribution<float> distr(0.f, 1.f);
+
+    PolygonCollection collection;
+    for (uint i = 0; i < k * k; ++i) {
+      std::vector<uint> hole_offsets;
+      auto verts = i % 2 ? generate_random_polygon(n, i)
+                         : generate_holed_polygon(n, 2, hole_offsets, i);
+      eig::Vector2f offset = eig::Vector2f(i % k, i / k) / static_cast<float>(k);
+      for (auto &v : verts)
+        v = (v * 1.25f / static_cast<float>(k) + offset).eval();
+      std::vector<eig::AlArray3f> colrs(verts.size());
+      for (auto &c : colrs)
+        c = { distr(rng), distr(rng), distr(rng) };
+      collection.add(verts, colrs, hole_offsets);
+    }
+    return collection;
+  }
+
+  // Point-to-polygon lookup with MVC interpolation over polygon collections of increasing size;
+  // polygons are placed on a grid with overlapping neighbours, and a subset of lookups is
+  // validated against a linear scan over all polygons
+  bool run_collection_benchmark() {
+    constexpr uint n_points = 1u << 18;
+    constexpr uint n_verts  = 32;
+
+    fmt::print("Polygon collection lookup, {} points, {} vertices per polygon\n", n_points, n_verts);
+    fmt::print("  {:>8} {:>12} {:>12} {:>12} {:>10} {:>8}\n",
+      "polygons", "build (ms)", "find (ms)", "query (ms)", "hits", "valid");
+
+    std::mt19937 rng(0);
+    std::uniform_real_distribution<float> distr(0.f, 1.f);
+    std::vector<eig::Vector2f> points(n_points);
+    for (auto &p : points)
+      p = { distr(rng), distr(rng) };
+
+    bool is_valid = true;
+    for (uint k : { 4u, 16u, 64u, 256u }) {
+      auto collection = generate_bench_collection(k, n_verts);
+      double time_build = time_median([&] { collection.build(); });
+
+      std::vector<uint>           ids(n_points);
+      std::vector<eig::AlArray3f> colrs(n_points);
+      double time_find  = time_median([&] {
+        #pragma omp parallel for schedule(static)
+        for (int i = 0; i < static_cast<int>(n_points); ++i)
+          ids[i] = collection.find(points[i]);
+      });
+      double time_query = time_median([&] { collection.query(points, ids, colrs); });
+
+      // Linear scan over polygons for a subset of points
+      bool is_valid_k = true;
+      for (uint i = 0; i < n_points; i += 61) {
+        uint id = polygon_none;
+        for (uint j = 0; j < collection.size() && id == polygon_none; ++j) {
+          auto verts = collection.verts(j);
+          auto holes = collection.hole_offsets(j);
+          bool is_inside = false;
+          for (uint r = 0; r <= holes.size(); ++r) {
+            auto [first, last] = polygon_ring(holes, verts.size(), r);
+            is_inside ^= is_inside_polygon(verts.subspan(first, last - first), points[i]);
+          }
+          if (is_inside)
+            id = j;
+        }
+        is_valid_k &= id == ids[i];
+      }
+      is_valid &= is_valid_k;
+
+      uint hits = std::ranges::count_if(ids, [](uint id) { return id != polygon_none; });
+      fmt::print("  {:>8} {:>12.3f} {:>12.2f} {:>12.2f} {:>10} {:>8}\n",
+        collection.size(), time_build, time_find, time_query, hits, is_valid_k);
+    }
+
+    if (!is_valid)
+      fmt::print(stderr, "Polygon collection lookup failed validation\n");
+    return is_valid;
+  }
+
+  // Adaptive flattening of polygons with cubic edges against a fixed, dense tessellation; the
+  // flattened output feeds triangulation and MVC evaluation, whose cost scales with its size.
+  // Adaptive flattening must stay within tolerance, and moving a vertex must re-flatten only
+  // its two adjacent edges
+  bool run_curved_benchmark(std::span<const eig::Vector2f> points_) {
+    constexpr uint  fixed_segments = 64;
+    constexpr float tolerance      = 1.f / 1024.f;
+
+    fmt::print("Curved polygon flattening, tolerance {:.2e}\n", tolerance);
+    fmt::print("  {:>8} {:>10} {:>8} {:>12} {:>12} {:>12} {:>12} {:>10} {:>8}\n",
+      "n", "flatten", "verts", "update (ms)", "tri. (ms)", "mvc (ms)", "edit (ms)", "deviation", "valid");
+
+    // Subset of points, as MVC cost grows with the flattened size
+    std::vector<eig::Vector2f> points;
+    for (uint i = 0; i < points_.size(); i += 64)
+      points.push_back(points_[i]);
+
+    bool is_valid = true;
+    for (uint n : { 16u, 64u, 256u }) {
+      // Cubic edges bulge outward from a random star-shaped control polygon
+      auto verts = generate_random_polygon(n, n, .25f, .4f);
+      std::vector<eig::AlArray3f> colrs(n);
+      std::vector<CurvedEdge>     edges(n);
+      for (uint i = 0; i < n; ++i) {
+        eig::Vector2f a = verts[i], b = verts[(i + 1) % n], d = b - a;
+        eig::Vector2f normal = eig::Vector2f(d.y(), -d.x()) * .3f;
+        edges[i] = { .type = CurveType::eCubic, .ctrl_a = a + d / 3.f + normal, .ctrl_b = a + 2.f * d / 3.f + normal };
+        colrs[i] = eig::AlArray3f(static_cast<float>(i % 3 == 0), static_cast<float>(i % 3 == 1), static_cast<float>(i % 3 == 2));
+      }
+
+      // Fixed tessellation, for reference
+      std::vector<eig::Vector2f> verts_fixed;
+      for (uint i = 0; i < n; ++i)
+        for (uint j = 0; j < fixed_segments; ++j)
+          verts_fixed.push_back(eval_curve(verts[i], edges[i], verts[(i + 1) % n], static_cast<float>(j) / fixed_segments));
+
+      // Adaptive flattening; deviation is measured at segment midpoints
+      double time_update = time_median([&] { CurvedPolygon(verts, colrs, edges).update(tolerance); });
+      CurvedPolygon polygon(verts, colrs, edges);
+      polygon.update(tolerance);
+      float deviation = 0.f;
+      for (uint i = 0; i < n; ++i) {
+        uint k = polygon.offsets()[i + 1] - polygon.offsets()[i];
+        for (uint j = 0; j < k; ++j) {
+          eig::Vector2f a = eval_curve(verts[i], edges[i], verts[(i + 1) % n], static_cast<float>(j) / k);
+          eig::Vector2f b = eval_curve(verts[i], edges[i], verts[(i + 1) % n], static_cast<float>(j + 1) / k);
+          eig::Vector2f m = eval_curve(verts[i], edges[i], verts[(i + 1) % n], (j + .5f) / k);
+          deviation = std::max(deviation, (m - .5f * (a + b)).norm());
+        }
+      }
+
+      // Moving a vertex re-flattens its adjacent edges only
+      double time_edit = time_median([&] { polygon.set_vert(n / 2, verts[n / 2]); polygon.update(tolerance); });
+      bool is_valid_n = deviation <= tolerance && polygon.flattened() == 2;
+      is_valid &= is_valid_n;
+
+      for (auto [name, flat] : { std::pair { "fixed", std::span<const eig::Vector2f>(verts_fixed) },
+                                 std::pair { "adaptive", polygon.flat_verts() } }) {
+        std::vector<float> weights(points.size() * flat.size());
+        double time_tri = time_median([&] { triangulate_polygon(flat); });
+        double time_mvc = time_median([&] { eval_mvc(flat, points, weights); });
+        bool   is_fixed = std::string_view(name) == "fixed";
+        fmt::print("  {:>8} {:>10} {:>8} {:>12} {:>12.3f} {:>12.2f} {:>12} {:>10} {:>8}\n",
+          n, name, flat.size(), is_fixed ? "" : fmt::format("{:.4f}", time_update), time_tri, time_mvc,
+          is_fixed ? "" : fmt::format("{:.4f}", time_edit), is_fixed ? "" : fmt::format("{:.2e}", deviation),
+          is_fixed ? "" : fmt::format("{}", is_valid_n));
+      }
+    }
+
+    if (!is_valid)
+      fmt::print(stderr, "Curved polygon flattening failed validation\n");
+    return is_valid;
+  }
+
+  // Packing of polygon collections into draw batches for multi-draw indirect rendering; each
+  // command must cover its polygon's triangulation, i.e. n - 2 + 2h triangles for n vertices
+  // and h holes, spanning the polygon's area, and ring signs must orient holes opposite to
+  // the outer ring
+  bool run_batch_benchmark() {
+    constexpr uint n_verts = 32;
+
+    fmt::print("Draw batch packing, {} vertices per polygon\n", n_verts);
+    fmt::print("  {:>8} {:>10} {:>10} {:>12} {:>8}\n", "polygons", "verts", "triangles", "pack (ms)", "valid");
+
+    auto signed_area = [](std::span<const eig::Vector2f> ring) {
+      float area = 0.f;
+      for (uint i = 0, j = ring.size() - 1; i < ring.size(); j = i++)
+        area += .5f * (ring[j].x() * ring[i].y() - ring[j].y() * ring[i].x());
+      return area;
+    };
+
+    bool is_valid = true;
+    for (uint k : { 16u, 64u, 256u }) {
+      auto collection = generate_bench_collection(k, n_verts);
+
+      DrawBatch batch;
+      double time_pack = time_median([&] { batch = pack_draw_batch(collection); });
+
+      bool is_valid_k = batch.commands.size() == collection.size()
+                     && batch.polygons.size() == collection.size()
+                     && batch.verts.size() == batch.colrs.size();
+      uint first = 0, first_index = 0;
+      for (uint i = 0; i < collection.size() && is_valid_k; ++i) {
+        auto verts = collection.verts(i);
+        auto holes = collection.hole_offsets(i);
+        const auto &command = batch.commands[i];
+        const auto &polygon = batch.polygons[i];
+
+        // Command ranges are contiguous, and vertices match the collection's
+        uint n_tris = verts.size() - 2 + 2 * holes.size();
+        is_valid_k &= command.count == 3 * n_tris && command.instance_count == 1
+                   && command.first_index == first_index && command.base_vertex == static_cast<int>(first)
+                   && command.base_instance == i;
+        is_valid_k &= std::ranges::equal(verts, std::span(batch.verts).subspan(first, verts.size()));
+
+        // Triangles index the polygon's own vertices and cover its area
+        float area = 0.f;
+        for (uint t = command.first_index / 3; t < (command.first_index + command.count) / 3; ++t) {
+          const auto &el = batch.elems[t];
+          is_valid_k &= (el < verts.size()).all();
+          guard_continue((el < verts.size()).all());
+          area += signed_area(std::array { verts[el[0]], verts[el[1]], verts[el[2]] });
+        }
+
+        // Signed ring areas, where signs orient holes opposite to the outer ring
+        float area_rings = 0.f;
+        is_valid_k &= polygon.rings_size == holes.size() + 1;
+        for (uint r = 0; r < polygon.rings_size && is_valid_k; ++r) {
+          const auto &ring = batch.rings[polygon.rings_first + r];
+          auto [ring_first, ring_last] = polygon_ring(holes, verts.size(), r);
+          is_valid_k &= ring.first == first + ring_first && ring.size == ring_last - ring_first;
+          float ring_area = ring.sign * signed_area(verts.subspan(ring_first, ring.size));
+          is_valid_k &= r == 0 ? ring_area > 0.f : ring_area < 0.f;
+          area_rings += ring_area;
+        }
+        is_valid_k &= std::abs(std::abs(area) - area_rings) <= 1e-4f * area_rings;
+
+        first       += verts.size();
+        first_index += command.count;
+      }
+      is_valid_k &= first == batch.verts.size() && first_index == 3 * batch.elems.size();
+      is_valid   &= is_valid_k;
+
+      fmt::print("  {:>8} {:>10} {:>10} {:>12.2f} {:>8}\n",
+        collection.size(), batch.verts.size(), batch.elems.size(), time_pack, is_valid_k);
+    }
+
+    if (!is_valid)
+      fmt::print(stderr, "Draw batch packing failed validation\n");
+    return is_valid;
+  }
+
+  // Export a polygon's weights to a weight field file and reload it; interpolated colors must
+  // match direct evaluation inside the polygon up to quantization, with k equal to the nr. of
+  // vertices s.t. no weights are dropped. Out-of-range samples and damaged files must raise,
+  // and with fewer retained weights, renormalization must keep weights bounded
+  bool run_weight_field_benchmark() {
+    constexpr uint  n_verts        = 16;
+    constexpr uint  field_size     = 256;
+    constexpr float colr_err_bound = 5e-4f;
+    
+    fmt::print("Weight field round trip, {} vertices, {}^2 samples\n", n_verts, field_size);
+    fmt::print("  {:>12} {:>12} {:>12} {:>12} {:>10} {:>8} {:>8}\n", 
+      "export (ms)", "size (kb)", "load (ms)", "eval (ms)", "error", "raises", "bounded");
+
+    auto verts = generate_star_polygon(n_verts);
+    std::vector<eig::AlArray3f> colrs(n_verts);
+    for (uint i = 0; i < n_verts; ++i)
+      colrs[i] = eig::AlArray3f(static_cast<float>(i % 3 == 0), static_cast<float>(i % 3 == 1), static_cast<float>(i) / n_verts);
+    
+    auto path = std::filesystem::temp_directory_path() / "mvc_benchmark_field.bin";
+    WeightFieldInfo info = { .path = path, .size = { field_size, field_size }, .chunk_size = { 32, 32 }, 
+                             .k = n_verts, .verts = verts };
+    double time_export = time_median([&] { export_weight_field(info); });
+    double time_load   = time_median([&] { WeightField field(path); field.chunk_at({ 0, 0 }); });
+
+    // Reference colors through direct evaluation, on the field's sample positions
+    std::vector<eig::Vector2f> points(field_size * field_size);
+    for (uint y = 0; y < field_size; ++y)
+      for (uint x = 0; x < field_size; ++x)
+        points[y * field_size + x] = { (x + .5f) / field_size, 1.f - (y + .5f) / field_size };
+    std::vector<float> weights(points.size() * n_verts);
+    eval_mvc(verts, points, weights);
+
+    WeightField field(path);
+    std::vector<eig::Array3f> out(points.size());
+    double time_eval = time_median([&] { field.eval_colr({ 0, 0 }, field.size(), colrs, out); });
+    float colr_err = 0.f;
+    for (uint i = 0; i < points.size(); ++i) {
+      guard_continue(is_inside_polygon(verts, points[i]));
+      eig::Array3f colr = 0.f;
+      for (uint j = 0; j < n_verts; ++j)
+        colr += weights[i * n_verts + j] * colrs[j];
+      colr_err = std::max(colr_err, (colr - out[i]).abs().maxCoeff());
+    }
+
+    // Out-of-range samples, a truncated file and damaged chunk data must each raise
+    auto raises = [](auto f) { try { f(); return false; } catch (const std::exception &) { return true; } };
+    uint n_raised = raises([&] { field.chunk_at({ field_size, 0 }); });
+    auto bytes = std::filesystem::file_size(path);
+    {
+      std::ifstream in(path, std::ios::binary);
+      std::vector<char> data(bytes);
+      in.read(data.data(), data.size());
+      
+      auto path_damaged = std::filesystem::temp_directory_path() / "mvc_benchmark_field_damaged.bin";
+      std::ofstream(path_damaged, std::ios::binary | std::ios::trunc).write(data.data(), data.size() - data.size() / 4);
+      n_raised += raises([&] { WeightField(path_damaged).chunk_at(field.size() - 1); });
+      
+      // Flip the bytes of the first chunk's compressed stream, following the chunk table
+      size_t first_chunk = sizeof(WeightFieldHeader) + (field_size / 32) * (field_size / 32) * sizeof(WeightFieldEntry);
+      for (size_t i = first_chunk; i < first_chunk + 16; ++i)
+        data[i] = static_cast<char>(~data[i]);
+      std::ofstream(path_damaged, std::ios::binary | std::ios::trunc).write(data.data(), data.size());
+      n_raised += raises([&] { WeightField(path_damaged).chunk_at({ 0, 0 }); });
+      std::filesystem::remove(path_damaged);
+    }
+    std::filesystem::remove(path);
+
+    // Export with fewer retained weights than vertices; outside samples must store no weights,
+    // and renormalization may at most double a retained weight, s.t. no sample widens its
+    // chunk's quantization range past twice the largest weight inside the polygon
+    bool is_bounded = true;
+    {
+      float w_bound = 0.f;
+      for (uint i = 0; i < points.size(); ++i)
+        if (is_inside_polygon(verts, points[i]))
+          for (uint j = 0; j < n_verts; ++j)
+            w_bound = std::max(w_bound, std::abs(weights[i * n_verts + j]));
+      w_bound = 2.f * w_bound + 1e-3f;
+      
+      info.k = n_verts / 4;
+      export_weight_field(info);
+      WeightField field_k(path);
+      for (uint y = 0; y < field_size; ++y) {
+        for (uint x = 0; x < field_size; ++x) {
+          auto chunk     = field_k.chunk_at({ x, y });
+          auto weights_k = chunk->sample_weights(eig::Array2u(x, y) - chunk->origin);
+          if (!is_inside_polygon(verts, points[y * field_size + x]))
+            is_bounded &= weights_k.empty();
+          for (float w : weights_k)
+            is_bounded &= std::abs(w) <= w_bound;
+        }
+      }
+      std::filesystem::remove(path);
+    }
+    
+    bool is_valid = colr_err <= colr_err_bound && n_raised == 3 && is_bounded;
+    fmt::print("  {:>12.2f} {:>12} {:>12.3f} {:>12.2f} {:>10.2e} {:>8} {:>8}\n", 
+      time_export, bytes / 1024, time_load, time_eval, colr_err, fmt::format("{}/3", n_raised), is_bounded);
+    
+    if (!is_valid)
+      fmt::print(stderr, "Weight field round trip failed validation\n");
+    return is_valid;
+  }
+
+  // Render a polygon to a tiled file with cropped edge tiles, and compare every tile against
+  // direct evaluation up to one quantization step. The file is then truncated and partly
+  // corrupted, and the render resumed; intact tiles must be skipped, and the result must match again
+  bool run_tiled_render_benchmark() {
+    constexpr uint n_verts   = 12;
+    constexpr uint tile_size = 64;
+    constexpr int  lsb_bound = 1;
+    const eig::Array2u size  = { 300, 200 };
+    
+    fmt::print("Tiled render and resume, {} vertices, {}x{} pixels, {}^2 tiles\n", 
+      n_verts, size.x(), size.y(), tile_size);
+    fmt::print("  {:>12} {:>12} {:>12} {:>12} {:>10}\n", 
+      "render (ms)", "resume (ms)", "rendered", "skipped", "max error");
+
+    auto verts = generate_star_polygon(n_verts);
+    std::vector<eig::AlArray3f> colrs(n_verts);
+    for (uint i = 0; i < n_verts; ++i)
+      colrs[i] = eig::AlArray3f(static_cast<float>(i % 3 == 0), static_cast<float>(i % 3 == 1), static_cast<float>(i) / n_verts);
+    
+    // Reference pixels through batched evaluation, at the renderer's pixel centers
+    std::vector<eig::Vector2f> points(size.prod());
+    for (uint y = 0; y < size.y(); ++y)
+      for (uint x = 0; x < size.x(); ++x)
+        points[y * size.x() + x] = { (x + .5f) / size.x(), 1.f - (y + .5f) / size.y() };
+    std::vector<float> weights(points.size() * n_verts);
+    eval_mvc(verts, points, weights);
+    
+    // Compare all tiles in a file against the reference; returns the max. error in quantization steps
+    eig::Array2u n_tiles = (size + tile_size - 1) / tile_size;
+    auto compare_tiles = [&](const std::filesystem::path &path) {
+      int err = 0;
+      for (uint ty = 0; ty < n_tiles.y(); ++ty) {
+        for (uint tx = 0; tx < n_tiles.x(); ++tx) {
+          auto tile = read_mvc_tile(path, { tx, ty });
+          eig::Array2u orig   = eig::Array2u(tx, ty) * tile_size;
+          eig::Array2u extent = (size - orig).min(tile_size);
+          if (tile.size() != extent.prod())
+            return std::numeric_limits<int>::max();
+          for (uint y = 0; y < extent.y(); ++y) {
+            for (uint x = 0; x < extent.x(); ++x) {
+              uint i = (orig.y() + y) * size.x() + orig.x() + x;
+              eig::Array4i px = tile[y * extent.x() + x].cast<int>();
+              if (!is_inside_polygon(verts, points[i])) {
+                err = std::max(err, px.abs().maxCoeff());
+                continue;
+              }
+              eig::Array3f colr = 0.f;
+              for (uint j = 0; j < n_verts; ++j)
+                colr += weights[i * n_verts + j] * colrs[j];
+              eig::Array3i ref = (colr.cwiseMax(0.f).cwiseMin(1.f) * 255.f + .5f).cast<int>();
+              err = std::max({ err, (px.head<3>() - ref).abs().maxCoeff(), std::abs(px[3] - 255) });
+            }
+          }
+        }
+      }
+      return err;
+    };
+
+    auto path = std::filesystem::temp_directory_path() / "mvc_benchmark_tiled.bin";
+    TiledRenderInfo info = { .path = path, .size = size, .tile_size = { tile_size, tile_size }, 
+                             .resume = false, .verts = verts, .colrs = colrs };
+    double time_render = time_median([&] { render_mvc_tiled(info); });
+    int err = compare_tiles(path);
+    
+    // Truncate the file halfway through its tile data, and corrupt the first stored tile
+    // s.t. its entry survives but fails its crc; both must be re-rendered on resume
+    {
+      auto bytes = std::filesystem::file_size(path);
+      std::filesystem::resize_file(path, bytes - bytes / 2);
+      std::fstream file(path, std::ios::binary | std::ios::in | std::ios::out);
+      file.seekp(sizeof(TiledImageHeader) + n_tiles.prod() * sizeof(TiledImageEntry));
+      file.put('\xff').put('\x00');
+    }
+    info.resume = true;
+    auto time_start  = std::chrono::steady_clock::now();
+    auto result      = render_mvc_tiled(info);
+    double time_resume = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - time_start).count();
+    err = std::max(err, compare_tiles(path));
+    std::filesystem::remove(path);
+
+    bool is_valid = err <= lsb_bound 
+                 && result.tiles_skipped > 0 && result.tiles_rendered > 0
+                 && result.tiles_skipped + result.tiles_rendered == result.tiles_total;
+    fmt::print("  {:>12.2f} {:>12.2f} {:>12} {:>12} {:>10}\n", 
+      time_render, time_resume, result.tiles_rendered, result.tiles_skipped, err);
+    
+    if (!is_valid)
+      fmt::print(stderr, "Tiled render failed validation\n");
+    return is_valid;
+  }
+
+  // Cage-based deformation through precomputed sparse weights; the cage encloses the image.
+  // Sparse rows must be clearly shorter than the cage and keep partition of unity, also where
+  // all weights fall below epsilon. The rest-pose cage must return the input points and image
+  // unchanged, and a translated cage the translated points. Weight building and deformation
+  // are timed up to multi-megapixel images
+  bool run_deform_benchmark() {
+    constexpr uint  n_verts     = 32;
+    constexpr float unity_bound = 1e-5f;
+    constexpr float point_bound = 1e-5f;
+    
+    auto verts  = generate_random_polygon(n_verts, 0, .38f, .45f);
+    auto bounds = eig::AlignedBox2f(eig::Vector2f(.27f, .27f), eig::Vector2f(.73f, .73f));
+
+    // Sparse weights over a grid inside the cage, also at a coarse k; an epsilon above all 
+    // weights leaves rows to fall back to dense weights
+    std::vector<eig::Vector2f> points;
+    for (const auto &p : generate_grid_points(256))
+      points.push_back(bounds.min() + p.cwiseProduct(bounds.sizes()));
+    auto unity_error = [](const SparseWeights &w) {
+      float err = 0.f;
+      for (uint i = 0; i < w.n_points(); ++i)
+        err = std::max(err, std::abs(std::reduce(w.weights.begin() + w.offsets[i], w.weights.begin() + w.offsets[i + 1], 0.f) - 1.f));
+      return err;
+    };
+    auto weights        = build_sparse_weights(verts, points);
+    auto weights_coarse = build_sparse_weights(verts, points, 8);
+    auto weights_dense  = build_sparse_weights(verts, points, n_verts, 2.f);
+    float err_unity = std::max({ unity_error(weights), unity_error(weights_coarse), unity_error(weights_dense) });
+    
+    std::vector<eig::Vector2f> points_rest(points.size());
+    deform_points(weights, verts, points_rest);
+    float err_points = 0.f;
+    for (uint i = 0; i < points.size(); ++i)
+      err_points = std::max(err_points, (points_rest[i] - points[i]).cwiseAbs().maxCoeff());
+    
+    // Translated cages translate points, as retained weights keep partition of unity
+    std::vector<eig::Vector2f> verts_moved(range_iter(verts));
+    for (auto &v : verts_moved)
+      v += eig::Vector2f(.1f, -.05f);
+    deform_points(weights, verts_moved, points_rest);
+    for (uint i = 0; i < points.size(); ++i)
+      err_points = std::max(err_points, (points_rest[i] - points[i] - eig::Vector2f(.1f, -.05f)).cwiseAbs().maxCoeff());
+    
+    // Rows must be clearly sparser than the cage
+    float row_size = static_cast<float>(weights.weights.size()) / points.size();
+    bool is_valid = err_unity <= unity_bound && err_points <= point_bound && row_size <= .6f * n_verts
+                 && weights_dense.weights.size() == points.size() * n_verts;
+    fmt::print("Cage deformation, {} vertices, {:.1f} weights per point ({:.1f} coarse), unity error {:.2e}, rest/translated point error {:.2e}\n", 
+      n_verts, row_size, static_cast<float>(weights_coarse.weights.size()) / points.size(), err_unity, err_points);
+    fmt::print("  {:>12} {:>12} {:>12} {:>12} {:>10} {:>8}\n", 
+      "image", "weights (ms)", "rest (ms)", "posed (ms)", "max diff", "valid");
+
+    // Images deformed by the rest-pose cage, and by a cage with its vertices pulled inward
+    std::vector<eig::Vector2f> verts_posed(range_iter(verts));
+    for (uint i = 0; i < n_verts; i += 2)
+      verts_posed[i] = (eig::Vector2f(.5f, .5f) + .9f * (verts[i] - eig::Vector2f(.5f, .5f))).eval();
+    for (uint size : { 512u, 2048u }) {
+      std::vector<eig::Array4<uchar>> src(size * size), dst(size * size);
+      for (uint y = 0; y < size; ++y)
+        for (uint x = 0; x < size; ++x)
+          src[y * size + x] = eig::Array4<uchar>(x * 255 / size, y * 255 / size, (x ^ y) & 255, 255);
+      
+      ImageDeformerInfo info = { .size = { size, size }, .bounds = bounds };
+      double time_weights = time_median([&] { ImageDeformer(verts, info); });
+      ImageDeformer deformer(verts, info);
+      double time_posed = time_median([&] { deformer.deform(verts_posed, src, dst); });
+      double time_rest  = time_median([&] { deformer.deform(verts, src, dst); });
+
+      // Rest-pose deformation resamples each pixel at its own center
+      int diff = 0;
+      for (uint i = 0; i < src.size(); ++i)
+        diff = std::max(diff, (src[i].cast<int>() - dst[i].cast<int>()).abs().maxCoeff());
+      bool is_valid_size = diff <= 1;
+      is_valid &= is_valid_size;
+      
+      fmt::print("  {:>12} {:>12.2f} {:>12.2f} {:>12.2f} {:>10} {:>8}\n", 
+        fmt::format("{}x{}", size, size), time_weights, time_rest, time_posed, diff, is_valid_size);
+    }
+
+    if (!is_valid)
+      fmt::print(stderr, "Cage deformation failed validation\n");
+    return is_valid;
+  }
+
+  // Batched ViewTransform conversions against the per-point world_to_window_space(...), for
+  // the editor's orthographic camera, and a panned and zoomed one; batched window-space
+  // positions must match within a fraction of a pixel, and window -> world must invert them
+  bool run_view_transform_benchmark() {
+    constexpr uint  n_points     = 1u << 20;
+    constexpr float window_bound = 1e-3f; // In pixels
+    constexpr float world_bound  = 1e-5f;
+    
+    fmt::print("View transforms, {} points on the z = 0 plane\n", n_points);
+    fmt::print("  {:<10} {:>14} {:>14} {:>12} {:>12} {:>8}\n", 
+      "camera", "per-point (ms)", "batched (ms)", "window err", "world err", "valid");
+    
+    std::mt19937 rng(n_points);
+    std::uniform_real_distribution<float> distr(0.f, 1.f);
+    std::vector<eig::Vector2f> points(n_points), window(n_points), world(n_points), window_ref(n_points);
+    for (auto &p : points)
+      p = { distr(rng), distr(rng) };
+
+    // Window of 1600x900 pixels at an offset; world [0, 1]^2 maps to the view's [-1, 1]^2
+    eig::Vector2f offs = { 10.f, 20.f }, size = { 1600.f, 900.f };
+    float aspect = size.x() / size.y();
+    auto  to_view = eig::Affine3f(eig::Translation3f(-1.f, -1.f, 0.f) * eig::Scaling(2.f));
+    std::array<std::pair<std::string_view, eig::Projective3f>, 2> cameras = {{
+      { "editor", eig::ortho(-aspect, aspect, -1.f, 1.f, -1.f, 1.f) * to_view },
+      { "zoomed", eig::ortho(-.3f * aspect, .2f * aspect, -.4f, .1f, -1.f, 1.f) * to_view }
+    }};
+
+    bool is_valid = true;
+    for (const auto &[name, trf] : cameras) {
+      eig::ViewTransform view(trf, offs, size);
+      double time_point = time_median([&] {
+        for (uint i = 0; i < n_points; ++i)
+          window_ref[i] = eig::world_to_window_space((eig::Vector3f() << points[i], 0.f).finished(), trf, offs, size); });
+      double time_batch = time_median([&] { view.world_to_window(points, window); });
+      view.window_to_world(window, world);
+
+      float err_window = 0.f, err_world = 0.f;
+      for (uint i = 0; i < n_points; ++i) {
+        err_window = std::max(err_window, (window[i] - window_ref[i]).norm());
+        err_world  = std::max(err_world,  (world[i]  - points[i]).norm());
+      }
+      bool is_valid_camera = err_window <= window_bound && err_world <= world_bound;
+      is_valid &= is_valid_camera;
+      
+      fmt::print("  {:<10} {:>14.2f} {:>14.2f} {:>12.2e} {:>12.2e} {:>8}\n", 
+        name, time_point, time_batch, err_window, err_world, is_valid_camera);
+    }
+
+    // Empty spans are valid input, and must not touch their null data pointers
+    eig::ViewTransform view(cameras[0].second, offs, size);
+    view.world_to_window({}, {});
+    view.window_to_world(std::span<const eig::Vector2f>(), std::span<eig::Vector2f>());
+
+    if (!is_valid)
+      fmt::print(stderr, "View transforms failed validation\n");
+    return is_valid;
+  }
+
+  // Nearest-point queries on a PointGrid over random window-space points against a brute
+  // force search, at the editor's picking radius and a wider one; duplicated points test that
+  // ties resolve towards the lower index, a far outlier that cell sizes stay bounded, and
+  // non-finite or float-range points that the build terminates and skips what it cannot place
+  bool run_point_grid_benchmark() {
+    constexpr uint  n_points  = 100'000;
+    constexpr uint  n_queries = 20'000;
+    constexpr float cell_size = 8.f;
+
+    fmt::print("Point grid, {} window-space points, {} queries\n", n_points, n_queries);
+    fmt::print("  {:>8} {:>12} {:>12} {:>14} {:>10} {:>10}\n", 
+      "radius", "build (ms)", "query (us)", "brute (us)", "found", "mismatch");
+
+    std::mt19937 rng(n_points);
+    std::uniform_real_distribution<float> distr_x(0.f, 1600.f), distr_y(0.f, 900.f);
+    std::vector<eig::Vector2f> points(n_points), queries(n_queries);
+    for (auto &p : points)
+      p = { distr_x(rng), distr_y(rng) };
+    for (uint i = 0; i < 100; ++i)
+      points.push_back(points[i]);
+    for (auto &q : queries)
+      q = { distr_x(rng), distr_y(rng) };
+    for (uint i = 0; i < 100; ++i)
+      queries[i] = points[i];
+
+    PointGrid grid;
+    double time_build = time_median([&] { grid = PointGrid(points, cell_size); });
+    
+    bool is_valid = true;
+    for (float radius : { 8.f, 30.f }) {
+      std::vector<std::optional<uint>> found(n_queries), found_ref(n_queries);
+      double time_query = time_median([&] { 
+        for (uint i = 0; i < n_queries; ++i) 
+          found[i] = grid.find_nearest(queries[i], radius); });
+      auto time_start = std::chrono::steady_clock::now();
+      for (uint i = 0; i < n_queries; ++i) {
+        float dist_min = radius * radius;
+        for (uint j = 0; j < points.size(); ++j) {
+          float dist = (points[j] - queries[i]).squaredNorm();
+          guard_continue(dist <= dist_min && (!found_ref[i] || dist < dist_min));
+          found_ref[i] = j;
+          dist_min     = dist;
+        }
+      }
+      double time_brute = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - time_start).count();
+      
+      uint n_found      = std::ranges::count_if(found, [](const auto &i) { return i.has_value(); });
+      uint n_mismatches = 0;
+      for (uint i = 0; i < n_queries; ++i)
+        n_mismatches += found[i] != found_ref[i];
+      is_valid &= n_mismatches == 0;
+      
+      fmt::print("  {:>8.0f} {:>12.2f} {:>12.3f} {:>14.1f} {:>10} {:>10}\n", 
+        radius, time_build, time_query * 1e3 / n_queries, time_brute * 1e3 / n_queries, n_found, n_mismatches);
+    }
+
+    // A far outlier must neither blow up the nr. of cells nor hide nearby points
+    PointGrid grid_far(std::vector<eig::Vector2f> { { 0.f, 0.f }, { 1e7f, 1e7f } }, cell_size);
+    is_valid &= grid_far.find_nearest({ 1.f, 1.f }, cell_size) == 0u 
+             && grid_far.find_nearest({ 1e7f, 1e7f }, cell_size) == 1u;
+
+    // Non-finite points and points near the float range's ends are skipped, keeping others'
+    // original indices; points spanning half the float range must still be placed
+    constexpr float inf = std::numeric_limits<float>::infinity();
+    constexpr float nan = std::numeric_limits<float>::quiet_NaN();
+    PointGrid grid_inf(std::vector<eig::Vector2f> { { inf, 0.f }, { 0.f, nan }, { 0.f, 0.f }, { 3e38f, 0.f } }, cell_size);
+    PointGrid grid_max(std::vector<eig::Vector2f> { { -8e37f, -8e37f }, { 8e37f, 8e37f } }, cell_size);
+    is_valid &= grid_inf.size() == 1
+             && grid_inf.find_nearest({ 1.f, 1.f }, cell_size) == 2u
+             && grid_inf.find_nearest({ 3e38f, 0.f }, cell_size) == std::nullopt
+             && grid_max.size() == 2
+             && grid_max.find_nearest({ 8e37f, 8e37f }, cell_size) == 1u
+             && grid_max.find_nearest({ 0.f, 0.f }, cell_size) == std::nullopt;
+
+    if (!is_valid)
+      fmt::print(stderr, "Point grid queries differ from brute force search\n");
+    return is_valid;
+  }
+
+  // Apply a random edit to an edit session; vertex moves and recolors dominate, as during
+  // interactive use, and runs of moves on the same vertex continue drags
+  void apply_random_edit(EditSession &session, std::mt19937 &rng) {
+    auto index = [&] { return std::uniform_int_distribution<uint>(0, session.verts().size() - 1)(rng); };
+    std::uniform_real_distribution<float> distr(-.01f, .01f);
+    switch (std::uniform_int_distribution<uint>(0, 9)(rng)) {
+      case 0: case 1: case 2: case 3: {
+        uint i = index();
+        for (uint j = 0; j < 3; ++j)
+          session.set_vert(i, (session.verts()[i] + eig::Vector2f(distr(rng), distr(rng))).eval());
+        break;
+      }
+      case 4: session.set_colr(index(), eig::AlArray3f(distr(rng) + .5f, distr(rng) + .5f, 1.f)); break;
+      case 5: session.split_longest_edge(); break;
+      case 6: if (session.verts().size() > 3) session.erase_vert(index()); break;
+      case 7: session.set_settings({ .draw_method = static_cast<DrawMethod>(index() % 3) }); break;
+      case 8: session.undo(); break;
+      case 9: session.redo(); break;
+    }
+  }
+
+  // Record random edits over a nr. of frames, save and reload the trace, and replay it as
+  // replay_edits does; the reloaded trace must equal the recording exactly, and replaying
+  // either must reproduce the recorded session's final polygon, settings and triangulation.
+  // Traces with out-of-range draw settings must raise on load
+  bool run_edit_trace_benchmark() {
+    constexpr uint n_verts  = 2'000;
+    constexpr uint n_frames = 600;
+
+    fmt::print("Edit trace round trip, {} vertices, {} frames\n", n_verts, n_frames);
+    fmt::print("  {:>8} {:>12} {:>12} {:>12} {:>10} {:>10}\n", 
+      "events", "save (ms)", "load (ms)", "replay (ms)", "trace eq.", "replay eq.");
+
+    auto verts = generate_random_polygon(n_verts);
+    std::vector<eig::AlArray3f> colrs(n_verts, eig::AlArray3f(1.f, 0.f, 0.f));
+    EditSession session(verts, colrs);
+    session.start_recording({ 1024, 768 });
+    std::mt19937 rng(n_verts);
+    for (uint f = 0; f < n_frames; ++f) {
+      if (f % 2 == 0)
+        apply_random_edit(session, rng);
+      session.next_frame();
+    }
+    auto trace = session.stop_recording();
+    
+    auto path = std::filesystem::temp_directory_path() / "mvc_benchmark_trace.json";
+    EditTrace trace_loaded;
+    double time_save = time_median([&] { save_edit_trace(path, trace); });
+    double time_load = time_median([&] { trace_loaded = load_edit_trace(path); });
+    
+    // Traces with out-of-range draw settings must raise on load
+    uint n_raised = 0;
+    for (uint i = 0; i < 2; ++i) {
+      EditTrace trace_invalid = trace;
+      if (i == 0)
+        trace_invalid.settings.draw_method = static_cast<DrawMethod>(3);
+      else
+        trace_invalid.settings.draw_precision = static_cast<MvcPrecision>(2);
+      save_edit_trace(path, trace_invalid);
+      try { load_edit_trace(path); } catch (const std::exception &) { n_raised++; }
+    }
+    std::filesystem::remove(path);
+    
+    // Reloaded traces match exactly, as floats pass through json without loss
+    auto event_eq = [](const EditEvent &a, const EditEvent &b) {
+      return a.frame == b.frame && a.type == b.type && a.index == b.index && a.vert == b.vert
+          && (a.colr == b.colr).all() && a.settings == b.settings; };
+    bool is_trace_equal = (trace_loaded.window_size == trace.window_size).all() && trace_loaded.frames == trace.frames
+                       && trace_loaded.settings == trace.settings && std::ranges::equal(trace_loaded.verts, trace.verts)
+                       && std::ranges::equal(trace_loaded.colrs, trace.colrs, [](const auto &a, const auto &b) { return (a == b).all(); })
+                       && std::ranges::equal(trace_loaded.events, trace.events, event_eq);
+    
+    // Replay frame by frame, as frames determine which moves continue a drag
+    auto replay = [](const EditTrace &trace) {
+      EditSession session(trace.verts, trace.colrs, trace.settings);
+      auto event = trace.events.begin();
+      for (uint f = 0; f < trace.frames; ++f) {
+        for (; event != trace.events.end() && event->frame == f; ++event)
+          session.apply(*event);
+        session.next_frame();
+      }
+      return session;
+    };
+    EditSession session_replay;
+    double time_replay = time_median([&] { session_replay = replay(trace_loaded); });
+    
+    EditFrame frame, frame_replay;
+    session.update_draw(frame);
+    session_replay.update_draw(frame_replay);
+    bool is_replay_equal = std::ranges::equal(session_replay.verts(), session.verts())
+      && std::ranges::equal(session_replay.colrs(), session.colrs(), [](const auto &a, const auto &b) { return (a == b).all(); })
+      && session_replay.settings() == session.settings()
+      && session_replay.history().current_step() == session.history().current_step()
+      && std::ranges::equal(frame_replay.elems, frame.elems, [](const auto &a, const auto &b) { return (a == b).all(); });
+
+    fmt::print("  {:>8} {:>12.2f} {:>12.2f} {:>12.2f} {:>10} {:>10}\n", 
+      trace.events.size(), time_save, time_load, time_replay, is_trace_equal, is_replay_equal);
+    
+    bool is_valid = is_trace_equal && is_replay_equal && n_raised == 2;
+    if (!is_valid)
+      fmt::print(stderr, "Edit trace round trip failed validation\n");
+    return is_valid;
+  }
+
+  // Build LOD chains of random polygons and extract drag previews of at most the editor's
+  // preview size; levels must shrink with non-decreasing error, previews must retain the pinned
+  // vertex, and resampling must preserve constant colors, and smooth ones up to filtering
+  bool run_lod_benchmark() {
+    constexpr uint  max_verts       = 512;
+    constexpr float const_err_bound = 1e-5f;
+    constexpr float ramp_err_bound  = 2.5e-2f; // 5% of the ramp's amplitude
+    const eig::AlArray3f colr_const = { .2f, .4f, .6f };
+
+    fmt::print("Polygon LOD chains, previews of at most {} vertices\n", max_verts);
+    fmt::print("  {:>8} {:>8} {:>12} {:>14} {:>10} {:>12} {:>8}\n", 
+      "n", "levels", "build (ms)", "extract (ms)", "preview", "const. err", "valid");
+
+    bool is_valid = true;
+    for (uint n : { 1'000u, 100'000u, 1'000'000u }) {
+      auto verts = generate_random_polygon(n);
+      std::vector<eig::AlArray3f> colrs(n, colr_const);
+
+      std::vector<PolygonLodLevel> lod;
+      double time_build = time_median([&] { lod = build_polygon_lod(verts); });
+      const auto &level = select_lod_level(lod, max_verts);
+      
+      std::vector<eig::Vector2f>  verts_out;
+      std::vector<eig::AlArray3f> colrs_out;
+      double time_extract = time_median([&] { extract_lod_level(level, verts, colrs, verts_out, colrs_out, n / 2); });
+      
+      float err_const = 0.f;
+      for (const auto &colr : colrs_out)
+        err_const = std::max(err_const, (colr - colr_const).abs().maxCoeff());
+      bool is_valid_n = !lod.empty() && err_const <= const_err_bound
+                     && verts_out.size() <= max_verts + 1 && verts_out.size() == colrs_out.size()
+                     && std::ranges::find(verts_out, verts[n / 2]) != verts_out.end();
+      for (uint i = 0; i < lod.size(); ++i) {
+        is_valid_n &= std::ranges::is_sorted(lod[i].indices) && lod[i].indices.size() >= 3;
+        guard_continue(i > 0);
+        is_valid_n &= lod[i].indices.size() < lod[i - 1].indices.size() && lod[i].error >= lod[i - 1].error;
+      }
+      is_valid &= is_valid_n;
+      
+      fmt::print("  {:>8} {:>8} {:>12.2f} {:>14.3f} {:>10} {:>12.2e} {:>8}\n", 
+        n, lod.size(), time_build, time_extract, verts_out.size(), err_const, is_valid_n);
+    }
+
+    // A smooth color ramp along a regular polygon stays close to the original colors at
+    // retained vertices, on its coarsest level
+    {
+      constexpr uint n = 4'096;
+      auto verts = generate_regular_polygon(n);
+      std::vector<eig::AlArray3f> colrs(n);
+      for (uint i = 0; i < n; ++i)
+        colrs[i] = eig::AlArray3f(.5f + .5f * std::sin(2.f * std::numbers::pi_v<float> * i / n), 0.f, 0.f);
+      auto lod = build_polygon_lod(verts);
+      
+      std::vector<eig::Vector2f>  verts_out;
+      std::vector<eig::AlArray3f> colrs_out;
+      extract_lod_level(lod.back(), verts, colrs, verts_out, colrs_out);
+      float err_ramp = 0.f;
+      for (uint j = 0; j < verts_out.size(); ++j) {
+        uint i = lod.back().indices[j];
+        err_ramp = std::max(err_ramp, (colrs_out[j] - colrs[i]).abs().maxCoeff());
+      }
+      is_valid &= err_ramp <= ramp_err_bound;
+      fmt::print("  Smooth color ramp, {} of {} vertices retained, max. deviation {:.2e}\n", 
+        verts_out.size(), n, err_ramp);
+    }
+
+    if (!is_valid)
+      fmt::print(stderr, "Polygon LOD chains failed validation\n");
+    return is_valid;
+  }
+
+  // Random edits in separate undo steps, followed by undoing and redoing every step; after
+  // each move, the session's flat buffers and polygon must match flat copies saved as the
+  // steps were made. Reports memory held by the history against full copies per version
+  bool run_undo_benchmark() {
+    constexpr uint n_verts = 10'000;
+    constexpr uint n_steps = 200;
+
+    fmt::print("Undo history, {} vertices, {} steps\n", n_verts, n_steps);
+    fmt::print("  {:>10} {:>12} {:>12} {:>14} {:>14} {:>10}\n", 
+      "versions", "edit (ms)", "undo (ms)", "history (MiB)", "copies (MiB)", "mismatch");
+
+    auto verts = generate_random_polygon(n_verts);
+    std::vector<eig::AlArray3f> colrs(n_verts, eig::AlArray3f(.5f));
+    EditSession session(verts, colrs);
+
+    // Steps are two frames apart, s.t. edits never continue the previous step's drag;
+    // moves span several frames, as drags do
+    std::mt19937 rng(n_verts);
+    std::uniform_real_distribution<float> distr(0.f, 1.f);
+    std::vector<std::vector<eig::Vector2f>>  verts_saved = { { range_iter(session.verts()) } };
+    std::vector<std::vector<eig::AlArray3f>> colrs_saved = { { range_iter(session.colrs()) } };
+    auto time_start = std::chrono::steady_clock::now();
+    for (uint step = 0; step < n_steps; ++step) {
+      uint i = std::uniform_int_distribution<uint>(0, session.verts().size() - 1)(rng);
+      switch (std::uniform_int_distribution<uint>(0, 9)(rng)) {
+        case 0:  session.split_longest_edge(); break;
+        case 1:  session.erase_vert(i);        break;
+        case 2: case 3: case 4: case 5:
+          for (uint f = 0; f < 5; ++f, session.next_frame())
+            session.set_vert(i, { distr(rng), distr(rng) });
+          break;
+        default: session.set_colr(i, { distr(rng), distr(rng), distr(rng) }); break;
+      }
+      session.next_frame();
+      session.next_frame();
+      verts_saved.push_back({ range_iter(session.verts()) });
+      colrs_saved.push_back({ range_iter(session.colrs()) });
+    }
+    double time_edit = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - time_start).count();
+    auto memory = session.history().memory();
+
+    // Compare against the saved copies of a step
+    uint n_mismatches = 0;
+    auto compare = [&](uint step) {
+      auto verts = session.verts();
+      auto colrs = session.colrs();
+      bool is_equal = std::ranges::equal(verts, verts_saved[step])
+        && std::ranges::equal(colrs, colrs_saved[step], [](const auto &a, const auto &b) { return (a == b).all(); })
+        && session.polygon().size() == verts.size();
+      for (uint j = 0; j < verts.size() && is_equal; ++j)
+        is_equal &= session.polygon().vert(j) == verts[j];
+      n_mismatches += !is_equal;
+    };
+    
+    // Undo and redo of all steps are timed together, without comparisons
+    double time_undo = 0.0;
+    auto timed = [&](auto f) {
+      auto time_start = std::chrono::steady_clock::now();
+      f();
+      time_undo += std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - time_start).count();
+    };
+    for (uint step = n_steps; step > 0; --step) {
+      timed([&] { session.undo(); });
+      compare(step - 1);
+    }
+    for (uint step = 1; step <= n_steps; ++step) {
+      timed([&] { session.redo(); });
+      compare(step);
+    }
+
+    // A new edit after undoing drops the redo steps
+    session.undo();
+    session.set_vert(0, { .5f, .5f });
+    bool is_valid = n_mismatches == 0 && session.history().steps() == n_steps && !session.history().can_redo();
+
+    fmt::print("  {:>10} {:>12.2f} {:>12.2f} {:>14.2f} {:>14.2f} {:>10}\n", 
+      memory.versions, time_edit, time_undo, memory.bytes / 1048576.0, memory.bytes_flat / 1048576.0, n_mismatches);
+    
+    if (!is_valid)
+      fmt::print(stderr, "Undo history failed validation\n");
+    return is_valid;
+  }
+} // namespace prg
+
+// Application entry point
+int main() {
+  try {
+    auto points = prg::generate_grid_points(prg::bench_grid_size);
+    if (!prg::run_isa_benchmark(points))
+      return EXIT_FAILURE;
+    if (!prg::run_fixed_size_benchmark(points))
+      return EXIT_FAILURE;
+    if (!prg::run_gradient_benchmark(points))
+      return EXIT_FAILURE;
+    if (!prg::run_wachspress_benchmark(points))
+      return EXIT_FAILURE;
+    if (!prg::run_precision_benchmark(points))
+      return EXIT_FAILURE;
+    if (!prg::run_editing_benchmark())
+      return EXIT_FAILURE;
+    if (!prg::run_holes_benchmark(points))
+      return EXIT_FAILURE;
+    if (!prg::run_parallel_triangulation_benchmark())
+      return EXIT_FAILURE;
+    if (!prg::run_collection_benchmark())
+      return EXIT_FAILURE;
+    if (!prg::run_curved_benchmark(points))
+      return EXIT_FAILURE;
+    if (!prg::run_batch_benchmark())
+      return EXIT_FAILURE;
+    if (!prg::run_weight_field_benchmark())
+      return EXIT_FAILURE;
+    if (!prg::run_tiled_render_benchmark())
+      return EXIT_FAILURE;
+    if (!prg::run_deform_benchmark())
+      return EXIT_FAILURE;
+    if (!prg::run_view_transform_benchmark())
+      return EXIT_FAILURE;
+    if (!prg::run_point_grid_benchmark())
+      return EXIT_FAILURE;
+    if (!prg::run_edit_trace_benchmark())
+      return EXIT_FAILURE;
+    if (!prg::run_lod_benchmark())
+      return EXIT_FAILURE;
+    if (!prg::run_undo_benchmark())
+      return EXIT_FAILURE;
+  } catch (const std::exception &e) {
+    fmt::print(stderr, "{}\n", e.what());
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
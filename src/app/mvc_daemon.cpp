@@ -0,0 +1,75 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdlib>
+#include <exception>
+#include <core/mvc_service.hpp>
+#include <core/utility.hpp>
+#include <csignal>
+#include <string>
+
+namespace prg {
+  // Server instance, reachable from signal handlers
+  MvcServer *server = nullptr;
+
+  extern "C" void handle_signal(int) {
+    if (server)
+      server->stop();
+  }
+
+  // Application main code; serves mean value coordinates and triangulations to local
+  // clients until interrupted, then prints server statistics
+  int run_mvc_daemon(std::span<const char *> args) {
+    if (args.size() < 2) {
+      fmt::print(stderr, "usage: {} <socket path> [cache size in MiB] [batch window in µs]\n", args[0]);
+      return EXIT_FAILURE;
+    }
+
+    MvcServerInfo info = { .path = args[1] };
+    if (args.size() > 2)
+      info.cache_size = std::stoull(args[2]) << 20;
+    if (args.size() > 3)
+      info.batch_window = static_cast<uint>(std::stoul(args[3]));
+
+    MvcServer server_(info);
+    server = &server_;
+    std::signal(SIGINT,  handle_signal);
+    std::signal(SIGTERM, handle_signal);
+
+    fmt::print("Serving on {}\n", info.path.string());
+    server_.run();
+    server = nullptr;
+
+    auto stats = server_.stats();
+    fmt::print("Served {} requests in {} batches; {} evaluations, {} coalesced, {} cache hits, {} misses\n",
+      stats.requests, stats.batches, stats.evaluations, stats.coalesced, stats.hits, stats.misses);
+    return EXIT_SUCCESS;
+  }
+} // namespace prg
+
+// Application entry point
+int main(int argc, const char *argv[]) {
+  try {
+    return prg::run_mvc_daemon({ argv, static_cast<size_t>(argc) });
+  } catch (const std::exception &e) {
+    fmt::print(stderr, "{}\n", e.what());
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,223 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdlib>
+#include <exception>
+#include <core/math.hpp>
+#include <core/mesh.hpp>
+#include <core/mvc.hpp>
+#include <core/mvc_service.hpp>
+#include <core/utility.hpp>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <filesystem>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace prg {
+  // Application main code; starts a server in-process, and has concurrent loopback clients
+  // request weights and triangulations of a shared set of polygons, over two point grids s.t.
+  // requests on the same polygon differ in their points. Results are compared against direct
+  // evaluation, and throughput is compared against each client evaluating all requests itself.
+  // A stalled connection that sent only part of its hello stays open throughout. Fails if
+  // results differ, if malformed requests are not rejected, if differently split polygons
+  // share a cache entry, or if any polygon and grid is evaluated more than once
+  int run_mvc_service_check(std::span<const char *> args) {
+    uint           n_clients  = args.size() > 1 ? static_cast<uint>(std::stoul(args[1])) : 8u;
+    uint           n_rounds   = args.size() > 2 ? static_cast<uint>(std::stoul(args[2])) : 4u;
+    constexpr uint n_polygons = 8;
+    constexpr uint n_verts    = 32;
+    constexpr uint grid_size  = 64;
+    constexpr float tolerance = 1e-5f;
+    auto socket_path = std::filesystem::temp_directory_path() / "mvc_service_check.sock";
+
+    // Polygons, alternating with holed polygons, and two point grids offset by half a cell
+    std::vector<std::vector<eig::Vector2f>> polygons(n_polygons);
+    std::vector<std::vector<uint>>          holes(n_polygons);
+    for (uint i = 0; i < n_polygons; ++i)
+      polygons[i] = i % 2 ? generate_random_polygon(n_verts, i)
+                          : generate_holed_polygon(n_verts, 2, holes[i], i);
+    std::array<std::vector<eig::Vector2f>, 2> grids;
+    for (uint g = 0; g < grids.size(); ++g)
+      for (uint y = 0; y < grid_size; ++y)
+        for (uint x = 0; x < grid_size; ++x)
+          grids[g].push_back((eig::Vector2f(x, y) + eig::Vector2f::Constant(.5f * g)) / static_cast<float>(grid_size));
+
+    // Reference results by direct evaluation
+    auto eval_direct = [&](uint i, uint g) {
+      std::vector<float> weights(grids[g].size() * polygons[i].size());
+      if (holes[i].empty())
+        eval_mvc(polygons[i], grids[g], weights);
+      else
+        eval_mvc(polygons[i], holes[i], grids[g], weights);
+      return weights;
+    };
+    std::vector<std::array<std::vector<float>, 2>> weights_ref(n_polygons);
+    std::vector<std::vector<eig::Array3u>>         elems_ref(n_polygons);
+    for (uint i = 0; i < n_polygons; ++i) {
+      weights_ref[i] = { eval_direct(i, 0), eval_direct(i, 1) };
+      elems_ref[i]   = triangulate_polygon(polygons[i], holes[i]);
+    }
+
+    // Baseline; every client evaluates all of its requests itself
+    auto time_start = std::chrono::steady_clock::now();
+    for (uint c = 0; c < n_clients; ++c)
+      for (uint r = 0; r < n_rounds; ++r)
+        for (uint i = 0; i < n_polygons; ++i) {
+          eval_direct(i, c % 2);
+          triangulate_polygon(polygons[i], holes[i]);
+        }
+    double time_direct = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - time_start).count();
+
+    MvcServer   server({ .path = socket_path });
+    std::thread server_thread([&] { server.run(); });
+
+    // Stalled connection; sends a partial hello and then nothing, which must not hold up others
+    int stalled_fd = ::socket(AF_UNIX, SOCK_STREAM, 0);
+    {
+      sockaddr_un addr = { .sun_family = AF_UNIX };
+      std::strncpy(addr.sun_path, socket_path.c_str(), sizeof(addr.sun_path) - 1);
+      if (stalled_fd < 0 || ::connect(stalled_fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) < 0
+       || ::send(stalled_fd, "PRG", 3, 0) != 3) {
+        fmt::print(stderr, "could not open stalled connection\n");
+        return EXIT_FAILURE;
+      }
+    }
+
+    // Concurrent clients on alternating grids; groups of four clients visit polygons in the
+    // same order, s.t. their requests may arrive together and share an evaluation
+    std::atomic<uint> n_errors = 0, n_shared = 0;
+    time_start = std::chrono::steady_clock::now();
+    std::vector<std::thread> client_threads;
+    for (uint c = 0; c < n_clients; ++c) {
+      client_threads.emplace_back([&, c] {
+        MvcClient client(socket_path);
+        uint g = c % 2;
+        std::vector<std::span<eig::Vector2f>> verts(n_polygons);
+        std::vector<std::span<uint>>          hole_offsets(n_polygons);
+        for (uint i = 0; i < n_polygons; ++i) {
+          verts[i]        = client.alloc<eig::Vector2f>(polygons[i]);
+          hole_offsets[i] = client.alloc<uint>(holes[i]);
+        }
+        auto points  = client.alloc<eig::Vector2f>(grids[g]);
+        auto weights = client.alloc<float>(points.size() * n_verts);
+        auto elems   = client.alloc<eig::Array3u>(2 * n_verts);
+
+        for (uint r = 0; r < n_rounds; ++r) {
+          for (uint j = 0; j < n_polygons; ++j) {
+            uint i = (j + c / 4) % n_polygons;
+            auto weights_i = weights.first(points.size() * verts[i].size());
+            auto reply = client.eval_mvc(verts[i], hole_offsets[i], points, weights_i);
+            bool is_equal = reply.status == MvcStatus::eOk && reply.count == weights_i.size()
+              && std::ranges::equal(weights_i, weights_ref[i][g], [&](float a, float b) { return std::abs(a - b) <= tolerance; });
+            if (reply.batch_size > 1)
+              n_shared++;
+
+            reply = client.triangulate(verts[i], hole_offsets[i], elems);
+            is_equal &= reply.status == MvcStatus::eOk && reply.count == elems_ref[i].size()
+              && std::ranges::equal(elems.first(reply.count), elems_ref[i], [](const auto &a, const auto &b) { return (a == b).all(); });
+            if (!is_equal)
+              n_errors++;
+          }
+        }
+      });
+    }
+    for (auto &thread : client_threads)
+      thread.join();
+    double time_service = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - time_start).count();
+    auto stats = server.stats();
+
+    // Malformed requests are rejected; a hole past the last vertex, an output range too small
+    // for the weights, and a misaligned output range
+    bool is_rejected = false;
+    {
+      MvcClient client(socket_path);
+      auto verts   = client.alloc<eig::Vector2f>(polygons[1]);
+      auto hole    = client.alloc<uint>(std::vector<uint> { n_verts + 1 });
+      auto points  = client.alloc<eig::Vector2f>(grids[0]);
+      auto weights = client.alloc<float>(points.size());
+      auto bytes   = client.alloc<std::byte>((points.size() * n_verts + 1) * sizeof(float));
+      auto reply_invalid    = client.eval_mvc(verts, hole, points, client.alloc<float>(points.size() * n_verts));
+      auto reply_small      = client.eval_mvc(verts, { }, points, weights);
+      auto reply_misaligned = client.eval_mvc(verts, { }, points, 
+        { reinterpret_cast<float *>(bytes.data() + 1), points.size() * n_verts });
+      is_rejected = reply_invalid.status    == MvcStatus::eInvalid
+                 && reply_small.status      == MvcStatus::eTooSmall && reply_small.count == points.size() * n_verts
+                 && reply_misaligned.status == MvcStatus::eInvalid;
+    }
+
+    // Polygons whose vertices and holes concatenate to the same bytes are told apart; the
+    // second polygon appends a vertex holding the first polygon's two hole offsets
+    bool is_distinct = false;
+    {
+      MvcClient client(socket_path);
+      std::vector<eig::Vector2f> verts_b = polygons[0];
+      verts_b.push_back(cast_span<const eig::Vector2f>(std::as_bytes(std::span(holes[0])))[0]);
+      auto verts_a = client.alloc<eig::Vector2f>(polygons[0]);
+      auto holes_a = client.alloc<uint>(holes[0]);
+      auto verts_c = client.alloc<eig::Vector2f>(verts_b);
+      auto elems   = client.alloc<eig::Array3u>(2 * verts_b.size());
+      auto reply_a = client.triangulate(verts_a, holes_a, elems);
+      auto reply_b = client.triangulate(verts_c, { }, elems);
+      auto elems_b = triangulate_polygon(verts_b);
+      is_distinct = holes[0].size() == 2 && reply_a.polygon_hash != reply_b.polygon_hash && !reply_b.is_cached
+                 && reply_b.status == MvcStatus::eOk && reply_b.count == elems_b.size()
+                 && std::ranges::equal(elems.first(reply_b.count), elems_b, [](const auto &a, const auto &b) { return (a == b).all(); });
+    }
+
+    ::close(stalled_fd);
+    server.stop();
+    server_thread.join();
+
+    uint n_requests = 2 * n_clients * n_rounds * n_polygons;
+    fmt::print("{} clients, {} requests over {} polygons\n", n_clients, n_requests, n_polygons);
+    fmt::print("  {:<10} {:>10} {:>14}\n", "", "time (ms)", "requests/s");
+    fmt::print("  {:<10} {:>10.2f} {:>14.0f}\n", "direct",  time_direct,  n_requests / time_direct  * 1e3);
+    fmt::print("  {:<10} {:>10.2f} {:>14.0f}\n", "service", time_service, n_requests / time_service * 1e3);
+    fmt::print("Server: {} batches, {} evaluations, {} coalesced, {} cache hits, {} misses; {} replies shared an evaluation\n",
+      stats.batches, stats.evaluations, stats.coalesced, stats.hits, stats.misses, n_shared.load());
+    fmt::print("Results match direct evaluation: {}, malformed requests rejected: {}, split polygons distinct: {}\n", 
+      n_errors == 0, is_rejected, is_distinct);
+
+    // Each polygon is evaluated at most once per grid; later requests hit the cache or
+    // share an evaluation
+    bool is_valid = n_errors == 0 && is_rejected && is_distinct && stats.requests == n_requests
+                 && stats.evaluations <= 2 * n_polygons;
+    if (!is_valid)
+      fmt::print(stderr, "service results differ from direct evaluation, or requests were re-evaluated\n");
+    return is_valid ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+} // namespace prg
+
+// Application entry point
+int main(int argc, const char *argv[]) {
+  try {
+    return prg::run_mvc_service_check({ argv, static_cast<size_t>(argc) });
+  } catch (const std::exception &e) {
+    fmt::print(stderr, "{}\n", e.what());
+    return EXIT_FAILURE;
+  }
+}
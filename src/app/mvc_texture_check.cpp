@@ -0,0 +1,256 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdlib>
+#include <exception>
+#include <core/edit_session.hpp>
+#include <core/gpu_ring.hpp>
+#include <core/headless_context.hpp>
+#include <core/math.hpp>
+#include <core/mesh.hpp>
+#include <core/mvc.hpp>
+#include <core/mvc_texture.hpp>
+#include <core/utility.hpp>
+#include <glad/glad.h>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <filesystem>
+#include <numbers>
+#include <stdexcept>
+#include <string>
+
+namespace prg {
+  // Even-odd containment test of a point in a polygon
+  bool is_inside(std::span<const eig::Vector2f> verts, const eig::Vector2f &p) {
+    bool is_in = false;
+    for (uint i = 0, j = verts.size() - 1; i < verts.size(); j = i++) {
+      const auto &a = verts[i], &b = verts[j];
+      if ((a.y() > p.y()) != (b.y() > p.y())
+       && p.x() < (b.x() - a.x()) * (p.y() - a.y()) / (b.y() - a.y()) + a.x())
+        is_in = !is_in;
+    }
+    return is_in;
+  }
+
+  // Application main code; evaluates weight textures through the compute pass for a set of
+  // test polygons, and compares weights and blended colors per pixel against the CPU engine;
+  // weights must be finite over the whole viewport, and zero outside for Wachspress polygons.
+  // Then, a sequence of frames that only edit colors is drawn through the cached weights and
+  // through the per-pixel fragment shader, reporting frame times and weight evaluations.
+  // Fails if any error exceeds tolerance, or if cached frames re-evaluate weights
+  int run_mvc_texture_check(std::span<const char *> args) {
+    std::filesystem::path shader_dir = args.size() > 1 ? args[1] : "shaders";
+    uint                  n_frames   = args.size() > 2 ? static_cast<uint>(std::stoul(args[2])) : 200u;
+    constexpr float       tolerance  = 1e-3f;
+
+    HeadlessContext context;
+    fmt::print("Renderer: {}\n", reinterpret_cast<const char *>(glGetString(GL_RENDERER)));
+
+    // Offscreen float target, s.t. blended colors are compared without quantization
+    const eig::Array2u target_size = { 320, 240 };
+    GLuint texture, framebuffer;
+    glCreateTextures(GL_TEXTURE_2D, 1, &texture);
+    glTextureStorage2D(texture, 1, GL_RGBA32F, target_size.x(), target_size.y());
+    glCreateFramebuffers(1, &framebuffer);
+    glNamedFramebufferTexture(framebuffer, GL_COLOR_ATTACHMENT0, texture, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, target_size.x(), target_size.y());
+
+    // Programs are owned by the cache, which has no file and only shares the build path
+    ProgramCache programs;
+    GLuint weights_program = load_program(programs, shader_dir, {{ GL_COMPUTE_SHADER,  "eval_mvc_weights.comp" }});
+    GLuint blend_program   = load_program(programs, shader_dir, {{ GL_VERTEX_SHADER,   "draw_mvc.vert"         },
+                                                                 { GL_FRAGMENT_SHADER, "draw_mvc_blend.frag"   }});
+    GLuint frag_program    = load_program(programs, shader_dir, {{ GL_VERTEX_SHADER,   "draw_mvc.vert"         },
+                                                                 { GL_FRAGMENT_SHADER, "draw_mvc.frag"         }});
+
+    DrawUploads      uploads({ .slot_size = 1 << 16, .slots = 3 });
+    MvcWeightTexture weight_texture;
+
+    // Pixel centers in vertex space, inverting the draw shaders' projection
+    float aspect = static_cast<float>(target_size.x()) / static_cast<float>(target_size.y());
+    CheckSettings settings = { .projection = eig::ortho(-aspect, aspect, -1.f, 1.f, -1.f, 1.f).matrix() };
+    eig::Matrix4f projection_inv = settings.projection.inverse();
+    std::vector<eig::Vector2f> pixels(target_size.prod());
+    for (uint y = 0; y < target_size.y(); ++y)
+      for (uint x = 0; x < target_size.x(); ++x) {
+        eig::Vector2f ndc = (eig::Vector2f(x, y) + eig::Vector2f::Constant(.5f)).cwiseQuotient(target_size.cast<float>().matrix()) * 2.f - eig::Vector2f::Ones();
+        eig::Vector4f v   = projection_inv * eig::Vector4f(ndc.x(), ndc.y(), 0.f, 1.f);
+        pixels[y * target_size.x() + x] = (v.head<2>() + eig::Vector2f::Ones()) * .5f;
+      }
+
+    // Test polygons; a convex one is also checked with Wachspress coordinates
+    auto star = [](uint n, float r_inner) {
+      std::vector<eig::Vector2f> verts(n);
+      for (uint i = 0; i < n; ++i) {
+        float a = 2.f * std::numbers::pi_v<float> * (static_cast<float>(i) + .25f) / static_cast<float>(n);
+        float r = (i % 2 ? r_inner : .45f);
+        verts[i] = eig::Vector2f(.5f + r * std::cos(a), .5f + r * std::sin(a));
+      }
+      return verts;
+    };
+    struct CheckCase { std::string name; std::vector<eig::Vector2f> verts; DrawMethod method; };
+    std::vector<CheckCase> cases = {
+      { "quad",          { { .25f, .5f }, { .5f, .25f }, { .75f, .5f }, { .5f, .75f } }, DrawMethod::eMeanValueCoords },
+      { "hexagon",       star(6,  .45f), DrawMethod::eMeanValueCoords },
+      { "hexagon/wp",    star(6,  .45f), DrawMethod::eWachspress      },
+      { "star 10",       star(10, .2f),  DrawMethod::eMeanValueCoords },
+      { "star 16",       star(16, .3f),  DrawMethod::eMeanValueCoords }
+    };
+
+    bool is_valid = true;
+    fmt::print("{:<12} {:>8} {:>14} {:>14}\n", "polygon", "pixels", "weight error", "color error");
+    for (const auto &c : cases) {
+      const uint n = c.verts.size();
+      std::vector<eig::AlArray3f> colrs(n);
+      for (uint i = 0; i < n; ++i)
+        colrs[i] = eig::AlArray3f(static_cast<float>(i % 3 == 0), static_cast<float>(i % 3 == 1), static_cast<float>(i) / static_cast<float>(n));
+      auto elems = triangulate_polygon(c.verts);
+
+      settings.draw_method = c.method;
+      uploads.upload(elems, c.verts, colrs, obj_span<const std::byte>(settings));
+      uploads.bind();
+
+      // Evaluate weights, then blend over the triangulation
+      glUseProgram(weights_program);
+      weight_texture.eval(c.verts, target_size, settings.projection, settings.draw_method);
+      glClearColor(0, 0, 0, 0);
+      glClear(GL_COLOR_BUFFER_BIT);
+      weight_texture.bind(0);
+      glUseProgram(blend_program);
+      uploads.draw(GL_TRIANGLES);
+
+      // Read back weights and colors
+      std::vector<eig::Array4f> gpu_weights(target_size.prod() * weight_texture.layers());
+      std::vector<eig::Array4f> gpu_colrs(target_size.prod());
+      glGetTextureImage(weight_texture.object(), 0, GL_RGBA, GL_FLOAT,
+        static_cast<GLsizei>(gpu_weights.size() * sizeof(eig::Array4f)), gpu_weights.data());
+      glGetTextureImage(texture, 0, GL_RGBA, GL_FLOAT,
+        static_cast<GLsizei>(gpu_colrs.size() * sizeof(eig::Array4f)), gpu_colrs.data());
+
+      // Compare pixels strictly inside the polygon against the CPU engine
+      float error_weights = 0.f, error_colrs = 0.f;
+      uint  n_pixels = 0;
+      std::vector<float> weights(n);
+      for (uint i = 0; i < pixels.size(); ++i) {
+        guard_continue(is_inside(c.verts, pixels[i]));
+        n_pixels++;
+        if (c.method == DrawMethod::eWachspress)
+          eval_wachspress(c.verts, pixels[i], weights);
+        else
+          eval_mvc(c.verts, pixels[i], weights);
+
+        eig::Array3f colr = 0.f;
+        for (uint j = 0; j < n; ++j) {
+          float gpu_weight = gpu_weights[(j / 4) * target_size.prod() + i][j % 4];
+          error_weights = std::max(error_weights, std::abs(gpu_weight - weights[j]));
+          colr += weights[j] * colrs[j].head<3>();
+        }
+
+        // Pixels whose centers lie on an edge may not be rasterized
+        if (gpu_colrs[i].w() == 1.f)
+          error_colrs = std::max(error_colrs, (gpu_colrs[i].head<3>() - colr).abs().maxCoeff());
+      }
+
+      // Weights must be finite over the whole viewport; Wachspress weights are zero outside
+      // the polygon, apart from pixels on its boundary, whose weights sum to one
+      bool is_finite = true, is_exterior_zero = true;
+      for (uint i = 0; i < pixels.size(); ++i) {
+        float sum = 0.f;
+        bool  is_zero = true;
+        for (uint j = 0; j < n; ++j) {
+          float gpu_weight = gpu_weights[(j / 4) * target_size.prod() + i][j % 4];
+          is_finite &= std::isfinite(gpu_weight);
+          is_zero   &= gpu_weight == 0.f;
+          sum       += gpu_weight;
+        }
+        if (c.method == DrawMethod::eWachspress && !is_inside(c.verts, pixels[i]))
+          is_exterior_zero &= is_zero || std::abs(sum - 1.f) <= tolerance;
+      }
+
+      fmt::print("{:<12} {:>8} {:>14.3e} {:>14.3e}\n", c.name, n_pixels, error_weights, error_colrs);
+      is_valid = is_valid && error_weights <= tolerance && error_colrs <= tolerance && is_finite && is_exterior_zero;
+    }
+
+    // Frames that only edit colors; the cached path evaluates weights once, while the
+    // fragment path evaluates weights per pixel per frame. The fragment shader holds at most
+    // 8 weights, so the comparison uses the 8-vertex star
+    auto verts = star(8, .25f);
+    auto elems = triangulate_polygon(verts);
+    settings.draw_method = DrawMethod::eMeanValueCoords;
+    weight_texture.invalidate();
+    uint evals_start = weight_texture.evals();
+
+    auto run = [&](std::string_view name, auto draw) {
+      std::vector<eig::AlArray3f> colrs(verts.size());
+      glFinish();
+      auto time_start = std::chrono::steady_clock::now();
+      for (uint f = 0; f < n_frames; ++f) {
+        for (uint i = 0; i < colrs.size(); ++i)
+          colrs[i] = eig::AlArray3f(static_cast<float>((f + i) % 7) / 6.f, static_cast<float>(i % 2), .5f);
+        uploads.upload(elems, verts, colrs, obj_span<const std::byte>(settings));
+        uploads.bind();
+        glClear(GL_COLOR_BUFFER_BIT);
+        draw();
+      }
+      glFinish();
+      double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - time_start).count();
+      fmt::print("{:<10} {:>8.3f} ms/frame\n", name, time / n_frames);
+    };
+
+    run("fragment", [&]() {
+      glUseProgram(frag_program);
+      uploads.draw(GL_TRIANGLES);
+    });
+    run("cached", [&]() {
+      if (weight_texture.is_stale(verts, target_size, settings.projection, settings.draw_method)) {
+        glUseProgram(weights_program);
+        weight_texture.eval(verts, target_size, settings.projection, settings.draw_method);
+      }
+      weight_texture.bind(0);
+      glUseProgram(blend_program);
+      uploads.draw(GL_TRIANGLES);
+    });
+
+    uint evals = weight_texture.evals() - evals_start;
+    fmt::print("cached: {} weight evaluations over {} frames\n", evals, n_frames);
+    is_valid = is_valid && evals == 1;
+
+    glDeleteFramebuffers(1, &framebuffer);
+    glDeleteTextures(1, &texture);
+    weight_texture = { };
+    uploads        = { };
+
+    if (!is_valid)
+      fmt::print(stderr, "compute pass does not match the CPU engine, or cached frames re-evaluated weights\n");
+    return is_valid ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+} // namespace prg
+
+// Application entry point
+int main(int argc, const char *argv[]) {
+  try {
+    return prg::run_mvc_texture_check({ argv, static_cast<size_t>(argc) });
+  } catch (const std::exception &e) {
+    fmt::print(stderr, "{}\n", e.what());
+    return EXIT_FAILURE;
+  }
+}
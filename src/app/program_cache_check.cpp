@@ -0,0 +1,182 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdlib>
+#include <exception>
+#include <core/edit_session.hpp>
+#include <core/gpu_ring.hpp>
+#include <core/headless_context.hpp>
+#include <core/math.hpp>
+#include <core/mesh.hpp>
+#include <core/mvc.hpp>
+#include <core/mvc_texture.hpp>
+#include <core/program_cache.hpp>
+#include <core/utility.hpp>
+#include <glad/glad.h>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace prg {
+  // Programs of the interactive test, in order of its draw objects
+  std::vector<std::vector<ProgramStage>> check_programs(const std::filesystem::path &dir) {
+    return {
+      {{ GL_VERTEX_SHADER, dir / "draw_polygon.vert" }, { GL_FRAGMENT_SHADER, dir / "draw_polygon.frag"    }},
+      {{ GL_VERTEX_SHADER, dir / "draw_mvc.vert"     }, { GL_FRAGMENT_SHADER, dir / "draw_mvc.frag"        }},
+      {{ GL_VERTEX_SHADER, dir / "draw_bary.vert"    }, { GL_FRAGMENT_SHADER, dir / "draw_bary.frag"       }},
+      {{ GL_COMPUTE_SHADER, dir / "eval_mvc_weights.comp" }},
+      {{ GL_VERTEX_SHADER, dir / "draw_mvc.vert"     }, { GL_FRAGMENT_SHADER, dir / "draw_mvc_blend.frag"  }}
+    };
+  }
+
+  // Application main code; builds the interactive test's programs through a program cache
+  // from a cold start, and then from a warm start that reads the cache file back, reporting
+  // build times and times to the first finished frame. Warm programs must all load from cached
+  // binaries and render identically to cold programs, and a shader edit must miss the cache.
+  // Fails otherwise, or if the driver exposes no program binary formats. Drivers may keep
+  // their own shader cache, e.g. Mesa's, which speeds up cold starts after the first run
+  int run_program_cache_check(std::span<const char *> args) {
+    std::filesystem::path shader_dir = args.size() > 1 ? args[1] : "shaders";
+    bool                  parallel   = args.size() > 2 ? std::string_view(args[2]) != "serial" : true;
+    std::filesystem::path cache_path = std::filesystem::temp_directory_path() / "program_cache_check.bin";
+
+    HeadlessContext context;
+    fmt::print("Renderer: {}\n", reinterpret_cast<const char *>(glGetString(GL_RENDERER)));
+    GLint n_formats = 0;
+    glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &n_formats);
+    if (n_formats == 0) {
+      fmt::print(stderr, "driver exposes no program binary formats\n");
+      return EXIT_FAILURE;
+    }
+
+    // Offscreen target and polygon, rendered through all passes of the interactive test
+    const eig::Array2u target_size = { 256, 256 };
+    GLuint texture, framebuffer;
+    glCreateTextures(GL_TEXTURE_2D, 1, &texture);
+    glTextureStorage2D(texture, 1, GL_RGBA32F, target_size.x(), target_size.y());
+    glCreateFramebuffers(1, &framebuffer);
+    glNamedFramebufferTexture(framebuffer, GL_COLOR_ATTACHMENT0, texture, 0);
+    glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+    glViewport(0, 0, target_size.x(), target_size.y());
+
+    auto verts = generate_random_polygon(8, 1);
+    auto elems = triangulate_polygon(verts);
+    std::vector<eig::AlArray3f> colrs(verts.size());
+    for (uint i = 0; i < colrs.size(); ++i)
+      colrs[i] = eig::AlArray3f(static_cast<float>(i % 2), static_cast<float>(i % 3) / 2.f, static_cast<float>(i) / 8.f);
+    CheckSettings settings = { .projection = eig::ortho(-1.f, 1.f, -1.f, 1.f, -1.f, 1.f).matrix() };
+
+    DrawUploads      uploads({ .slot_size = 1 << 16, .slots = 3 });
+    MvcWeightTexture weight_texture;
+    auto render = [&](std::span<const uint> objects) {
+      uploads.upload(elems, verts, colrs, obj_span<const std::byte>(settings));
+      uploads.bind();
+      glClearColor(0, 0, 0, 0);
+      glClear(GL_COLOR_BUFFER_BIT);
+
+      // Background passes, blended over the cached weights, then lines on top
+      for (uint i : { 2u, 1u }) {
+        glUseProgram(objects[i]);
+        uploads.draw(GL_TRIANGLES);
+      }
+      glUseProgram(objects[3]);
+      weight_texture.eval(verts, target_size, settings.projection, settings.draw_method);
+      weight_texture.bind(0);
+      glUseProgram(objects[4]);
+      uploads.draw(GL_TRIANGLES);
+      glUseProgram(objects[0]);
+      glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+      uploads.draw(GL_TRIANGLES);
+      glPolygonMode(GL_FRONT_AND_BACK, GL_FILL);
+
+      std::vector<eig::Array4f> out(target_size.prod());
+      glGetTextureImage(texture, 0, GL_RGBA, GL_FLOAT,
+        static_cast<GLsizei>(out.size() * sizeof(eig::Array4f)), out.data());
+      return out;
+    };
+
+    auto programs = check_programs(shader_dir);
+    std::filesystem::remove(cache_path);
+
+    // Build programs and finish a first frame; drivers may defer compilation to first use
+    auto run = [&](std::string_view name, ProgramCache &cache, std::span<const std::vector<ProgramStage>> stages) {
+      auto time_start = std::chrono::steady_clock::now();
+      auto objects = cache.build(stages);
+      auto out     = render(objects);
+      double time  = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - time_start).count();
+      const auto &stats = cache.stats();
+      fmt::print("{:<14} {:>6} {:>8} {:>10} {:>12.2f} {:>18.2f}\n",
+        name, stats.hits, stats.misses, stats.is_parallel, stats.time_ms, time);
+      return out;
+    };
+    fmt::print("{:<14} {:>6} {:>8} {:>10} {:>12} {:>18}\n", "start", "hits", "misses", "parallel", "build (ms)", "first frame (ms)");
+
+    // Cold start writes the cache file, which the warm start reads back
+    ProgramCache cold({ .path = cache_path, .parallel = parallel });
+    auto out_cold = run("cold", cold, programs);
+    if (!cold.save())
+      fmt::print(stderr, "could not write {}\n", cache_path.string());
+    ProgramCache warm({ .path = cache_path, .parallel = parallel });
+    auto out_warm = run("warm", warm, programs);
+    bool is_valid = cold.stats().misses == programs.size() && warm.stats().hits == programs.size()
+                 && warm.stats().misses == 0;
+
+    // An edited shader misses the cache, while its unedited programs still hit
+    {
+      auto edit_path = std::filesystem::path(cache_path).replace_extension(".frag");
+      std::filesystem::copy_file(shader_dir / "draw_bary.frag", edit_path, std::filesystem::copy_options::overwrite_existing);
+      std::ofstream(edit_path, std::ios::app) << "\n// edited\n";
+      auto edited = programs;
+      edited[2][1].path = edit_path;
+
+      ProgramCache cache({ .path = cache_path, .parallel = parallel });
+      run("warm, edited", cache, edited);
+      is_valid = is_valid && cache.stats().hits == programs.size() - 1 && cache.stats().misses == 1;
+      std::filesystem::remove(edit_path);
+    }
+
+    bool is_equal = std::ranges::equal(out_cold, out_warm, [](const auto &a, const auto &b) { return (a == b).all(); });
+    fmt::print("cold and warm programs render identically: {}\n", is_equal);
+    is_valid = is_valid && is_equal;
+
+    glDeleteFramebuffers(1, &framebuffer);
+    glDeleteTextures(1, &texture);
+    weight_texture = { };
+    uploads        = { };
+    std::filesystem::remove(cache_path);
+
+    if (!is_valid)
+      fmt::print(stderr, "warm start did not load all programs from the cache, or rendered differently\n");
+    return is_valid ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+} // namespace prg
+
+// Application entry point
+int main(int argc, const char *argv[]) {
+  try {
+    return prg::run_program_cache_check({ argv, static_cast<size_t>(argc) });
+  } catch (const std::exception &e) {
+    fmt::print(stderr, "{}\n", e.what());
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,119 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <core/math.hpp>
+#include <core/tiled_render.hpp>
+#include <core/utility.hpp>
+#include <nlohmann/json.hpp>
+#include <charconv>
+#include <chrono>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace prg {
+  // Default polygonal data layout, matching the interactive test
+  std::vector<eig::Vector2f> verts = {
+    eig::Array2f { .25, .5 },
+    eig::Array2f { .5, .25 },
+    eig::Array2f { .75, .5 },
+    eig::Array2f { .5, .75 }
+  };
+  std::vector<eig::AlArray3f> colrs = {
+    eig::AlArray3f { 1, 0, 0 },
+    eig::AlArray3f { 0, 1, 0 },
+    eig::AlArray3f { 0, 0, 1 },
+    eig::AlArray3f { 1, 1, 0 }
+  };
+
+  // Load polygon data from a json file of the form
+  // { "verts": [[x, y], ...], "colrs": [[r, g, b], ...] }
+  void load_polygon(const std::filesystem::path &path) {
+    std::ifstream in(path);
+    auto js = nlohmann::json::parse(in);
+    verts.clear();
+    colrs.clear();
+    for (const auto &v : js.at("verts"))
+      verts.push_back({ v.at(0).get<float>(), v.at(1).get<float>() });
+    for (const auto &c : js.at("colrs"))
+      colrs.push_back({ c.at(0).get<float>(), c.at(1).get<float>(), c.at(2).get<float>() });
+  }
+
+  // Parse an unsigned integer argument in [min, max]; returns nothing if the argument is
+  // malformed or out of range
+  std::optional<uint> parse_arg(std::string_view arg, uint min, uint max) {
+    uint value;
+    auto [ptr, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), value);
+    guard(ec == std::errc() && ptr == arg.data() + arg.size(), {});
+    guard(value >= min && value <= max, {});
+    return value;
+  }
+
+  // Application main code
+  int run_render_tiled(std::span<const char *> args) {
+    auto print_usage = [&] {
+      fmt::print(stderr, "usage: {} <output> <width> <height> [polygon.json] [tile size] [memory budget in MiB]\n", args[0]);
+      fmt::print(stderr, "  width, height and tile size in [1, 1048576], memory budget in [1, 1048576]\n");
+      return EXIT_FAILURE;
+    };
+    guard(args.size() >= 4, print_usage());
+
+    auto width  = parse_arg(args[2], 1, 1 << 20);
+    auto height = parse_arg(args[3], 1, 1 << 20);
+    auto tile   = args.size() > 5 ? parse_arg(args[5], 1, 1 << 20) : std::optional<uint>(256);
+    auto budget = args.size() > 6 ? parse_arg(args[6], 1, 1 << 20) : std::optional<uint>(256);
+    guard(width && height && tile && budget, print_usage());
+    
+    TiledRenderInfo info = { .path       = args[1],
+                             .size       = { *width, *height },
+                             .tile_size  = { *tile, *tile },
+                             .mem_budget = static_cast<size_t>(*budget) << 20 };
+    if (args.size() > 4) {
+      load_polygon(args[4]);
+      if (verts.size() < 3 || verts.size() != colrs.size()) {
+        fmt::print(stderr, "polygon requires at least three vertices, and a color per vertex\n");
+        return print_usage();
+      }
+    }
+    info.verts = verts;
+    info.colrs = colrs;
+
+    auto time_start = std::chrono::steady_clock::now();
+    auto result     = render_mvc_tiled(info);
+    auto time_total = std::chrono::duration<double>(std::chrono::steady_clock::now() - time_start);
+
+    fmt::print("Rendered {} of {} tiles ({} resumed) in {:.2f}s\n", 
+      result.tiles_rendered, result.tiles_total, result.tiles_skipped, time_total.count());
+    return EXIT_SUCCESS;
+  }
+} // namespace prg
+
+// Application entry point
+int main(int argc, const char *argv[]) {
+  try {
+    return prg::run_render_tiled({ argv, static_cast<size_t>(argc) });
+  } catch (const std::exception &e) {
+    fmt::print(stderr, "{}\n", e.what());
+    return EXIT_FAILURE;
+  }
+}
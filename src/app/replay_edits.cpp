@@ -0,0 +1,123 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <cstdlib>
+#include <exception>
+#include <fstream>
+#include <core/edit_session.hpp>
+#include <core/math.hpp>
+#include <core/utility.hpp>
+#include <algorithm>
+#include <chrono>
+#include <limits>
+#include <optional>
+#include <string>
+#include <string_view>
+
+namespace prg {
+  // Application main code; replays a recorded edit trace without a window, feeding each
+  // frame's edits through the same session update as the interactive test, and reports
+  // per-frame cpu timings. Window-side work (ImGui, gl uploads and draws) is not included.
+  // With preview set, frames that only move vertices are treated as drags, and drawn at a
+  // coarse LOD level as the interactive test does
+  int run_replay_edits(std::span<const char *> args) {
+    if (args.size() < 2) {
+      fmt::print(stderr, "usage: {} <trace.json> [timings.csv] [repeats] [preview]\n", args[0]);
+      return EXIT_FAILURE;
+    }
+
+    auto trace   = load_edit_trace(args[1]);
+    uint repeats = args.size() > 3 ? static_cast<uint>(std::stoul(args[3])) : 1u;
+    bool preview = args.size() > 4 && std::string_view(args[4]) == "preview";
+    auto view    = edit_view_transform(trace.window_size.cast<float>());
+
+    // Per-frame timings, taking the minimum over repeats to suppress noise
+    std::vector<double> times(trace.frames, std::numeric_limits<double>::max());
+    std::vector<uint>   edits(trace.frames, 0);
+    uint                verts_final = 0;
+    for (uint r = 0; r < repeats; ++r) {
+      EditSession session(trace.verts, trace.colrs, trace.settings);
+      EditFrame   frame;
+
+      auto event = trace.events.begin();
+      for (uint f = 0; f < trace.frames; ++f) {
+        auto time_start = std::chrono::steady_clock::now();
+
+        // Apply this frame's edits, then regenerate derived data as the interactive test does
+        bool                is_dragging = false;
+        std::optional<uint> pinned;
+        for (edits[f] = 0; event != trace.events.end() && event->frame == f; ++event, ++edits[f]) {
+          session.apply(*event);
+          is_dragging = (edits[f] == 0 || is_dragging) && event->type == EditType::eMoveVert;
+          pinned      = event->index;
+        }
+        session.update_pick(frame, view, edit_pick_radius);
+        session.update_draw(frame, preview && is_dragging, pinned);
+        session.next_frame();
+
+        double time = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - time_start).count();
+        times[f] = std::min(times[f], time);
+      }
+      verts_final = static_cast<uint>(session.verts().size());
+    }
+
+    // Optionally write per-frame timings
+    if (args.size() > 2) {
+      std::ofstream out(args[2]);
+      out << "frame,edits,time_ms\n";
+      for (uint f = 0; f < trace.frames; ++f)
+        out << fmt::format("{},{},{:.6f}\n", f, edits[f], times[f]);
+    }
+
+    // Summarize over all frames, and over frames with edits only
+    auto summarize = [](std::string_view name, std::vector<double> times) {
+      guard(!times.empty());
+      std::ranges::sort(times);
+      double total = 0.0;
+      for (double time : times)
+        total += time;
+      fmt::print("  {:<12} {:>8} {:>12.3f} {:>12.4f} {:>12.4f} {:>12.4f} {:>12.4f}\n",
+        name, times.size(), total, total / times.size(), times[times.size() / 2],
+        times[std::min<size_t>(times.size() * 95 / 100, times.size() - 1)], times.back());
+    };
+    std::vector<double> times_edited;
+    for (uint f = 0; f < trace.frames; ++f)
+      if (edits[f] > 0)
+        times_edited.push_back(times[f]);
+
+    fmt::print("Replayed {} edits over {} frames, {} vertices at end, min. over {} runs{}\n",
+      trace.events.size(), trace.frames, verts_final, repeats, preview ? ", previewing drags" : "");
+    fmt::print("  {:<12} {:>8} {:>12} {:>12} {:>12} {:>12} {:>12}\n",
+      "frames", "count", "total (ms)", "mean (ms)", "median (ms)", "p95 (ms)", "max (ms)");
+    summarize("all", times);
+    summarize("with edits", times_edited);
+    return EXIT_SUCCESS;
+  }
+} // namespace prg
+
+// Application entry point
+int main(int argc, const char *argv[]) {
+  try {
+    return prg::run_replay_edits({ argv, static_cast<size_t>(argc) });
+  } catch (const std::exception &e) {
+    fmt::print(stderr, "{}\n", e.what());
+    return EXIT_FAILURE;
+  }
+}
@@ -0,0 +1,92 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <core/batch_renderer.hpp>
+#include <glad/glad.h>
+#include <algorithm>
+#include <utility>
+
+namespace prg {
+  namespace dtl {
+    template <typename T>
+    uint create_batch_buffer(const std::vector<T> &data) {
+      GLuint buffer;
+      glCreateBuffers(1, &buffer);
+      glNamedBufferStorage(buffer, static_cast<GLsizeiptr>(std::max<size_t>(data.size() * sizeof(T), 1)), data.data(), 0);
+      return buffer;
+    }
+  } // namespace dtl
+
+  BatchRenderer::BatchRenderer(const DrawBatch &batch)
+  : m_draws(static_cast<uint>(batch.commands.size())) {
+    m_buffers[eVerts]    = dtl::create_batch_buffer(batch.verts);
+    m_buffers[eColrs]    = dtl::create_batch_buffer(batch.colrs);
+    m_buffers[eElems]    = dtl::create_batch_buffer(batch.elems);
+    m_buffers[eRings]    = dtl::create_batch_buffer(batch.rings);
+    m_buffers[ePolygons] = dtl::create_batch_buffer(batch.polygons);
+    m_buffers[eCommands] = dtl::create_batch_buffer(batch.commands);
+
+    // Vertices and colors per vertex, polygon data per instance
+    glCreateVertexArrays(1, &m_array);
+    for (uint i = 0; i < 3; ++i) {
+      glEnableVertexArrayAttrib(m_array, i);
+      glVertexArrayAttribBinding(m_array, i, i);
+    }
+    glVertexArrayAttribFormat(m_array, 0, 2, GL_FLOAT, GL_FALSE, 0);
+    glVertexArrayAttribFormat(m_array, 1, 3, GL_FLOAT, GL_FALSE, 0);
+    glVertexArrayAttribIFormat(m_array, 2, 2, GL_UNSIGNED_INT, 0);
+    glVertexArrayVertexBuffer(m_array, 0, m_buffers[eVerts],    0, sizeof(eig::Vector2f));
+    glVertexArrayVertexBuffer(m_array, 1, m_buffers[eColrs],    0, sizeof(eig::AlArray3f));
+    glVertexArrayVertexBuffer(m_array, 2, m_buffers[ePolygons], 0, sizeof(DrawBatchPolygon));
+    glVertexArrayBindingDivisor(m_array, 2, 1);
+    glVertexArrayElementBuffer(m_array, m_buffers[eElems]);
+  }
+
+  BatchRenderer::~BatchRenderer() {
+    guard(m_array);
+    glDeleteVertexArrays(1, &m_array);
+    glDeleteBuffers(static_cast<GLsizei>(m_buffers.size()), m_buffers.data());
+  }
+
+  void BatchRenderer::bind() const {
+    glBindVertexArray(m_array);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 0, m_buffers[eVerts]);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 1, m_buffers[eColrs]);
+    glBindBufferBase(GL_SHADER_STORAGE_BUFFER, 2, m_buffers[eRings]);
+    glBindBuffer(GL_DRAW_INDIRECT_BUFFER, m_buffers[eCommands]);
+  }
+
+  void BatchRenderer::draw(uint mode) const {
+    glMultiDrawElementsIndirect(static_cast<GLenum>(mode), GL_UNSIGNED_INT, nullptr,
+                                static_cast<GLsizei>(m_draws), sizeof(DrawIndirectCommand));
+  }
+
+  void BatchRenderer::draw(uint mode, uint i) const {
+    glDrawElementsIndirect(static_cast<GLenum>(mode), GL_UNSIGNED_INT,
+                           reinterpret_cast<const void *>(i * sizeof(DrawIndirectCommand)));
+  }
+
+  void BatchRenderer::swap(BatchRenderer &o) {
+    using std::swap;
+    swap(m_buffers, o.m_buffers);
+    swap(m_array,   o.m_array);
+    swap(m_draws,   o.m_draws);
+  }
+} // namespace prg
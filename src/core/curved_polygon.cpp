@@ -0,0 +1,161 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <core/curved_polygon.hpp>
+#include <algorithm>
+#include <cmath>
+
+namespace prg {
+  eig::Vector2f eval_curve(const eig::Vector2f &a, const CurvedEdge &edge, const eig::Vector2f &b, float t) {
+    float s = 1.f - t;
+    switch (edge.type) {
+      case CurveType::eQuadratic:
+        return s * s * a + 2.f * s * t * edge.ctrl_a + t * t * b;
+      case CurveType::eCubic:
+        return s * s * s * a + 3.f * s * s * t * edge.ctrl_a + 3.f * s * t * t * edge.ctrl_b + t * t * t * b;
+      default:
+        return s * a + t * b;
+    }
+  }
+
+  uint curve_segments(const eig::Vector2f &a, const CurvedEdge &edge, const eig::Vector2f &b, float tolerance) {
+    dbg::check_expr(tolerance > 0.f, "curve_segments(...) requires a positive tolerance");
+
+    // Deviation of uniform flattening into k steps is bounded by d (d - 1) / 8 * m / k^2,
+    // for a curve of degree d whose control points' second differences are at most m
+    float bound;
+    switch (edge.type) {
+      case CurveType::eQuadratic:
+        bound = .25f * (a - 2.f * edge.ctrl_a + b).norm();
+        break;
+      case CurveType::eCubic:
+        bound = .75f * std::max((a - 2.f * edge.ctrl_a + edge.ctrl_b).norm(),
+                                (edge.ctrl_a - 2.f * edge.ctrl_b + b).norm());
+        break;
+      default:
+        return 1;
+    }
+    float k = std::ceil(std::sqrt(bound / tolerance));
+    return static_cast<uint>(std::clamp(k, 1.f, static_cast<float>(curve_max_segments)));
+  }
+
+  CurvedPolygon::CurvedPolygon(std::span<const eig::Vector2f>  verts,
+                               std::span<const eig::AlArray3f> colrs,
+                               std::span<const CurvedEdge>     edges)
+  : m_verts(range_iter(verts)),
+    m_colrs(range_iter(colrs)),
+    m_edges(range_iter(edges)),
+    m_cache(verts.size()) {
+    dbg::check_expr(verts.size() == colrs.size(), "CurvedPolygon(...) requires a color per vertex");
+    dbg::check_expr(edges.empty() || edges.size() == verts.size(), "CurvedPolygon(...) requires no edges or an edge per vertex");
+    if (m_edges.empty())
+      m_edges.resize(m_verts.size());
+  }
+
+  void CurvedPolygon::mark_vert(uint i) {
+    m_cache[i].is_dirty                         = true;
+    m_cache[(i + size() - 1) % size()].is_dirty = true;
+    m_is_dirty                                  = true;
+  }
+
+  void CurvedPolygon::set_vert(uint i, const eig::Vector2f &vert) {
+    m_verts[i] = vert;
+    mark_vert(i);
+  }
+
+  void CurvedPolygon::set_colr(uint i, const eig::AlArray3f &colr) {
+    m_colrs[i] = colr;
+    mark_vert(i);
+  }
+
+  void CurvedPolygon::set_edge(uint i, const CurvedEdge &edge) {
+    m_edges[i]          = edge;
+    m_cache[i].is_dirty = true;
+    m_is_dirty          = true;
+  }
+
+  bool CurvedPolygon::update(float tolerance) {
+    dbg::check_expr(tolerance > 0.f, "CurvedPolygon::update(...) requires a positive tolerance");
+    const uint n = size();
+    m_flattened = 0;
+
+    // Snap tolerance down to a power of two; on change, all curved edges are re-flattened
+    float tolerance_snapped = std::exp2(std::floor(std::log2(tolerance)));
+    if (tolerance_snapped != m_tolerance) {
+      m_tolerance = tolerance_snapped;
+      for (uint i = 0; i < n; ++i) {
+        guard_continue(m_edges[i].type != CurveType::eLine);
+        m_cache[i].is_dirty = true;
+        m_is_dirty          = true;
+      }
+    }
+    guard(m_is_dirty, false);
+
+    // Re-flatten dirty edges, and test whether the output layout holds
+    bool is_layout_valid = m_offsets.size() == n + 1;
+    for (uint i = 0; i < n; ++i) {
+      auto &cache = m_cache[i];
+      guard_continue(cache.is_dirty);
+
+      const auto &a = m_verts[i], &b = m_verts[(i + 1) % n];
+      uint k = curve_segments(a, m_edges[i], b, m_tolerance);
+      is_layout_valid = is_layout_valid && m_offsets[i + 1] - m_offsets[i] == k;
+
+      cache.points.resize(k - 1);
+      cache.params.resize(k - 1);
+      for (uint j = 1; j < k; ++j) {
+        float t = static_cast<float>(j) / static_cast<float>(k);
+        cache.points[j - 1] = eval_curve(a, m_edges[i], b, t);
+        cache.params[j - 1] = t;
+      }
+      m_flattened++;
+    }
+
+    // Recompute offsets if any edge's vertex count changed
+    if (!is_layout_valid) {
+      m_offsets.resize(n + 1);
+      m_offsets[0] = 0;
+      for (uint i = 0; i < n; ++i)
+        m_offsets[i + 1] = m_offsets[i] + 1 + static_cast<uint>(m_cache[i].points.size());
+      m_flat_verts.resize(m_offsets[n]);
+      m_flat_colrs.resize(m_offsets[n]);
+    }
+
+    // Write edges' ranges; all of them after a layout change, or only dirty ones otherwise
+    for (uint i = 0; i < n; ++i) {
+      auto &cache = m_cache[i];
+      guard_continue(cache.is_dirty || !is_layout_valid);
+
+      const auto &colr_a = m_colrs[i], &colr_b = m_colrs[(i + 1) % n];
+      uint o = m_offsets[i];
+      m_flat_verts[o] = m_verts[i];
+      m_flat_colrs[o] = colr_a;
+      for (uint j = 0; j < cache.points.size(); ++j) {
+        float t = cache.params[j];
+        m_flat_verts[o + 1 + j] = cache.points[j];
+        m_flat_colrs[o + 1 + j] = (1.f - t) * colr_a + t * colr_b;
+      }
+      cache.is_dirty = false;
+    }
+
+    m_is_dirty = false;
+    return true;
+  }
+} // namespace prg
@@ -0,0 +1,262 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <core/deform.hpp>
+#include <core/mvc.hpp>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+namespace prg {
+  namespace dtl {
+    // Nr. of points evaluated per parallel work item when building sparse weights
+    constexpr uint deform_block_size = 1024;
+    
+    // Nr. of image rows per parallel raster band
+    constexpr uint deform_band_size = 32;
+
+    // Min. magnitude of the sum of retained weights for renormalization
+    constexpr float deform_min_sum = .5f;
+
+    inline
+    float cross_2d(const eig::Vector2f &a, const eig::Vector2f &b) {
+      return a.x() * b.y() - a.y() * b.x();
+    }
+
+    // Bilinear lookup into a rgba8 image, with pixel centers at integer coordinates
+    inline
+    eig::Array4f sample_bilinear(std::span<const eig::Array4<uchar>> src, 
+                                 eig::Array2u                        size, 
+                                 eig::Vector2f                       xy) {
+      eig::Array2f xy_ = xy.array().max(0.f).min((size - 1).cast<float>());
+      eig::Array2u lo  = xy_.cast<uint>();
+      eig::Array2u hi  = (lo + 1).min(size - 1);
+      eig::Array2f a   = xy_ - lo.cast<float>();
+      auto at = [&](uint x, uint y) { return src[y * size.x() + x].cast<float>(); };
+      return (1.f - a.y()) * ((1.f - a.x()) * at(lo.x(), lo.y()) + a.x() * at(hi.x(), lo.y()))
+           +        a.y()  * ((1.f - a.x()) * at(lo.x(), hi.y()) + a.x() * at(hi.x(), hi.y()));
+    }
+
+    // Rasterize a deformed triangle (a, b, c) into dst, restricted to rows [y_min, y_max);
+    // pixels take source image samples interpolated from source positions (sa, sb, sc)
+    inline
+    void raster_triangle(const eig::Vector2f &a,  const eig::Vector2f &b,  const eig::Vector2f &c,
+                         const eig::Vector2f &sa, const eig::Vector2f &sb, const eig::Vector2f &sc,
+                         std::span<const eig::Array4<uchar>> src,
+                         std::span<eig::Array4<uchar>>       dst,
+                         eig::Array2u size, int y_min, int y_max) {
+      float area = cross_2d(b - a, c - a);
+      guard(std::abs(area) > 1e-8f);
+      float rcp_area = 1.f / area;
+
+      // Clipped pixel bounds of triangle; bounds are widened slightly, s.t. pixels on edges
+      // survive round-off in the lattice's round trip through polygon space
+      constexpr float bounds_epsilon = 1e-2f;
+      eig::Array2f lo = (a.array().min(b.array()).min(c.array()) - bounds_epsilon).ceil();
+      eig::Array2f hi = (a.array().max(b.array()).max(c.array()) + bounds_epsilon).floor();
+      int x0 = std::max(static_cast<int>(lo.x()), 0), x1 = std::min(static_cast<int>(hi.x()), static_cast<int>(size.x()) - 1);
+      int y0 = std::max(static_cast<int>(lo.y()), y_min), y1 = std::min(static_cast<int>(hi.y()), y_max - 1);
+
+      // Small tolerance closes cracks between adjacent triangles, and keeps pixels on the
+      // image's edges covered despite round-off in deformed lattice positions
+      constexpr float tolerance = -1e-2f;
+      for (int y = y0; y <= y1; ++y) {
+        for (int x = x0; x <= x1; ++x) {
+          eig::Vector2f p = { static_cast<float>(x), static_cast<float>(y) };
+          float w0 = cross_2d(c - b, p - b) * rcp_area;
+          float w1 = cross_2d(a - c, p - c) * rcp_area;
+          float w2 = 1.f - w0 - w1;
+          guard_continue(w0 >= tolerance && w1 >= tolerance && w2 >= tolerance);
+          
+          eig::Array4f colr = sample_bilinear(src, size, w0 * sa + w1 * sb + w2 * sc);
+          dst[y * size.x() + x] = (colr + .5f).min(255.f).cast<uchar>();
+        }
+      }
+    }
+  } // namespace dtl
+
+  SparseWeights build_sparse_weights(std::span<const eig::Vector2f> verts,
+                                     std::span<const eig::Vector2f> points,
+                                     uint                           k,
+                                     float                          epsilon) {
+    const uint n        = verts.size();
+    const uint n_blocks = ceil_div(static_cast<uint>(points.size()), dtl::deform_block_size);
+
+    // Evaluate and sparsify weights per block of points, in parallel
+    std::vector<SparseWeights> blocks(n_blocks);
+    #pragma omp parallel
+    {
+      std::vector<float> weights(n);
+      std::vector<uint>  order(n);
+
+      #pragma omp for schedule(dynamic)
+      for (int b = 0; b < static_cast<int>(n_blocks); ++b) {
+        auto &block = blocks[b];
+        uint first = b * dtl::deform_block_size;
+        uint last  = std::min(first + dtl::deform_block_size, static_cast<uint>(points.size()));
+        
+        for (uint i = first; i < last; ++i) {
+          eval_mvc(verts, points[i], weights);
+          
+          // Retain the top-k significant weights by magnitude, in vertex order, then
+          // renormalize retained weights
+          std::iota(range_iter(order), 0u);
+          std::partial_sort(order.begin(), order.begin() + std::min(k, n), order.end(), [&](uint a, uint b) {
+            return std::abs(weights[a]) > std::abs(weights[b]); });
+          std::sort(order.begin(), order.begin() + std::min(k, n));
+          float w_min = epsilon * std::ranges::max(weights, {}, [](float w) { return std::abs(w); });
+          
+          uint  row_first = block.indices.size();
+          float sum       = 0.f;
+          for (uint j : std::span(order).first(std::min(k, n))) {
+            guard_continue(std::abs(weights[j]) >= w_min);
+            block.indices.push_back(j);
+            block.weights.push_back(weights[j]);
+            sum += weights[j];
+          }
+
+          // Retained weights that cancel out, e.g. as large weights of opposing sign remain,
+          // cannot be renormalized; the row then keeps its dense, already normalized weights
+          if (!(std::abs(sum) >= dtl::deform_min_sum)) {
+            block.indices.resize(row_first);
+            block.weights.resize(row_first);
+            for (uint j = 0; j < n; ++j) {
+              block.indices.push_back(j);
+              block.weights.push_back(weights[j]);
+            }
+            sum = 1.f;
+          }
+          eig::Vector2f residual = points[i];
+          for (uint j = row_first; j < block.weights.size(); ++j) {
+            block.weights[j] /= sum;
+            residual -= block.weights[j] * verts[block.indices[j]];
+          }
+          block.residuals.push_back(residual);
+          block.offsets.push_back(block.indices.size());
+        }
+      }
+    }
+
+    // Concatenate blocks into a single matrix
+    SparseWeights out = { .n_verts = n };
+    out.offsets.reserve(points.size() + 1);
+    for (const auto &block : blocks) {
+      uint base = out.indices.size();
+      for (uint i = 1; i < block.offsets.size(); ++i)
+        out.offsets.push_back(base + block.offsets[i]);
+      out.indices.insert(out.indices.end(), range_iter(block.indices));
+      out.weights.insert(out.weights.end(), range_iter(block.weights));
+      out.residuals.insert(out.residuals.end(), range_iter(block.residuals));
+    }
+    return out;
+  }
+
+  void deform_points(const SparseWeights              &weights,
+                     std::span<const eig::Vector2f>   verts,
+                     std::span<eig::Vector2f>         out) {
+    dbg::check_expr(verts.size() == weights.n_verts, "deform_points(...) requires a position per cage vertex");
+    dbg::check_expr(out.size() >= weights.n_points(), "deform_points(...) output is too small");
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < static_cast<int>(weights.n_points()); ++i) {
+      eig::Vector2f p = weights.residuals[i];
+      for (uint j = weights.offsets[i]; j < weights.offsets[i + 1]; ++j)
+        p += weights.weights[j] * verts[weights.indices[j]];
+      out[i] = p;
+    }
+  }
+
+  ImageDeformer::ImageDeformer(std::span<const eig::Vector2f> verts_rest, ImageDeformerInfo info)
+  : m_info(info) {
+    dbg::check_expr((info.size > 1).all() && info.step > 0, 
+      "ImageDeformer(...) requires an image of at least 2x2 pixels and non-zero lattice step");
+
+    // Lattice covers the image at step spacing, including its last row/column
+    m_lattice_size = (info.size - 2) / info.step + 2;
+    m_lattice_src.resize(m_lattice_size.prod());
+    m_lattice_dst.resize(m_lattice_size.prod());
+    for (uint y = 0; y < m_lattice_size.y(); ++y)
+      for (uint x = 0; x < m_lattice_size.x(); ++x)
+        m_lattice_src[y * m_lattice_size.x() + x] 
+          = eig::Array2u(x, y).cwiseProduct(eig::Array2u(info.step, info.step)).min(info.size - 1).cast<float>();
+    
+    // Transform lattice from pixel space to polygon space, and precompute weights
+    eig::Array2f px_size = info.bounds.sizes().array() / info.size.cast<float>();
+    std::vector<eig::Vector2f> points(m_lattice_src.size());
+    std::ranges::transform(m_lattice_src, points.begin(), [&](const eig::Vector2f &p) {
+      return eig::Vector2f(info.bounds.min().x() + (p.x() + .5f) * px_size.x(),
+                           info.bounds.max().y() - (p.y() + .5f) * px_size.y()); });
+    m_weights = build_sparse_weights(verts_rest, points);
+  }
+
+  void ImageDeformer::deform(std::span<const eig::Vector2f>      verts,
+                             std::span<const eig::Array4<uchar>> src,
+                             std::span<eig::Array4<uchar>>       dst) {
+    const auto size = m_info.size;
+    dbg::check_expr(src.size() >= size.prod() && dst.size() >= size.prod(), 
+      "ImageDeformer::deform(...) requires source and target images of the deformer's size");
+    
+    // Deform lattice, then transform back from polygon space to pixel space
+    deform_points(m_weights, verts, m_lattice_dst);
+    eig::Array2f px_size = m_info.bounds.sizes().array() / size.cast<float>();
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < static_cast<int>(m_lattice_dst.size()); ++i) {
+      auto &p = m_lattice_dst[i];
+      p = eig::Vector2f((p.x() - m_info.bounds.min().x()) / px_size.x() - .5f,
+                        (m_info.bounds.max().y() - p.y()) / px_size.y() - .5f);
+    }
+
+    // Bin lattice cells by the raster bands they overlap
+    uint n_bands = ceil_div(size.y(), dtl::deform_band_size);
+    std::vector<std::vector<uint>> bins(n_bands);
+    for (uint y = 0; y + 1 < m_lattice_size.y(); ++y) {
+      for (uint x = 0; x + 1 < m_lattice_size.x(); ++x) {
+        uint i = y * m_lattice_size.x() + x;
+        float y_min = std::min({ m_lattice_dst[i].y(), m_lattice_dst[i + 1].y(),
+                                 m_lattice_dst[i + m_lattice_size.x()].y(), m_lattice_dst[i + m_lattice_size.x() + 1].y() });
+        float y_max = std::max({ m_lattice_dst[i].y(), m_lattice_dst[i + 1].y(),
+                                 m_lattice_dst[i + m_lattice_size.x()].y(), m_lattice_dst[i + m_lattice_size.x() + 1].y() });
+        guard_continue(y_max >= 0.f && y_min <= static_cast<float>(size.y() - 1));
+        uint band_min = static_cast<uint>(std::max(y_min, 0.f)) / dtl::deform_band_size;
+        uint band_max = std::min(static_cast<uint>(y_max) / dtl::deform_band_size, n_bands - 1);
+        for (uint b = band_min; b <= band_max; ++b)
+          bins[b].push_back(i);
+      }
+    }
+
+    // Rasterize bands in parallel; bands own disjoint rows of dst
+    #pragma omp parallel for schedule(dynamic)
+    for (int b = 0; b < static_cast<int>(n_bands); ++b) {
+      int y_min = b * dtl::deform_band_size;
+      int y_max = std::min(y_min + dtl::deform_band_size, size.y());
+      std::fill(dst.begin() + y_min * size.x(), dst.begin() + y_max * size.x(), eig::Array4<uchar>(0, 0, 0, 0));
+      
+      for (uint i : bins[b]) {
+        uint i10 = i + 1, i01 = i + m_lattice_size.x(), i11 = i01 + 1;
+        dtl::raster_triangle(m_lattice_dst[i], m_lattice_dst[i10], m_lattice_dst[i11],
+                             m_lattice_src[i], m_lattice_src[i10], m_lattice_src[i11],
+                             src, dst, size, y_min, y_max);
+        dtl::raster_triangle(m_lattice_dst[i], m_lattice_dst[i11], m_lattice_dst[i01],
+                             m_lattice_src[i], m_lattice_src[i11], m_lattice_src[i01],
+                             src, dst, size, y_min, y_max);
+      }
+    }
+  }
+} // namespace prg
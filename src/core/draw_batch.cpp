@@ -0,0 +1,68 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <core/draw_batch.hpp>
+#include <core/mesh.hpp>
+#include <core/mvc.hpp>
+
+namespace prg {
+  DrawBatch pack_draw_batch(const PolygonCollection &collection) {
+    const uint m = collection.size();
+    DrawBatch batch;
+
+    // Triangulate polygons concurrently; polygon sizes vary, so scheduling is dynamic
+    std::vector<std::vector<eig::Array3u>> elems(m);
+    #pragma omp parallel for schedule(dynamic)
+    for (int i = 0; i < static_cast<int>(m); ++i)
+      elems[i] = triangulate_polygon(collection.verts(i), collection.hole_offsets(i));
+
+    // Concatenate vertices, colors and triangles, and emit a command and rings per polygon
+    batch.commands.resize(m);
+    batch.polygons.resize(m);
+    for (uint i = 0; i < m; ++i) {
+      auto verts = collection.verts(i);
+      auto holes = collection.hole_offsets(i);
+      uint first = static_cast<uint>(batch.verts.size());
+
+      batch.commands[i] = { .count          = static_cast<uint>(elems[i].size()) * 3,
+                            .instance_count = 1,
+                            .first_index    = static_cast<uint>(batch.elems.size()) * 3,
+                            .base_vertex    = static_cast<int>(first),
+                            .base_instance  = i };
+      batch.polygons[i] = { .rings_first = static_cast<uint>(batch.rings.size()),
+                            .rings_size  = static_cast<uint>(holes.size()) + 1 };
+
+      // Ring signs are shared with eval_mvc(...)
+      auto signs = mvc_ring_signs(verts, holes);
+      for (uint r = 0; r <= holes.size(); ++r) {
+        auto [ring_first, ring_last] = polygon_ring(holes, verts.size(), r);
+        batch.rings.push_back({ .first = first + ring_first,
+                                .size  = ring_last - ring_first,
+                                .sign  = signs[r] });
+      }
+
+      batch.verts.insert(batch.verts.end(), range_iter(verts));
+      batch.colrs.insert(batch.colrs.end(), range_iter(collection.colrs(i)));
+      batch.elems.insert(batch.elems.end(), range_iter(elems[i]));
+    }
+
+    return batch;
+  }
+} // namespace prg
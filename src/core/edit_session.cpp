@@ -0,0 +1,331 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <core/edit_session.hpp>
+#include <core/mesh.hpp>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <span>
+#include <string_view>
+
+namespace prg {
+  namespace dtl {
+    // Names of edit types in json traces, indexed by EditType
+    constexpr std::array<std::string_view, 7> edit_type_names = {
+      "split_edge", "erase_vert", "move_vert", "set_colr", "set_settings", "undo", "redo"
+    };
+
+    // Whether an edit type carries a vertex index
+    constexpr bool is_indexed_edit(EditType type) {
+      return type == EditType::eEraseVert || type == EditType::eMoveVert || type == EditType::eSetColr;
+    }
+
+    std::vector<EditVertex> zip_edit_verts(std::span<const eig::Vector2f> verts, std::span<const eig::AlArray3f> colrs) {
+      std::vector<EditVertex> data(verts.size());
+      for (uint i = 0; i < verts.size(); ++i)
+        data[i] = { verts[i], colrs[i] };
+      return data;
+    }
+
+    nlohmann::json settings_to_json(const EditSettings &settings) {
+      return { { "draw_method",     static_cast<uint>(settings.draw_method)    },
+               { "draw_precision",  static_cast<uint>(settings.draw_precision) },
+               { "draw_lines",      settings.draw_lines                        },
+               { "auto_wachspress", settings.auto_wachspress                   } };
+    }
+
+    // Parse settings; enum values are range-checked, as they flow into shader uniforms
+    EditSettings settings_from_json(const nlohmann::json &js, const std::filesystem::path &path) {
+      uint draw_method    = js.at("draw_method").get<uint>();
+      uint draw_precision = js.at("draw_precision").get<uint>();
+      if (draw_method > static_cast<uint>(DrawMethod::eWachspress))
+        dtl::throw_keyed_error("load_edit_trace(...) failed", "trace contains an unknown draw method", {{ "path", path.string() }});
+      if (draw_precision > static_cast<uint>(MvcPrecision::eFast))
+        dtl::throw_keyed_error("load_edit_trace(...) failed", "trace contains an unknown draw precision", {{ "path", path.string() }});
+      return { .draw_method     = static_cast<DrawMethod>(draw_method),
+               .draw_precision  = static_cast<MvcPrecision>(draw_precision),
+               .draw_lines      = js.at("draw_lines").get<bool>(),
+               .auto_wachspress = js.at("auto_wachspress").get<bool>() };
+    }
+  } // namespace dtl
+
+  eig::ViewTransform edit_view_transform(eig::Array2f window_size) {
+    float aspect = window_size.x() / std::max(window_size.y(), 1.f);
+    auto  proj   = eig::ortho(-aspect, aspect, -1.f, 1.f, -1.f, 1.f);
+    return eig::ViewTransform(proj * eig::Affine3f(eig::Translation3f(-1.f, -1.f, 0.f) * eig::Scaling(2.f)),
+                              eig::Array2f::Zero(), window_size);
+  }
+
+  EditSession::EditSession(std::span<const eig::Vector2f>  verts,
+                           std::span<const eig::AlArray3f> colrs,
+                           EditSettings                    settings)
+  : m_polygon(verts, colrs),
+    m_verts(range_iter(verts)),
+    m_colrs(range_iter(colrs)),
+    m_settings(settings),
+    m_history(dtl::zip_edit_verts(verts, colrs)) { }
+
+  void EditSession::restore(const ChunkedVector<EditVertex> &from, const ChunkedVector<EditVertex> &to) {
+    m_revision++;
+
+    // Structural change; rebuild flat buffers and polygon in O(n)
+    if (!std::ranges::equal(from.offsets(), to.offsets())) {
+      std::vector<EditVertex> data;
+      to.flatten(data);
+      m_verts.resize(data.size());
+      m_colrs.resize(data.size());
+      for (uint i = 0; i < data.size(); ++i) {
+        m_verts[i] = data[i].vert;
+        m_colrs[i] = data[i].colr;
+      }
+      m_polygon = EditablePolygon(m_verts, m_colrs);
+      m_structure_revision++;
+      return;
+    }
+
+    // Matching layouts; patch values in chunks the versions do not share
+    auto offsets = to.offsets();
+    for (uint c = 0; c < to.chunks().size(); ++c) {
+      guard_continue(from.chunks()[c] != to.chunks()[c]);
+      const auto &chunk = *to.chunks()[c];
+      for (uint j = 0; j < chunk.size(); ++j) {
+        uint i = offsets[c] + j;
+        if (m_verts[i] != chunk[j].vert) {
+          m_verts[i] = chunk[j].vert;
+          m_polygon.set_vert(i, chunk[j].vert);
+        }
+        if ((m_colrs[i] != chunk[j].colr).any()) {
+          m_colrs[i] = chunk[j].colr;
+          m_polygon.set_colr(i, chunk[j].colr);
+        }
+      }
+    }
+  }
+
+  void EditSession::apply(const EditEvent &event) {
+    if (dtl::is_indexed_edit(event.type) && event.index >= m_verts.size())
+      dtl::throw_keyed_error("EditSession::apply(...) failed", "edit refers to a vertex out of range");
+
+    // Polygon edits begin a new undo step, unless they continue the open step's drag
+    bool is_polygon_edit = event.type != EditType::eSetSettings
+                        && event.type != EditType::eUndo
+                        && event.type != EditType::eRedo;
+    if (is_polygon_edit) {
+      bool is_continued = m_is_step_open
+                       && (event.type == EditType::eMoveVert || event.type == EditType::eSetColr)
+                       && event.type  == m_step_event.type
+                       && event.index == m_step_event.index
+                       && m_frame     <= m_step_event.frame + 1;
+      if (!is_continued)
+        m_history.begin_step();
+      m_is_step_open = true;
+      m_step_event   = { .frame = m_frame, .type = event.type, .index = event.index };
+    }
+
+    auto &version = m_history.current();
+    switch (event.type) {
+      case EditType::eSplitEdge: {
+        // The treap finds the edge and the inserted vertex's position; flat buffers
+        // take the same insert, instead of a full flatten
+        uint i = m_polygon.split_longest_edge();
+        m_verts.insert(m_verts.begin() + i, m_polygon.vert(i));
+        m_colrs.insert(m_colrs.begin() + i, m_polygon.colr(i));
+        version.insert(i, { m_verts[i], m_colrs[i] });
+        break;
+      }
+      case EditType::eEraseVert:
+        m_polygon.erase(event.index);
+        m_verts.erase(m_verts.begin() + event.index);
+        m_colrs.erase(m_colrs.begin() + event.index);
+        version.erase(event.index);
+        break;
+      case EditType::eMoveVert:
+        m_polygon.set_vert(event.index, event.vert);
+        m_verts[event.index] = event.vert;
+        version.set(event.index, { m_verts[event.index], m_colrs[event.index] });
+        break;
+      case EditType::eSetColr:
+        m_polygon.set_colr(event.index, event.colr);
+        m_colrs[event.index] = event.colr;
+        version.set(event.index, { m_verts[event.index], m_colrs[event.index] });
+        break;
+      case EditType::eSetSettings:
+        m_settings = event.settings;
+        break;
+      case EditType::eUndo:
+      case EditType::eRedo: {
+        m_is_step_open = false;
+        bool is_undo = event.type == EditType::eUndo;
+        guard_break(is_undo ? m_history.can_undo() : m_history.can_redo());
+        const auto &from = m_history.current();
+        restore(from, is_undo ? m_history.undo() : m_history.redo());
+        break;
+      }
+    }
+    if (is_polygon_edit)
+      m_revision++;
+    if (event.type == EditType::eSplitEdge || event.type == EditType::eEraseVert)
+      m_structure_revision++;
+
+    guard(m_is_recording);
+    auto &recorded = m_trace.events.emplace_back(event);
+    recorded.frame = m_frame - m_record_frame;
+  }
+
+  void EditSession::update_draw(EditFrame &frame, bool is_preview, std::optional<uint> pinned) const {
+    // Draw a coarse level while previewing large polygons; the full polygon's data goes stale,
+    // and is regenerated once previewing stops
+    frame.is_preview = is_preview && m_verts.size() > edit_preview_verts;
+    bool is_convex;
+    if (frame.is_preview) {
+      if (frame.lod_revision != m_structure_revision) {
+        frame.lod          = build_polygon_lod(m_verts, { .min_verts = edit_preview_verts / 4 });
+        frame.lod_revision = m_structure_revision;
+      }
+      extract_lod_level(select_lod_level(frame.lod, edit_preview_verts), m_verts, m_colrs,
+                        frame.preview_verts, frame.preview_colrs, pinned);
+      frame.preview_elems = triangulate_polygon(frame.preview_verts);
+      is_convex           = is_convex_polygon(frame.preview_verts);
+    } else {
+      if (frame.draw_revision != m_revision) {
+        frame.elems         = triangulate_polygon(m_verts, { }, TriangulateMode::eParallel);
+        frame.is_convex     = is_convex_polygon(m_verts);
+        frame.draw_revision = m_revision;
+      }
+      is_convex = frame.is_convex;
+    }
+
+    // Wachspress coordinates replace mean value coordinates on convex polygons, as they
+    // avoid trigonometry
+    frame.draw_method = m_settings.draw_method;
+    if (frame.draw_method == DrawMethod::eMeanValueCoords && m_settings.auto_wachspress && is_convex)
+      frame.draw_method = DrawMethod::eWachspress;
+  }
+
+  bool EditSession::update_pick(EditFrame &frame, const eig::ViewTransform &view, float radius) const {
+    guard(frame.pick_revision != m_revision
+       || view.matrix() != frame.pick_view.matrix()
+       || (view.size() != frame.pick_view.size()).any(), false);
+
+    std::vector<eig::Vector2f> verts_window(m_verts.size());
+    view.world_to_window(m_verts, verts_window);
+    frame.pick_grid     = PointGrid(verts_window, radius);
+    frame.pick_view     = view;
+    frame.pick_revision = m_revision;
+    return true;
+  }
+
+  void EditSession::start_recording(eig::Array2u window_size) {
+    m_is_recording = true;
+    m_record_frame = m_frame;
+    m_trace = { .window_size = window_size,
+                .settings    = m_settings,
+                .verts       = m_verts,
+                .colrs       = m_colrs };
+  }
+
+  EditTrace EditSession::stop_recording() {
+    dbg::check_expr(m_is_recording, "EditSession::stop_recording() called without active recording");
+    m_is_recording = false;
+    m_trace.frames = m_frame - m_record_frame + 1;
+    return std::move(m_trace);
+  }
+
+  void save_edit_trace(const std::filesystem::path &path, const EditTrace &trace) {
+    nlohmann::json js = {
+      { "window_size", { trace.window_size.x(), trace.window_size.y() } },
+      { "frames",      trace.frames                                     },
+      { "settings",    dtl::settings_to_json(trace.settings)            },
+      { "verts",       nlohmann::json::array()                          },
+      { "colrs",       nlohmann::json::array()                          },
+      { "events",      nlohmann::json::array()                          }
+    };
+    for (const auto &v : trace.verts)
+      js["verts"].push_back({ v.x(), v.y() });
+    for (const auto &c : trace.colrs)
+      js["colrs"].push_back({ c.x(), c.y(), c.z() });
+
+    // Events only store members used by their type
+    for (const auto &event : trace.events) {
+      nlohmann::json js_event = { { "frame", event.frame },
+                                  { "type",  dtl::edit_type_names[static_cast<uint>(event.type)] } };
+      if (dtl::is_indexed_edit(event.type))
+        js_event["index"] = event.index;
+      if (event.type == EditType::eMoveVert)
+        js_event["vert"] = { event.vert.x(), event.vert.y() };
+      if (event.type == EditType::eSetColr)
+        js_event["colr"] = { event.colr.x(), event.colr.y(), event.colr.z() };
+      if (event.type == EditType::eSetSettings)
+        js_event["settings"] = dtl::settings_to_json(event.settings);
+      js["events"].push_back(std::move(js_event));
+    }
+
+    std::ofstream out(path);
+    if (!out)
+      dtl::throw_keyed_error("save_edit_trace(...) failed", "could not open output file", {{ "path", path.string() }});
+    out << js.dump(1);
+  }
+
+  EditTrace load_edit_trace(const std::filesystem::path &path) {
+    std::ifstream in(path);
+    if (!in)
+      dtl::throw_keyed_error("load_edit_trace(...) failed", "could not open input file", {{ "path", path.string() }});
+
+    try {
+      auto js = nlohmann::json::parse(in);
+      EditTrace trace = { .window_size = { js.at("window_size").at(0).get<uint>(),
+                                           js.at("window_size").at(1).get<uint>() },
+                          .frames      = js.at("frames").get<uint>(),
+                          .settings    = dtl::settings_from_json(js.at("settings"), path) };
+      for (const auto &v : js.at("verts"))
+        trace.verts.push_back({ v.at(0).get<float>(), v.at(1).get<float>() });
+      for (const auto &c : js.at("colrs"))
+        trace.colrs.push_back({ c.at(0).get<float>(), c.at(1).get<float>(), c.at(2).get<float>() });
+
+      for (const auto &js_event : js.at("events")) {
+        auto type = std::ranges::find(dtl::edit_type_names, js_event.at("type").get<std::string>());
+        if (type == dtl::edit_type_names.end())
+          dtl::throw_keyed_error("load_edit_trace(...) failed", "trace contains an unknown edit type", {{ "path", path.string() }});
+
+        EditEvent event = { .frame = js_event.at("frame").get<uint>(),
+                            .type  = static_cast<EditType>(std::distance(dtl::edit_type_names.begin(), type)),
+                            .index = js_event.value("index", 0u) };
+        if (event.type == EditType::eMoveVert)
+          event.vert = { js_event.at("vert").at(0).get<float>(), js_event.at("vert").at(1).get<float>() };
+        if (event.type == EditType::eSetColr)
+          event.colr = { js_event.at("colr").at(0).get<float>(), js_event.at("colr").at(1).get<float>(),
+                         js_event.at("colr").at(2).get<float>() };
+        if (event.type == EditType::eSetSettings)
+          event.settings = dtl::settings_from_json(js_event.at("settings"), path);
+        trace.events.push_back(event);
+      }
+
+      if (trace.verts.size() < 3 || trace.verts.size() != trace.colrs.size())
+        dtl::throw_keyed_error("load_edit_trace(...) failed", "trace polygon is malformed", {{ "path", path.string() }});
+      if (!std::ranges::is_sorted(trace.events, { }, &EditEvent::frame))
+        dtl::throw_keyed_error("load_edit_trace(...) failed", "trace events are not sorted by frame", {{ "path", path.string() }});
+      return trace;
+    } catch (const nlohmann::json::exception &e) {
+      dtl::throw_keyed_error("load_edit_trace(...) failed", e.what(), {{ "path", path.string() }});
+    }
+  }
+} // namespace prg
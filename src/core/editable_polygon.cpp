@@ -0,0 +1,216 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <core/editable_polygon.hpp>
+#include <algorithm>
+
+namespace prg {
+  uint EditablePolygon::alloc_node(const eig::Vector2f &vert, const eig::AlArray3f &colr) {
+    // xorshift32 for treap priorities
+    m_seed ^= m_seed << 13;
+    m_seed ^= m_seed >> 17;
+    m_seed ^= m_seed << 5;
+
+    uint t;
+    if (!m_free.empty()) {
+      t = m_free.back();
+      m_free.pop_back();
+    } else {
+      t = static_cast<uint>(m_nodes.size());
+      m_nodes.emplace_back();
+    }
+    m_nodes[t] = { .vert = vert, .colr = colr, .priority = m_seed, .first = t, .last = t };
+    return t;
+  }
+
+  void EditablePolygon::pull(uint t) {
+    auto &node = m_nodes[t];
+    const auto &l = m_nodes[node.left], &r = m_nodes[node.right];
+    const uint size_l = node.left ? l.size : 0;
+
+    node.size  = 1 + size_l + (node.right ? r.size : 0);
+    node.first = node.left  ? l.first : t;
+    node.last  = node.right ? r.last  : t;
+
+    // Longest edge over left subtree, edges joining t to its neighbours, and right subtree
+    node.edge_max   = -1.f;
+    node.edge_max_i = 0;
+    auto consider = [&](float edge, uint i) {
+      guard(edge > node.edge_max);
+      node.edge_max   = edge;
+      node.edge_max_i = i;
+    };
+    if (node.left) {
+      consider(l.edge_max, l.edge_max_i);
+      consider((node.vert - m_nodes[l.last].vert).squaredNorm(), size_l - 1);
+    }
+    if (node.right) {
+      consider((m_nodes[r.first].vert - node.vert).squaredNorm(), size_l);
+      consider(r.edge_max, size_l + 1 + r.edge_max_i);
+    }
+  }
+
+  std::pair<uint, uint> EditablePolygon::split(uint t, uint i) {
+    guard(t, { 0, 0 });
+    auto &node = m_nodes[t];
+    uint size_l = node.left ? m_nodes[node.left].size : 0;
+    if (i <= size_l) {
+      auto [a, b] = split(node.left, i);
+      m_nodes[t].left = b;
+      pull(t);
+      return { a, t };
+    } else {
+      auto [a, b] = split(node.right, i - size_l - 1);
+      m_nodes[t].right = a;
+      pull(t);
+      return { t, b };
+    }
+  }
+
+  uint EditablePolygon::merge(uint a, uint b) {
+    guard(a, b);
+    guard(b, a);
+    if (m_nodes[a].priority > m_nodes[b].priority) {
+      m_nodes[a].right = merge(m_nodes[a].right, b);
+      pull(a);
+      return a;
+    } else {
+      m_nodes[b].left = merge(a, m_nodes[b].left);
+      pull(b);
+      return b;
+    }
+  }
+
+  uint EditablePolygon::find(uint i) const {
+    dbg::check_expr(i < size(), "EditablePolygon position out of range");
+    uint t = m_root;
+    while (true) {
+      const auto &node = m_nodes[t];
+      uint size_l = node.left ? m_nodes[node.left].size : 0;
+      if (i == size_l)
+        return t;
+      if (i < size_l) {
+        t = node.left;
+      } else {
+        t = node.right;
+        i -= size_l + 1;
+      }
+    }
+  }
+
+  template <typename F>
+  void EditablePolygon::update(uint t, uint i, F &&f) {
+    uint size_l = m_nodes[t].left ? m_nodes[m_nodes[t].left].size : 0;
+    if (i < size_l)
+      update(m_nodes[t].left, i, f);
+    else if (i > size_l)
+      update(m_nodes[t].right, i - size_l - 1, f);
+    else
+      f(m_nodes[t]);
+    pull(t);
+  }
+
+  EditablePolygon::EditablePolygon(std::span<const eig::Vector2f>  verts,
+                                   std::span<const eig::AlArray3f> colrs) {
+    dbg::check_expr(verts.size() == colrs.size(), "EditablePolygon(...) requires a color per vertex");
+    m_nodes.reserve(verts.size() + 1);
+
+    // Build the treap in O(n) as a cartesian tree over random priorities; the right spine
+    // is kept on a stack, and subtrees are pulled once they leave it
+    std::vector<uint> spine;
+    for (uint i = 0; i < verts.size(); ++i) {
+      uint t = alloc_node(verts[i], colrs[i]), last = 0;
+      while (!spine.empty() && m_nodes[spine.back()].priority < m_nodes[t].priority) {
+        last = spine.back();
+        spine.pop_back();
+        pull(last);
+      }
+      m_nodes[t].left = last;
+      if (!spine.empty())
+        m_nodes[spine.back()].right = t;
+      spine.push_back(t);
+    }
+    for (auto it = spine.rbegin(); it != spine.rend(); ++it)
+      pull(*it);
+    m_root = spine.empty() ? 0 : spine.front();
+  }
+
+  void EditablePolygon::set_vert(uint i, const eig::Vector2f &vert) {
+    dbg::check_expr(i < size(), "EditablePolygon position out of range");
+    update(m_root, i, [&](Node &node) { node.vert = vert; });
+  }
+
+  void EditablePolygon::set_colr(uint i, const eig::AlArray3f &colr) {
+    dbg::check_expr(i < size(), "EditablePolygon position out of range");
+    update(m_root, i, [&](Node &node) { node.colr = colr; });
+  }
+
+  void EditablePolygon::insert(uint i, const eig::Vector2f &vert, const eig::AlArray3f &colr) {
+    dbg::check_expr(i <= size(), "EditablePolygon position out of range");
+    uint t = alloc_node(vert, colr);
+    auto [a, b] = split(m_root, i);
+    m_root = merge(merge(a, t), b);
+  }
+
+  void EditablePolygon::erase(uint i) {
+    dbg::check_expr(i < size(), "EditablePolygon position out of range");
+    auto [a, bc] = split(m_root, i);
+    auto [b, c]  = split(bc, 1);
+    m_free.push_back(b);
+    m_root = merge(a, c);
+  }
+
+  uint EditablePolygon::longest_edge() const {
+    dbg::check_expr(size() >= 2, "EditablePolygon::longest_edge() requires two vertices");
+    const auto &root = m_nodes[m_root];
+    float edge_closing = (m_nodes[root.first].vert - m_nodes[root.last].vert).squaredNorm();
+    return edge_closing > root.edge_max ? root.size - 1 : root.edge_max_i;
+  }
+
+  uint EditablePolygon::split_longest_edge() {
+    uint i = longest_edge(), j = (i + 1 == size()) ? 0 : i + 1;
+    const auto &a = m_nodes[find(i)], &b = m_nodes[find(j)];
+    eig::Vector2f  vert = .5f * (a.vert + b.vert);
+    eig::AlArray3f colr = .5f * (a.colr + b.colr);
+    insert(i + 1, vert, colr);
+    return i + 1;
+  }
+
+  void EditablePolygon::flatten(std::vector<eig::Vector2f>  &verts,
+                                std::vector<eig::AlArray3f> &colrs) const {
+    verts.clear();
+    colrs.clear();
+    verts.reserve(size());
+    colrs.reserve(size());
+
+    // Iterative in-order traversal
+    std::vector<uint> stack;
+    uint t = m_root;
+    while (t || !stack.empty()) {
+      for (; t; t = m_nodes[t].left)
+        stack.push_back(t);
+      t = stack.back();
+      stack.pop_back();
+      verts.push_back(m_nodes[t].vert);
+      colrs.push_back(m_nodes[t].colr);
+      t = m_nodes[t].right;
+    }
+  }
+} // namespace prg
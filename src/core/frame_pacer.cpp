@@ -0,0 +1,186 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <core/frame_pacer.hpp>
+#include <GLFW/glfw3.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#ifdef _WIN32
+  #define NOMINMAX
+  #define WIN32_LEAN_AND_MEAN
+  #include <windows.h>
+#else
+  #include <time.h>
+#endif
+
+namespace prg {
+  namespace dtl {
+    // Shortest timeout passed to glfwWaitEventsTimeout, in seconds
+    constexpr double frame_pacer_min_timeout = 1e-6;
+
+    // Nr. of window events received since last checked by a pacer
+    std::atomic<uint> frame_pacer_events    = 0;
+    bool              frame_pacer_installed = false;
+
+    // Previously installed callbacks, called after counting an event
+    GLFWwindowrefreshfun   prev_refresh_callback;
+    GLFWframebuffersizefun prev_framebuffer_size_callback;
+    GLFWwindowfocusfun     prev_focus_callback;
+    GLFWcursorposfun       prev_cursor_pos_callback;
+    GLFWcursorenterfun     prev_cursor_enter_callback;
+    GLFWmousebuttonfun     prev_mouse_button_callback;
+    GLFWscrollfun          prev_scroll_callback;
+    GLFWkeyfun             prev_key_callback;
+    GLFWcharfun            prev_char_callback;
+
+    template <auto *prev_callback, typename... Args>
+    void count_event_callback(Args... args) {
+      frame_pacer_events.fetch_add(1, std::memory_order_relaxed);
+      if (*prev_callback)
+        (*prev_callback)(args...);
+    }
+
+    // Process cpu time over all threads, in seconds
+    inline
+    double process_cpu_time() {
+#ifdef _WIN32
+      FILETIME creation, exit, kernel, user;
+      GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user);
+      auto to_ticks = [](FILETIME t) { return (uint64_t(t.dwHighDateTime) << 32) | t.dwLowDateTime; };
+      return static_cast<double>(to_ticks(kernel) + to_ticks(user)) * 1e-7; // 100ns ticks
+#else
+      timespec t;
+      clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &t);
+      return static_cast<double>(t.tv_sec) + static_cast<double>(t.tv_nsec) * 1e-9;
+#endif
+    }
+
+    // Block until an event arrives or a deadline passes; GLFW rejects non-positive timeouts,
+    // so a deadline that passed since it was checked returns at once, and short waits round up
+    inline
+    void wait_events_until(std::chrono::steady_clock::time_point deadline) {
+      double timeout = std::chrono::duration<double>(deadline - std::chrono::steady_clock::now()).count();
+      guard(timeout > 0.0);
+      glfwWaitEventsTimeout(std::max(timeout, frame_pacer_min_timeout));
+    }
+  } // namespace dtl
+
+  FramePacer::FramePacer(const gl::Window &window, FramePacerCreateInfo info)
+  : m_info(info),
+    m_window((GLFWwindow *) window.object()),
+    m_frames_pending(info.settle_frames),
+    m_frame_last(clock::now()),
+    m_stats_wall(clock::now()),
+    m_stats_cpu(dtl::process_cpu_time()) {
+    using namespace dtl;
+
+    // Only one window's callbacks can be chained, as callback state is global
+    dbg::check_expr(!frame_pacer_installed, "FramePacer(...) supports only a single pacer per process");
+    frame_pacer_installed = true;
+
+    // Chain event counting in front of existing callbacks; ImGui, initialized later, chains
+    // its callbacks in front of these in turn
+    prev_refresh_callback          = glfwSetWindowRefreshCallback(m_window,   count_event_callback<&prev_refresh_callback, GLFWwindow *>);
+    prev_framebuffer_size_callback = glfwSetFramebufferSizeCallback(m_window, count_event_callback<&prev_framebuffer_size_callback, GLFWwindow *, int, int>);
+    prev_focus_callback            = glfwSetWindowFocusCallback(m_window,     count_event_callback<&prev_focus_callback, GLFWwindow *, int>);
+    prev_cursor_pos_callback       = glfwSetCursorPosCallback(m_window,       count_event_callback<&prev_cursor_pos_callback, GLFWwindow *, double, double>);
+    prev_cursor_enter_callback     = glfwSetCursorEnterCallback(m_window,     count_event_callback<&prev_cursor_enter_callback, GLFWwindow *, int>);
+    prev_mouse_button_callback     = glfwSetMouseButtonCallback(m_window,     count_event_callback<&prev_mouse_button_callback, GLFWwindow *, int, int, int>);
+    prev_scroll_callback           = glfwSetScrollCallback(m_window,          count_event_callback<&prev_scroll_callback, GLFWwindow *, double, double>);
+    prev_key_callback              = glfwSetKeyCallback(m_window,             count_event_callback<&prev_key_callback, GLFWwindow *, int, int, int, int>);
+    prev_char_callback             = glfwSetCharCallback(m_window,            count_event_callback<&prev_char_callback, GLFWwindow *, unsigned int>);
+
+    set_vsync(m_info.vsync);
+  }
+
+  void FramePacer::wait_frame(gl::Window &window) {
+    auto   wait_start = clock::now();
+    double cpu_start  = dtl::process_cpu_time();
+
+    if (m_info.mode == RedrawMode::eContinuous) {
+      window.poll_events();
+    } else {
+      while (!window.should_close()) {
+        // Any event received while waiting invalidates the next few frames
+        if (dtl::frame_pacer_events.exchange(0, std::memory_order_relaxed))
+          m_frames_pending = std::max(m_frames_pending, m_info.settle_frames);
+
+        // Scheduled redraws invalidate a frame once their deadline passes
+        if (m_deadline && clock::now() >= *m_deadline) {
+          m_deadline.reset();
+          invalidate();
+        }
+        guard_break(m_frames_pending == 0);
+
+        // Block until an event arrives, or until the next scheduled redraw
+        if (m_deadline)
+          dtl::wait_events_until(*m_deadline);
+        else
+          glfwWaitEvents();
+        window.poll_events();
+      }
+    }
+
+    // Hold the next frame back until the frame budget has passed, handling events meanwhile
+    if (m_info.frame_budget > 0.f) {
+      auto frame_next = m_frame_last + std::chrono::duration_cast<clock::duration>(
+                                         std::chrono::duration<float>(m_info.frame_budget));
+      while (clock::now() < frame_next && !window.should_close())
+        dtl::wait_events_until(frame_next);
+      window.poll_events();
+    }
+
+    m_frames_pending = m_frames_pending > 0 ? m_frames_pending - 1 : 0;
+    m_frame_last = clock::now();
+
+    // Accumulate statistics, and publish them once per interval
+    m_idle_wall += std::chrono::duration<double>(m_frame_last - wait_start).count();
+    m_idle_cpu  += dtl::process_cpu_time() - cpu_start;
+    m_stats_frames++;
+    if (double wall = std::chrono::duration<double>(m_frame_last - m_stats_wall).count(); wall >= 1.0) {
+      double cpu = dtl::process_cpu_time();
+      m_stats = { .frame_rate     = static_cast<float>(m_stats_frames / wall),
+                  .cpu_usage      = static_cast<float>((cpu - m_stats_cpu) / wall),
+                  .idle_cpu_usage = static_cast<float>(m_idle_cpu / std::max(m_idle_wall, 1e-6)) };
+      m_stats_wall   = m_frame_last;
+      m_stats_cpu    = cpu;
+      m_idle_wall    = 0.0;
+      m_idle_cpu     = 0.0;
+      m_stats_frames = 0;
+    }
+  }
+
+  void FramePacer::invalidate_after(float seconds) {
+    auto deadline = clock::now() + std::chrono::duration_cast<clock::duration>(std::chrono::duration<float>(seconds));
+    if (!m_deadline || deadline < *m_deadline)
+      m_deadline = deadline;
+  }
+
+  void FramePacer::set_mode(RedrawMode mode) {
+    m_info.mode = mode;
+    invalidate();
+  }
+
+  void FramePacer::set_vsync(bool vsync) {
+    m_info.vsync = vsync;
+    glfwSwapInterval(vsync ? 1 : 0);
+  }
+} // namespace prg
@@ -0,0 +1,276 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <core/gpu_ring.hpp>
+#include <glad/glad.h>
+#include <algorithm>
+#include <cstring>
+#include <utility>
+
+namespace prg {
+  namespace dtl {
+    // Counts since counters were installed, and glad's original entry points
+    GlObjectCounts gl_object_counts;
+    bool           gl_object_counters_installed = false;
+
+    PFNGLCREATEBUFFERSPROC      prev_create_buffers;
+    PFNGLGENBUFFERSPROC         prev_gen_buffers;
+    PFNGLCREATEVERTEXARRAYSPROC prev_create_arrays;
+    PFNGLGENVERTEXARRAYSPROC    prev_gen_arrays;
+    PFNGLCREATETEXTURESPROC     prev_create_textures;
+    PFNGLGENTEXTURESPROC        prev_gen_textures;
+    PFNGLCREATEFRAMEBUFFERSPROC prev_create_framebuffers;
+    PFNGLGENFRAMEBUFFERSPROC    prev_gen_framebuffers;
+    PFNGLCREATEPROGRAMPROC      prev_create_program;
+    PFNGLCREATESHADERPROC       prev_create_shader;
+    PFNGLFENCESYNCPROC          prev_fence_sync;
+
+    template <auto *prev, uint GlObjectCounts::*count>
+    void APIENTRY count_gen_objects(GLsizei n, GLuint *objects) {
+      gl_object_counts.*count += n;
+      (*prev)(n, objects);
+    }
+
+    void APIENTRY count_create_textures(GLenum target, GLsizei n, GLuint *objects) {
+      gl_object_counts.textures += n;
+      prev_create_textures(target, n, objects);
+    }
+
+    GLuint APIENTRY count_create_program() {
+      gl_object_counts.programs++;
+      return prev_create_program();
+    }
+
+    GLuint APIENTRY count_create_shader(GLenum type) {
+      gl_object_counts.programs++;
+      return prev_create_shader(type);
+    }
+
+    GLsync APIENTRY count_fence_sync(GLenum condition, GLbitfield flags) {
+      gl_object_counts.fences++;
+      return prev_fence_sync(condition, flags);
+    }
+
+    // Wait on a fence until it is signalled, then delete it; returns whether the wait blocked
+    bool wait_fence(void *fence) {
+      auto sync = static_cast<GLsync>(fence);
+      GLenum status = glClientWaitSync(sync, 0, 0);
+      bool is_stalled = status == GL_TIMEOUT_EXPIRED;
+      while (status == GL_TIMEOUT_EXPIRED)
+        status = glClientWaitSync(sync, GL_SYNC_FLUSH_COMMANDS_BIT, 1'000'000'000);
+      glDeleteSync(sync);
+      return is_stalled;
+    }
+
+    constexpr size_t align_up(size_t size, size_t align) {
+      return ceil_div(size, align) * align;
+    }
+  } // namespace dtl
+
+  void install_gl_object_counters() {
+    using namespace dtl;
+    guard(!gl_object_counters_installed);
+    gl_object_counters_installed = true;
+
+    prev_create_buffers      = std::exchange(glad_glCreateBuffers,      count_gen_objects<&prev_create_buffers,      &GlObjectCounts::buffers>);
+    prev_gen_buffers         = std::exchange(glad_glGenBuffers,         count_gen_objects<&prev_gen_buffers,         &GlObjectCounts::buffers>);
+    prev_create_arrays       = std::exchange(glad_glCreateVertexArrays, count_gen_objects<&prev_create_arrays,       &GlObjectCounts::arrays>);
+    prev_gen_arrays          = std::exchange(glad_glGenVertexArrays,    count_gen_objects<&prev_gen_arrays,          &GlObjectCounts::arrays>);
+    prev_create_framebuffers = std::exchange(glad_glCreateFramebuffers, count_gen_objects<&prev_create_framebuffers, &GlObjectCounts::framebuffers>);
+    prev_gen_framebuffers    = std::exchange(glad_glGenFramebuffers,    count_gen_objects<&prev_gen_framebuffers,    &GlObjectCounts::framebuffers>);
+    prev_gen_textures        = std::exchange(glad_glGenTextures,        count_gen_objects<&prev_gen_textures,        &GlObjectCounts::textures>);
+    prev_create_textures     = std::exchange(glad_glCreateTextures,     count_create_textures);
+    prev_create_program      = std::exchange(glad_glCreateProgram,      count_create_program);
+    prev_create_shader       = std::exchange(glad_glCreateShader,       count_create_shader);
+    prev_fence_sync          = std::exchange(glad_glFenceSync,          count_fence_sync);
+  }
+
+  GlObjectCounts gl_object_counts() {
+    return dtl::gl_object_counts;
+  }
+
+  GpuRing::GpuRing(GpuRingCreateInfo info) {
+    // Ranges bound as uniform or storage blocks need aligned offsets
+    GLint align_uniform = 1, align_storage = 1;
+    glGetIntegerv(GL_UNIFORM_BUFFER_OFFSET_ALIGNMENT,        &align_uniform);
+    glGetIntegerv(GL_SHADER_STORAGE_BUFFER_OFFSET_ALIGNMENT, &align_storage);
+    m_align = static_cast<size_t>(std::max({ align_uniform, align_storage, 16 }));
+
+    create(info.slot_size, std::max(info.slots, 1u));
+  }
+
+  GpuRing::~GpuRing() {
+    destroy();
+  }
+
+  void GpuRing::create(size_t slot_size, uint slots) {
+    m_slot_size = dtl::align_up(std::max<size_t>(slot_size, m_align), m_align);
+    m_fences.assign(slots, nullptr);
+    m_slot    = 0;
+    m_head    = 0;
+    m_is_open = false;
+
+    // Immutable storage, mapped once for the buffer's lifetime; coherent mapping makes
+    // writes visible to subsequent commands without explicit flushes
+    constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+    glCreateBuffers(1, &m_object);
+    glNamedBufferStorage(m_object, static_cast<GLsizeiptr>(m_slot_size * slots), nullptr, flags);
+    m_mapped = static_cast<std::byte *>(glMapNamedBufferRange(m_object, 0, static_cast<GLsizeiptr>(m_slot_size * slots), flags));
+    dbg::check_expr(m_mapped, "GpuRing(...) could not map buffer storage");
+  }
+
+  void GpuRing::destroy() {
+    guard(m_object);
+    for (void *fence : m_fences)
+      if (fence)
+        dtl::wait_fence(fence);
+    m_fences.clear();
+    glUnmapNamedBuffer(m_object);
+    glDeleteBuffers(1, &m_object);
+    m_object = 0;
+    m_mapped = nullptr;
+  }
+
+  void GpuRing::begin_frame(size_t size, uint n_pushes) {
+    dbg::check_expr(m_object, "GpuRing::begin_frame(...) called on an uninitialized ring");
+
+    // The previous frame's commands were submitted; guard its slot
+    if (m_is_open)
+      m_fences[m_slot] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+
+    // Grow all slots if the frame does not fit; waits for all frames in flight
+    size_t required = size + static_cast<size_t>(n_pushes) * m_align;
+    if (required > m_slot_size) {
+      uint slots = this->slots();
+      destroy();
+      create(std::max(required, 2 * m_slot_size), slots);
+      m_grows++;
+    } else {
+      m_slot = (m_slot + 1) % slots();
+    }
+
+    // Wait until the gpu released the slot
+    if (void *fence = std::exchange(m_fences[m_slot], nullptr); fence)
+      m_stalls += dtl::wait_fence(fence);
+    m_head    = 0;
+    m_is_open = true;
+  }
+
+  size_t GpuRing::push(std::span<const std::byte> data) {
+    dbg::check_expr(m_is_open, "GpuRing::push(...) requires begin_frame(...)");
+    m_head = dtl::align_up(m_head, m_align);
+    dbg::check_expr(m_head + data.size() <= m_slot_size, "GpuRing::push(...) exceeds the size given to begin_frame(...)");
+
+    size_t offset = m_slot * m_slot_size + m_head;
+    if (!data.empty())
+      std::memcpy(m_mapped + offset, data.data(), data.size());
+    m_head += data.size();
+    return offset;
+  }
+
+  void GpuRing::swap(GpuRing &o) {
+    using std::swap;
+    swap(m_object,    o.m_object);
+    swap(m_mapped,    o.m_mapped);
+    swap(m_slot_size, o.m_slot_size);
+    swap(m_align,     o.m_align);
+    swap(m_slot,      o.m_slot);
+    swap(m_head,      o.m_head);
+    swap(m_is_open,   o.m_is_open);
+    swap(m_fences,    o.m_fences);
+    swap(m_stalls,    o.m_stalls);
+    swap(m_grows,     o.m_grows);
+  }
+
+  DrawUploads::DrawUploads(GpuRingCreateInfo info)
+  : m_ring(info) {
+    // Vertex array layout; buffers are attached per upload
+    glCreateVertexArrays(1, &m_array);
+    glEnableVertexArrayAttrib(m_array, 0);
+    glEnableVertexArrayAttrib(m_array, 1);
+    glVertexArrayAttribFormat(m_array, 0, 2, GL_FLOAT, GL_FALSE, 0);
+    glVertexArrayAttribFormat(m_array, 1, 3, GL_FLOAT, GL_FALSE, 0);
+    glVertexArrayAttribBinding(m_array, 0, 0);
+    glVertexArrayAttribBinding(m_array, 1, 1);
+  }
+
+  DrawUploads::~DrawUploads() {
+    guard(m_array);
+    glDeleteVertexArrays(1, &m_array);
+  }
+
+  void DrawUploads::upload(std::span<const eig::Array3u>   elems,
+                           std::span<const eig::Vector2f>  verts,
+                           std::span<const eig::AlArray3f> colrs,
+                           std::span<const std::byte>      settings) {
+    auto elems_data = cnt_span<const std::byte>(elems);
+    auto verts_data = cnt_span<const std::byte>(verts);
+    auto colrs_data = cnt_span<const std::byte>(colrs);
+
+    m_ring.begin_frame(elems_data.size() + verts_data.size() + colrs_data.size() + settings.size(), 4);
+    m_elems_offset    = m_ring.push(elems_data);
+    m_verts_offset    = m_ring.push(verts_data);
+    m_colrs_offset    = m_ring.push(colrs_data);
+    m_settings_offset = m_ring.push(settings);
+    m_verts_size      = verts_data.size();
+    m_colrs_size      = colrs_data.size();
+    m_settings_size   = settings.size();
+    m_elem_count      = static_cast<uint>(elems.size()) * 3;
+
+    // Point the vertex array at this frame's ranges; the element binding only changes if
+    // the ring was recreated
+    if (m_array_buffer != m_ring.object()) {
+      m_array_buffer = m_ring.object();
+      glVertexArrayElementBuffer(m_array, m_array_buffer);
+    }
+    glVertexArrayVertexBuffer(m_array, 0, m_array_buffer, static_cast<GLintptr>(m_verts_offset), sizeof(eig::Vector2f));
+    glVertexArrayVertexBuffer(m_array, 1, m_array_buffer, static_cast<GLintptr>(m_colrs_offset), sizeof(eig::AlArray3f));
+  }
+
+  void DrawUploads::bind() const {
+    glBindVertexArray(m_array);
+    glBindBufferRange(GL_UNIFORM_BUFFER, 0, m_array_buffer,
+      static_cast<GLintptr>(m_settings_offset), static_cast<GLsizeiptr>(m_settings_size));
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 0, m_array_buffer,
+      static_cast<GLintptr>(m_verts_offset), static_cast<GLsizeiptr>(std::max<size_t>(m_verts_size, 1)));
+    glBindBufferRange(GL_SHADER_STORAGE_BUFFER, 1, m_array_buffer,
+      static_cast<GLintptr>(m_colrs_offset), static_cast<GLsizeiptr>(std::max<size_t>(m_colrs_size, 1)));
+  }
+
+  void DrawUploads::draw(uint mode) const {
+    glDrawElements(static_cast<GLenum>(mode), static_cast<GLsizei>(m_elem_count), GL_UNSIGNED_INT,
+                   reinterpret_cast<const void *>(m_elems_offset));
+  }
+
+  void DrawUploads::swap(DrawUploads &o) {
+    using std::swap;
+    m_ring.swap(o.m_ring);
+    swap(m_array,           o.m_array);
+    swap(m_array_buffer,    o.m_array_buffer);
+    swap(m_elems_offset,    o.m_elems_offset);
+    swap(m_verts_offset,    o.m_verts_offset);
+    swap(m_colrs_offset,    o.m_colrs_offset);
+    swap(m_settings_offset, o.m_settings_offset);
+    swap(m_verts_size,      o.m_verts_size);
+    swap(m_colrs_size,      o.m_colrs_size);
+    swap(m_settings_size,   o.m_settings_size);
+    swap(m_elem_count,      o.m_elem_count);
+  }
+} // namespace prg
@@ -0,0 +1,120 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <core/kernels.hpp>
+#include <core/utility.hpp>
+#include <array>
+#include <cstdlib>
+#include <string_view>
+#if defined(PRG_KERNELS_X86) && defined(_MSC_VER)
+  #include <intrin.h>
+#endif
+
+namespace prg {
+  namespace dtl {
+    // Per-variant tables, defined in src/core/kernels/kernels_*.cpp
+    extern const KernelTable kernel_table_baseline;
+#ifdef PRG_KERNELS_X86
+    extern const KernelTable kernel_table_avx2;
+    extern const KernelTable kernel_table_avx512;
+#endif
+
+    // Names accepted by PRG_KERNEL_ISA, indexed by KernelIsa
+    constexpr std::array<std::string_view, 3> kernel_isa_names = { "baseline", "avx2", "avx512" };
+
+#if defined(PRG_KERNELS_X86) && defined(_MSC_VER)
+    // Query cpuid feature bits, and whether the os saves the required register state
+    inline
+    bool cpu_supports(KernelIsa isa) {
+      std::array<int, 4> regs;
+      __cpuid(regs.data(), 0);
+      guard(regs[0] >= 7, false);
+      __cpuid(regs.data(), 1);
+      bool has_fma   = regs[2] & (1 << 12);
+      bool has_xsave = regs[2] & (1 << 27);
+      guard(has_fma && has_xsave, false);
+      __cpuidex(regs.data(), 7, 0);
+      bool has_avx2     = regs[1] & (1 << 5);
+      bool has_avx512   = (regs[1] & (1 << 16)) && (regs[1] & (1 << 17)) && (regs[1] & (1 << 31)); // f, dq, vl
+      uint64_t xcr0     = _xgetbv(0);
+      bool has_ymm_save = (xcr0 & 0x06) == 0x06;
+      bool has_zmm_save = (xcr0 & 0xe6) == 0xe6;
+      if (isa == KernelIsa::eAVX2)
+        return has_avx2 && has_ymm_save;
+      return has_avx2 && has_avx512 && has_zmm_save;
+    }
+#elif defined(PRG_KERNELS_X86)
+    // Query cpuid feature bits; gcc/clang's builtins also test os register state support
+    inline
+    bool cpu_supports(KernelIsa isa) {
+      __builtin_cpu_init();
+      bool has_avx2   = __builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma");
+      bool has_avx512 = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512dq")
+                     && __builtin_cpu_supports("avx512vl");
+      if (isa == KernelIsa::eAVX2)
+        return has_avx2;
+      return has_avx2 && has_avx512;
+    }
+#else
+    inline
+    bool cpu_supports(KernelIsa) {
+      return false;
+    }
+#endif
+
+    // Select the widest supported variant, unless PRG_KERNEL_ISA forces one
+    inline
+    const KernelTable &select_kernel_table() {
+      if (const char *env = std::getenv("PRG_KERNEL_ISA"); env && *env) {
+        for (uint i = 0; i < kernel_isa_names.size(); ++i)
+          if (kernel_isa_names[i] == env)
+            return kernel_table(static_cast<KernelIsa>(i));
+        dtl::throw_keyed_error("kernel_table(...) failed", "PRG_KERNEL_ISA names an unknown kernel variant", {{ "isa", env }});
+      }
+
+      for (KernelIsa isa : { KernelIsa::eAVX512, KernelIsa::eAVX2 })
+        if (is_kernel_supported(isa))
+          return kernel_table(isa);
+      return kernel_table_baseline;
+    }
+  } // namespace dtl
+
+  bool is_kernel_supported(KernelIsa isa) {
+    return isa == KernelIsa::eBaseline || dtl::cpu_supports(isa);
+  }
+
+  const KernelTable &kernel_table(KernelIsa isa) {
+    if (!is_kernel_supported(isa))
+      dtl::throw_keyed_error("kernel_table(...) failed", "kernel variant is not supported on this cpu",
+                             {{ "isa", dtl::kernel_isa_names[static_cast<uint>(isa)] }});
+#ifdef PRG_KERNELS_X86
+    if (isa == KernelIsa::eAVX512)
+      return dtl::kernel_table_avx512;
+    if (isa == KernelIsa::eAVX2)
+      return dtl::kernel_table_avx2;
+#endif
+    return dtl::kernel_table_baseline;
+  }
+
+  const KernelTable &kernel_table() {
+    static const KernelTable &table = dtl::select_kernel_table();
+    return table;
+  }
+} // namespace prg
@@ -0,0 +1,324 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// Kernel bodies shared by the instruction set variants in this directory; each variant's
+// translation unit defines PRG_KERNEL_ISA, PRG_KERNEL_NAME and PRG_KERNEL_TABLE, and includes
+// this file. Everything but the table has internal linkage, and only C library math is used,
+// s.t. no function compiled with wider instructions can be merged into another variant
+
+#include <core/kernels.hpp>
+#include <utility>
+
+namespace prg::dtl {
+  namespace {
+    // Tangent of half the signed angle of an edge as seen from p, given the cross and dot
+    // products of the vectors from p to the edge's vertices
+    template <bool Fast>
+    inline float mvc_half_tan(float cross, float dot) {
+      if constexpr (Fast)
+        return tan_fast(.5f * atan2_fast(cross, dot));
+      else
+        return tanf(.5f * atan2f(cross, dot));
+    }
+
+    // Load a block of interleaved points into structure-of-arrays form; the last point
+    // is repeated to fill up partial blocks
+    inline void load_block(const float *points, uint size, float *px, float *py) {
+      for (uint b = 0; b < kernel_block_size; ++b) {
+        uint k = b < size ? b : size - 1;
+        px[b] = points[2 * k];
+        py[b] = points[2 * k + 1];
+      }
+    }
+
+    // Compile-time index, passed to unrolled loop bodies
+    template <uint I>
+    struct Index { static constexpr uint value = I; };
+
+    // Invoke f(Index<I>()) for I in [0, N), unrolled at compile time
+    template <uint N, typename F>
+    inline void unroll(F &&f) {
+      [&]<uint... I>(std::integer_sequence<uint, I...>) { 
+        (f(Index<I>()), ...); 
+      }(std::make_integer_sequence<uint, N>());
+    }
+
+    // Fixed-size form of mvc_block_impl(...) for polygons of N vertices; loops over vertices
+    // are unrolled and wrap-around indices resolve at compile time, s.t. per-vertex terms of
+    // each point stay in registers
+    template <uint N, bool Fast>
+    void mvc_block_fixed(const float *verts, const float *points, uint size, 
+                         float *w, float *sum, int *valid) {
+      alignas(64) float px[kernel_block_size], py[kernel_block_size];
+      load_block(points, size, px, py);
+
+      float vx[N], vy[N];
+      unroll<N>([&](auto i) {
+        constexpr uint I = decltype(i)::value;
+        vx[I] = verts[2 * I];
+        vy[I] = verts[2 * I + 1];
+      });
+
+      #pragma omp simd
+      for (uint b = 0; b < kernel_block_size; ++b) {
+        float sx[N], sy[N], r[N], t[N];
+        int   is_valid = 1;
+        
+        // Vectors from p to vertices
+        unroll<N>([&](auto i) {
+          constexpr uint I = decltype(i)::value;
+          sx[I] = vx[I] - px[b];
+          sy[I] = vy[I] - py[b];
+          r[I]  = sqrtf(sx[I] * sx[I] + sy[I] * sy[I]);
+        });
+
+        // Half-angle tangents of edges (i, i + 1)
+        unroll<N>([&](auto i) {
+          constexpr uint I = decltype(i)::value, J = (I + 1) % N;
+          float cross = sx[I] * sy[J] - sy[I] * sx[J];
+          float dot   = sx[I] * sx[J] + sy[I] * sy[J];
+          is_valid &= (r[I] > mvc_epsilon) & ((fabsf(cross) > mvc_epsilon * r[I] * r[J]) | (dot >= 0.f));
+          t[I] = mvc_half_tan<Fast>(cross, dot);
+        });
+
+        // w_i = (tan(a_{i-1} / 2) + tan(a_i / 2)) / r_i
+        float s = 0.f;
+        unroll<N>([&](auto i) {
+          constexpr uint I = decltype(i)::value, H = (I + N - 1) % N;
+          float w_i = (t[H] + t[I]) / r[I];
+          w[I * kernel_block_size + b] = w_i;
+          s += w_i;
+        });
+
+        sum[b]   = s;
+        valid[b] = is_valid;
+      }
+    }
+
+    template <bool Fast>
+    void mvc_block_impl(const float *verts, uint n, const float *points, uint size,
+                        float *w, float *sum, int *valid) {
+      alignas(64) float px[kernel_block_size], py[kernel_block_size],
+                        sx[kernel_block_size], sy[kernel_block_size],
+                        r[kernel_block_size],  t_prev[kernel_block_size];
+      load_block(points, size, px, py);
+
+      // Half-angle tangent of edge (n - 1, 0), and vectors to vertex 0
+      const float vx_last = verts[2 * (n - 1)], vy_last = verts[2 * (n - 1) + 1];
+      #pragma omp simd
+      for (uint b = 0; b < kernel_block_size; ++b) {
+        float sx_prev = vx_last - px[b], sy_prev = vy_last - py[b];
+        sx[b]     = verts[0] - px[b];
+        sy[b]     = verts[1] - py[b];
+        r[b]      = sqrtf(sx[b] * sx[b] + sy[b] * sy[b]);
+        t_prev[b] = mvc_half_tan<Fast>(sx_prev * sy[b] - sy_prev * sx[b], sx_prev * sx[b] + sy_prev * sy[b]);
+        sum[b]    = 0.f;
+        valid[b]  = 1;
+      }
+
+      // Iterate polygon vertices, and vectorize over points in block
+      for (uint i = 0; i < n; ++i) {
+        const uint j = (i + 1 == n) ? 0 : i + 1;
+        const float vx_next = verts[2 * j], vy_next = verts[2 * j + 1];
+        float *w_i = w + i * kernel_block_size;
+
+        #pragma omp simd
+        for (uint b = 0; b < kernel_block_size; ++b) {
+          float sx_next = vx_next - px[b], sy_next = vy_next - py[b];
+          float r_next  = sqrtf(sx_next * sx_next + sy_next * sy_next);
+          float cross   = sx[b] * sy_next - sy[b] * sx_next;
+          float dot     = sx[b] * sx_next + sy[b] * sy_next;
+          valid[b] &= (r[b] > mvc_epsilon) & ((fabsf(cross) > mvc_epsilon * r[b] * r_next) | (dot >= 0.f));
+
+          float t_curr = mvc_half_tan<Fast>(cross, dot);
+          w_i[b]     = (t_prev[b] + t_curr) / r[b];
+          sum[b]    += w_i[b];
+          sx[b]      = sx_next;
+          sy[b]      = sy_next;
+          r[b]       = r_next;
+          t_prev[b]  = t_curr;
+        }
+      }
+    }
+
+    // Fixed-size form of wachspress_block(...) for polygons of N vertices; see mvc_block_fixed(...)
+    template <uint N>
+    void wachspress_block_fixed(const float *verts, const float *c, const float *e2, 
+                                const float *points, uint size, float *w, float *sum, int *valid) {
+      alignas(64) float px[kernel_block_size], py[kernel_block_size];
+      load_block(points, size, px, py);
+
+      float vx[N], vy[N], c_[N], eps[N];
+      unroll<N>([&](auto i) {
+        constexpr uint I = decltype(i)::value;
+        vx[I]  = verts[2 * I];
+        vy[I]  = verts[2 * I + 1];
+        c_[I]  = c[I];
+        eps[I] = mvc_epsilon * e2[I];
+      });
+
+      #pragma omp simd
+      for (uint b = 0; b < kernel_block_size; ++b) {
+        float a[N];
+        int   is_valid = 1;
+
+        // Twice the signed area of triangles (p, v_i, v_{i + 1})
+        unroll<N>([&](auto i) {
+          constexpr uint I = decltype(i)::value, J = (I + 1) % N;
+          a[I] = (vx[I] - px[b]) * (vy[J] - py[b]) - (vy[I] - py[b]) * (vx[J] - px[b]);
+        });
+        
+        // w_i = C_i / (A_{i-1} * A_i)
+        float s = 0.f;
+        unroll<N>([&](auto i) {
+          constexpr uint I = decltype(i)::value, H = (I + N - 1) % N;
+          is_valid &= (a[I] * a[H] > 0.f) & (fabsf(a[I]) > eps[I]);
+          float w_i = c_[I] / (a[H] * a[I]);
+          w[I * kernel_block_size + b] = w_i;
+          s += w_i;
+        });
+
+        sum[b]   = s;
+        valid[b] = is_valid;
+      }
+    }
+
+    // Jump tables over fixed-size kernels, indexed by vertex count; entries for fewer
+    // than three vertices are unused
+    using MvcBlockFn        = void (*)(const float *, const float *, uint, float *, float *, int *);
+    using WachspressBlockFn = void (*)(const float *, const float *, const float *, const float *, 
+                                       uint, float *, float *, int *);
+
+    template <typename Fn>
+    struct FixedTable { Fn fns[kernel_max_fixed_size + 1]; };
+
+    template <bool Fast>
+    constexpr auto mvc_block_fixed_table = []<uint... N>(std::integer_sequence<uint, N...>) {
+      return FixedTable<MvcBlockFn> { { (N < 3 ? nullptr : &mvc_block_fixed<(N < 3 ? 3 : N), Fast>)... } };
+    }(std::make_integer_sequence<uint, kernel_max_fixed_size + 1>());
+
+    constexpr auto wachspress_block_fixed_table = []<uint... N>(std::integer_sequence<uint, N...>) {
+      return FixedTable<WachspressBlockFn> { { (N < 3 ? nullptr : &wachspress_block_fixed<(N < 3 ? 3 : N)>)... } };
+    }(std::make_integer_sequence<uint, kernel_max_fixed_size + 1>());
+
+    void mvc_block(const float *verts, uint n, const float *points, uint size, bool fast,
+                   bool generic, float *w, float *sum, int *valid) {
+      if (!generic && n >= 3 && n <= kernel_max_fixed_size) {
+        auto fn = fast ? mvc_block_fixed_table<true>.fns[n] : mvc_block_fixed_table<false>.fns[n];
+        fn(verts, points, size, w, sum, valid);
+        return;
+      }
+      if (fast)
+        mvc_block_impl<true>(verts, n, points, size, w, sum, valid);
+      else
+        mvc_block_impl<false>(verts, n, points, size, w, sum, valid);
+    }
+
+    void wachspress_block(const float *verts, const float *c, const float *e2, uint n,
+                          const float *points, uint size, bool generic, 
+                          float *w, float *sum, int *valid) {
+      if (!generic && n >= 3 && n <= kernel_max_fixed_size) {
+        wachspress_block_fixed_table.fns[n](verts, c, e2, points, size, w, sum, valid);
+        return;
+      }
+
+      alignas(64) float px[kernel_block_size], py[kernel_block_size], a_prev[kernel_block_size];
+      load_block(points, size, px, py);
+
+      // Twice the signed area of triangle (p, v_{n - 1}, v_0)
+      const float vx_last = verts[2 * (n - 1)], vy_last = verts[2 * (n - 1) + 1];
+      #pragma omp simd
+      for (uint b = 0; b < kernel_block_size; ++b) {
+        a_prev[b] = (vx_last - px[b]) * (verts[1] - py[b]) - (vy_last - py[b]) * (verts[0] - px[b]);
+        sum[b]    = 0.f;
+        valid[b]  = 1;
+      }
+
+      // Iterate polygon vertices, and vectorize over points in block
+      for (uint i = 0; i < n; ++i) {
+        const uint  j = (i + 1 == n) ? 0 : i + 1;
+        const float vx_curr = verts[2 * i], vy_curr = verts[2 * i + 1];
+        const float vx_next = verts[2 * j], vy_next = verts[2 * j + 1];
+        const float c_i = c[i], eps = mvc_epsilon * e2[i];
+        float *w_i = w + i * kernel_block_size;
+
+        #pragma omp simd
+        for (uint b = 0; b < kernel_block_size; ++b) {
+          float a_curr = (vx_curr - px[b]) * (vy_next - py[b]) - (vy_curr - py[b]) * (vx_next - px[b]);
+          valid[b] &= (a_curr * a_prev[b] > 0.f) & (fabsf(a_curr) > eps);
+          w_i[b]     = c_i / (a_prev[b] * a_curr);
+          sum[b]    += w_i[b];
+          a_prev[b]  = a_curr;
+        }
+      }
+    }
+
+    void inside_polygon(const float *verts, uint n, const float *points, size_t size, uchar *out) {
+      for (size_t first = 0; first < size; first += kernel_block_size) {
+        const uint block = size - first < kernel_block_size ? size - first : kernel_block_size;
+        alignas(64) float px[kernel_block_size], py[kernel_block_size];
+        alignas(64) int   inside[kernel_block_size] = { };
+        load_block(points + 2 * first, block, px, py);
+
+        // Iterate polygon edges, and toggle points whose rightward ray crosses an edge; the
+        // inverse slope is infinite on horizontal edges, which never pass the straddle test
+        for (uint i = 0; i < n; ++i) {
+          const uint  j = (i + 1 == n) ? 0 : i + 1;
+          const float ax = verts[2 * i], ay = verts[2 * i + 1];
+          const float bx = verts[2 * j], by = verts[2 * j + 1];
+          const float slope = (bx - ax) / (by - ay);
+
+          #pragma omp simd
+          for (uint b = 0; b < kernel_block_size; ++b) {
+            int straddles = (ay > py[b]) != (by > py[b]);
+            inside[b] ^= straddles & (px[b] < ax + (py[b] - ay) * slope);
+          }
+        }
+
+        for (uint b = 0; b < block; ++b)
+          out[first + b] = static_cast<uchar>(inside[b]);
+      }
+    }
+
+    void inside_triangle(const float *tri, const float *points, size_t size, uchar *out) {
+      const float ax = tri[0], ay = tri[1], bx = tri[2], by = tri[3], cx = tri[4], cy = tri[5];
+
+      #pragma omp simd
+      for (size_t k = 0; k < size; ++k) {
+        float px = points[2 * k], py = points[2 * k + 1];
+        float d0 = (bx - ax) * (py - ay) - (by - ay) * (px - ax);
+        float d1 = (cx - bx) * (py - by) - (cy - by) * (px - bx);
+        float d2 = (ax - cx) * (py - cy) - (ay - cy) * (px - cx);
+        int has_neg = (d0 < 0.f) | (d1 < 0.f) | (d2 < 0.f);
+        int has_pos = (d0 > 0.f) | (d1 > 0.f) | (d2 > 0.f);
+        out[k] = static_cast<uchar>(!(has_neg & has_pos));
+      }
+    }
+  } // namespace
+
+  extern const KernelTable PRG_KERNEL_TABLE = {
+    .name             = PRG_KERNEL_NAME,
+    .isa              = PRG_KERNEL_ISA,
+    .mvc_block        = mvc_block,
+    .wachspress_block = wachspress_block,
+    .inside_polygon   = inside_polygon,
+    .inside_triangle  = inside_triangle
+  };
+} // namespace prg::dtl
@@ -0,0 +1,1050 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <core/mesh.hpp>
+#include <core/kernels.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <ranges>
+#include <omp.h>
+#include <utility>
+#include <vector>
+
+namespace prg {
+  namespace dtl {
+    // Nr. of points handed to a kernel call per thread iteration
+    constexpr size_t kernel_chunk_size = 64 * kernel_block_size;
+
+    // Polygons above this vertex count run ear tests against a tree over reflex vertices
+    constexpr uint triangulate_index_size = 80;
+
+    // Polygons above this vertex count are split into pieces in parallel triangulation, and
+    // pieces are not split below a quarter of it; nr. of segments of a ring from which rays
+    // are cast to find a split
+    constexpr uint triangulate_parallel_size  = 1u << 15;
+    constexpr uint triangulate_split_segments = 32;
+
+    constexpr uint invalid = std::numeric_limits<uint>::max();
+
+    // Vertex of a doubly linked ring during triangulation; coordinates are held in double
+    // precision, s.t. orientation tests on float input are robust. Removed vertices keep
+    // their links, which hole bridging relies on to resolve stale grid entries
+    struct EarNode {
+      uint     i;                 // Index of vertex in input
+      uint     ring;              // Ring of vertex in input
+      double   x, y;
+      EarNode *prev   = nullptr;
+      EarNode *next   = nullptr;
+      uint     leaf   = invalid;  // Leaf of ReflexTree holding this node, if any
+      bool     is_removed = false;
+    };
+
+    // Twice the signed area of triangle (p, q, r); positive for counter-clockwise turns
+    inline
+    double orient(const EarNode *p, const EarNode *q, const EarNode *r) {
+      return (q->x - p->x) * (r->y - q->y) - (q->y - p->y) * (r->x - q->x);
+    }
+
+    inline
+    bool is_equal(const EarNode *p, const EarNode *q) {
+      return p->x == q->x && p->y == q->y;
+    }
+
+    // Test whether p lies inside or on counter-clockwise triangle (a, b, c)
+    inline
+    bool is_in_triangle(double ax, double ay, double bx, double by, double cx, double cy, double px, double py) {
+      return (cx - px) * (ay - py) >= (ax - px) * (cy - py)
+          && (ax - px) * (by - py) >= (bx - px) * (ay - py)
+          && (bx - px) * (cy - py) >= (cx - px) * (by - py);
+    }
+
+    inline
+    bool is_in_triangle(const EarNode *a, const EarNode *b, const EarNode *c, const EarNode *p) {
+      return is_in_triangle(a->x, a->y, b->x, b->y, c->x, c->y, p->x, p->y);
+    }
+
+    // Test whether q lies on segment (p, r), given that the three are collinear
+    inline
+    bool is_on_segment(const EarNode *p, const EarNode *q, const EarNode *r) {
+      return q->x <= std::max(p->x, r->x) && q->x >= std::min(p->x, r->x)
+          && q->y <= std::max(p->y, r->y) && q->y >= std::min(p->y, r->y);
+    }
+
+    // Test whether segments (p1, q1) and (p2, q2) intersect, including touching
+    inline
+    bool is_intersecting(const EarNode *p1, const EarNode *q1, const EarNode *p2, const EarNode *q2) {
+      auto sign = [](double d) { return (d > 0.0) - (d < 0.0); };
+      int o1 = sign(orient(p1, q1, p2)), o2 = sign(orient(p1, q1, q2));
+      int o3 = sign(orient(p2, q2, p1)), o4 = sign(orient(p2, q2, q1));
+      return (o1 != o2 && o3 != o4)
+          || (o1 == 0 && is_on_segment(p1, p2, q1)) || (o2 == 0 && is_on_segment(p1, q2, q1))
+          || (o3 == 0 && is_on_segment(p2, p1, q2)) || (o4 == 0 && is_on_segment(p2, q1, q2));
+    }
+
+    // Test whether diagonal (a, b) leaves a towards the ring's interior
+    inline
+    bool is_locally_inside(const EarNode *a, const EarNode *b) {
+      return orient(a->prev, a, a->next) > 0.0
+           ? orient(a, b, a->next) <= 0.0 && orient(a, a->prev, b) <= 0.0
+           : orient(a, b, a->prev) > 0.0  || orient(a, a->next, b) > 0.0;
+    }
+
+    // Test whether the midpoint of diagonal (a, b) lies inside the ring
+    inline
+    bool is_middle_inside(const EarNode *a, const EarNode *b) {
+      double px = .5 * (a->x + b->x), py = .5 * (a->y + b->y);
+      bool   is_inside = false;
+      const EarNode *p = a;
+      do {
+        if ((p->y > py) != (p->next->y > py) && p->next->y != p->y
+            && px < (p->next->x - p->x) * (py - p->y) / (p->next->y - p->y) + p->x)
+          is_inside = !is_inside;
+        p = p->next;
+      } while (p != a);
+      return is_inside;
+    }
+
+    // Test whether diagonal (a, b) intersects any of the ring's edges not adjacent to it
+    inline
+    bool is_intersecting_ring(const EarNode *a, const EarNode *b) {
+      const EarNode *p = a;
+      do {
+        if (p->i != a->i && p->next->i != a->i && p->i != b->i && p->next->i != b->i
+            && is_intersecting(p, p->next, a, b))
+          return true;
+        p = p->next;
+      } while (p != a);
+      return false;
+    }
+
+    // Test whether diagonal (a, b) can split the ring into two valid rings
+    inline
+    bool is_valid_diagonal(const EarNode *a, const EarNode *b) {
+      return a->next->i != b->i && a->prev->i != b->i && !is_intersecting_ring(a, b)
+          && ((is_locally_inside(a, b) && is_locally_inside(b, a) && is_middle_inside(a, b)
+               && (orient(a->prev, a, b->prev) != 0.0 || orient(a, b->prev, b) != 0.0))
+           || (is_equal(a, b) && orient(a->prev, a, a->next) < 0.0 && orient(b->prev, b, b->next) < 0.0));
+    }
+
+    // Form of is_valid_diagonal(...) for large rings, given as their nodes in order; the
+    // passes over the ring's edges are distributed over available threads. Diagonals between
+    // coincident nodes are rejected
+    inline
+    bool is_valid_split(std::span<EarNode * const> ring, const EarNode *a, const EarNode *b) {
+      guard(a->i != b->i && a->next->i != b->i && a->prev->i != b->i
+         && is_locally_inside(a, b) && is_locally_inside(b, a)
+         && (orient(a->prev, a, b->prev) != 0.0 || orient(a, b->prev, b) != 0.0), false);
+
+      double px = .5 * (a->x + b->x), py = .5 * (a->y + b->y);
+      bool   is_crossed = false;
+      uint   n_crossed  = 0;
+      const int n = ring.size();
+      #pragma omp parallel for schedule(static) reduction(||: is_crossed) reduction(+: n_crossed)
+      for (int k = 0; k < n; ++k) {
+        const EarNode *p = ring[k], *q = p->next;
+        if (p->i != a->i && q->i != a->i && p->i != b->i && q->i != b->i && is_intersecting(p, q, a, b))
+          is_crossed = true;
+        if ((p->y > py) != (q->y > py) && q->y != p->y
+            && px < (q->x - p->x) * (py - p->y) / (q->y - p->y) + p->x)
+          n_crossed++;
+      }
+      return !is_crossed && n_crossed % 2 == 1;
+    }
+
+    // Ray cast across a ring to find a diagonal; origin and its position along the ring,
+    // direction, and nearest hit as the distance along the ray and the position of the hit
+    // edge's start along the ring
+    struct SplitRay {
+      EarNode *v;
+      uint     kv;
+      double   dx, dy;
+      double   s_min = std::numeric_limits<double>::max();
+      uint     k_min = invalid;
+    };
+
+    // Find each ray's nearest hit against the edges between every stride-th node of a ring,
+    // given as its nodes in order; rays without origin are skipped. Edges whose ends lie on
+    // the same side of a ray's line are skipped, where the side of an edge's start carries
+    // over from the previous edge in each thread's range. Ties are broken by ring order,
+    // s.t. hits do not depend on the nr. of threads
+    inline
+    void cast_split_rays(std::span<EarNode * const> ring, uint stride, std::span<SplitRay> rays) {
+      const uint n = ring.size(), n_edges = ceil_div(n, stride);
+      auto side = [](const SplitRay &ray, const EarNode *p) {
+        return ray.dx * (p->y - ray.v->y) - ray.dy * (p->x - ray.v->x);
+      };
+
+      #pragma omp parallel
+      {
+        std::vector<SplitRay> local(range_iter(rays));
+        std::vector<double>   sides(rays.size(), 0.0);
+        uint first = static_cast<size_t>(n_edges) * omp_get_thread_num() / omp_get_num_threads();
+        uint last  = static_cast<size_t>(n_edges) * (omp_get_thread_num() + 1) / omp_get_num_threads();
+        for (uint r = 0; r < rays.size() && first < last; ++r)
+          if (local[r].v)
+            sides[r] = side(local[r], ring[first * stride]);
+
+        for (uint e = first; e < last; ++e) {
+          const EarNode *p = ring[e * stride], *q = ring[std::min((e + 1) * stride, n) % n];
+          for (uint r = 0; r < rays.size(); ++r) {
+            auto &ray = local[r];
+            guard_continue(ray.v);
+            double sp = sides[r], sq = sides[r] = side(ray, q);
+            guard_continue((sp <= 0.0 || sq <= 0.0) && (sp >= 0.0 || sq >= 0.0)
+                        && !is_equal(p, ray.v) && !is_equal(q, ray.v));
+            double ex = q->x - p->x, ey = q->y - p->y, wx = p->x - ray.v->x, wy = p->y - ray.v->y;
+            double denom = ray.dx * ey - ray.dy * ex;
+            guard_continue(denom != 0.0);
+            double s = (wx * ey - wy * ex) / denom, u = (wx * ray.dy - wy * ray.dx) / denom;
+            guard_continue(s > 0.0 && u >= 0.0 && u <= 1.0 && s < ray.s_min);
+            ray.s_min = s;
+            ray.k_min = e * stride;
+          }
+        }
+
+        #pragma omp critical
+        for (uint r = 0; r < rays.size(); ++r)
+          if (local[r].s_min < rays[r].s_min || (local[r].s_min == rays[r].s_min && local[r].k_min < rays[r].k_min)) {
+            rays[r].s_min = local[r].s_min;
+            rays[r].k_min = local[r].k_min;
+          }
+      }
+    }
+
+    // Find a diagonal splitting a ring, given as its nodes in order, into two rings of at
+    // least min_size nodes, favouring balanced splits. The ring is cut into segments, and
+    // rays are cast between the nodes of segments nearest to the ring's centroid, as these
+    // tend to see across the ring; both are taken from a coarse sample of the ring's nodes.
+    // Rays are cast against the sample's edges first, which estimates the balance of their
+    // hits, and the most balanced ones are then cast against all edges; the hit edge's end
+    // furthest along the ray is a candidate. Nodes inside the triangle spanned by the ray's
+    // origin, its hit and the candidate would block it, and the one at the least angle to the
+    // ray is taken instead, as in hole bridging. Passes over the ring run in parallel. Returns
+    // the diagonal's ends as positions along the ring, or invalid if none is found
+    inline
+    std::pair<uint, uint> find_split(std::span<EarNode * const> ring, uint min_size) {
+      constexpr uint n_segments = triangulate_split_segments, n_rays = 2 * n_segments;
+      constexpr uint n_exact    = 4;    // Nr. of rays cast against all edges
+      constexpr uint n_sample   = 4096; // Nr. of edges in coarse sample
+      const uint n = ring.size();
+      auto balance = [n](uint ka, uint kb) { // Size of smaller side of split (ka, kb)
+        uint dist = (kb + n - ka) % n;
+        return std::min(dist, n - dist) + 1;
+      };
+
+      // Per segment, the sampled node nearest to the centroid of sampled nodes
+      const uint stride = std::max(n / n_sample, 1u), n_samples = ceil_div(n, stride);
+      double cx = 0.0, cy = 0.0;
+      for (uint k = 0; k < n; k += stride) {
+        cx += ring[k]->x;
+        cy += ring[k]->y;
+      }
+      cx /= n_samples;
+      cy /= n_samples;
+      auto dist = [&](const EarNode *p) { return (p->x - cx) * (p->x - cx) + (p->y - cy) * (p->y - cy); };
+      std::array<uint, n_segments> nearest;
+      for (uint r = 0; r < n_segments; ++r) {
+        nearest[r] = r * n_samples / n_segments * stride;
+        for (uint k = r * n_samples / n_segments; k < (r + 1) * n_samples / n_segments; ++k)
+          if (dist(ring[k * stride]) < dist(ring[nearest[r]]))
+            nearest[r] = k * stride;
+      }
+
+      // Rays from each segment's node towards those a quarter and half along the ring, if
+      // they leave towards the ring's interior; cast against the coarse sample
+      std::array<SplitRay, n_rays> rays;
+      for (uint r = 0; r < n_rays; ++r) {
+        uint     kv = nearest[r / 2];
+        EarNode *v  = ring[kv], *t = ring[nearest[(r / 2 + (r % 2 + 1) * n_segments / 4) % n_segments]];
+        rays[r] = { .v  = is_equal(v, t) || !is_locally_inside(v, t) ? nullptr : v, .kv = kv,
+                    .dx = t->x - v->x, .dy = t->y - v->y };
+      }
+      cast_split_rays(ring, stride, rays);
+
+      // Most balanced rays, cast against all edges
+      std::ranges::sort(rays, std::greater<> { }, [&](const SplitRay &ray) {
+        return ray.k_min != invalid ? balance(ray.kv, ray.k_min) : 0u;
+      });
+      std::array<SplitRay, n_exact> exact;
+      std::ranges::transform(rays | std::views::take(n_exact), exact.begin(), [](const SplitRay &ray) {
+        return SplitRay { .v = ray.k_min != invalid ? ray.v : nullptr, .kv = ray.kv, .dx = ray.dx, .dy = ray.dy };
+      });
+      cast_split_rays(ring, 1, exact);
+
+      // Candidate ends, and counter-clockwise triangles (v, hit, m) with their bounds
+      struct Triangle { uint km; double ax, ay, bx, by, cx, cy, min_x, min_y, max_x, max_y; };
+      std::array<Triangle, n_exact> triangles;
+      for (uint r = 0; r < n_exact; ++r) {
+        const auto &ray = exact[r];
+        triangles[r].km = invalid;
+        guard_continue(ray.k_min != invalid);
+        auto along = [&](const EarNode *u) { return (u->x - ray.v->x) * ray.dx + (u->y - ray.v->y) * ray.dy; };
+        uint     km = along(ring[ray.k_min]) > along(ring[(ray.k_min + 1) % n]) ? ray.k_min : (ray.k_min + 1) % n;
+        EarNode *m  = ring[km];
+
+        double hx = ray.v->x + ray.s_min * ray.dx, hy = ray.v->y + ray.s_min * ray.dy;
+        bool   is_ccw = (hx - ray.v->x) * (m->y - ray.v->y) - (hy - ray.v->y) * (m->x - ray.v->x) > 0.0;
+        triangles[r] = { .km = km, .ax = ray.v->x, .ay = ray.v->y, 
+                         .bx = is_ccw ? hx : m->x, .by = is_ccw ? hy : m->y,
+                         .cx = is_ccw ? m->x : hx, .cy = is_ccw ? m->y : hy,
+                         .min_x = std::min({ ray.v->x, hx, m->x }), .min_y = std::min({ ray.v->y, hy, m->y }),
+                         .max_x = std::max({ ray.v->x, hx, m->x }), .max_y = std::max({ ray.v->y, hy, m->y }) };
+      }
+
+      // Nodes inside each triangle, at the least angle to the ray; ties prefer the nearest
+      // node, and then the first along the ring
+      struct Best { double tan, dist; uint k; };
+      auto is_better = [](const Best &a, const Best &b) {
+        return a.tan < b.tan || (a.tan == b.tan && (a.dist < b.dist || (a.dist == b.dist && a.k < b.k)));
+      };
+      std::array<Best, n_exact> bests;
+      for (uint r = 0; r < n_exact; ++r)
+        bests[r] = { std::numeric_limits<double>::max(), std::numeric_limits<double>::max(), triangles[r].km };
+      #pragma omp parallel
+      {
+        auto local = bests;
+        #pragma omp for schedule(static) nowait
+        for (int k = 0; k < static_cast<int>(n); ++k) {
+          const EarNode *p = ring[k];
+          for (uint r = 0; r < n_exact; ++r) {
+            const auto &ray = exact[r];
+            const auto &tri = triangles[r];
+            guard_continue(tri.km != invalid && p->x >= tri.min_x && p->x <= tri.max_x && p->y >= tri.min_y && p->y <= tri.max_y
+                        && is_in_triangle(tri.ax, tri.ay, tri.bx, tri.by, tri.cx, tri.cy, p->x, p->y)
+                        && !is_equal(p, ray.v));
+            double wx = p->x - ray.v->x, wy = p->y - ray.v->y;
+            double dist = wx * ray.dx + wy * ray.dy;
+            Best   best = { std::abs(ray.dx * wy - ray.dy * wx) / dist, dist, static_cast<uint>(k) };
+            guard_continue(dist > 0.0 && is_better(best, local[r]) && is_locally_inside(p, ray.v));
+            local[r] = best;
+          }
+        }
+        #pragma omp critical
+        for (uint r = 0; r < n_exact; ++r)
+          if (is_better(local[r], bests[r]))
+            bests[r] = local[r];
+      }
+
+      // Validate candidates in order of balance
+      std::array<std::pair<uint, uint>, n_exact> order; // Smaller side's size, ray
+      for (uint r = 0; r < n_exact; ++r)
+        order[r] = { triangles[r].km != invalid ? balance(exact[r].kv, bests[r].k) : 0u, r };
+      std::ranges::sort(order, std::greater<> { });
+      for (auto [size, r] : order) {
+        guard_break(size >= min_size);
+        guard_continue(is_valid_split(ring, exact[r].v, ring[bests[r].k]));
+        return { exact[r].kv, bests[r].k };
+      }
+      return { invalid, invalid };
+    }
+
+    // Test whether the sector of m contains the sector of p; both share a position
+    inline
+    bool is_sector_contained(const EarNode *m, const EarNode *p) {
+      return orient(m->prev, m, p->prev) > 0.0 && orient(p->next, m, m->next) > 0.0;
+    }
+
+    // Uniform grid over the edges (p, p.next) of a set of nodes, with roughly one cell per
+    // node over their bounding box; an edge is listed in every cell its bounding box overlaps.
+    // Edges listed on build are stored contiguously per cell, and edges inserted afterwards in
+    // per-cell linked lists
+    class EdgeGrid {
+      double                                  m_x = 0.0, m_y = 0.0, m_scale = 0.0;
+      uint                                    m_nx = 0, m_ny = 0;
+      std::vector<uint>                       m_offsets;
+      std::vector<EarNode *>                  m_nodes;
+      std::vector<uint>                       m_added_heads; // Head of inserted list per cell
+      std::vector<std::pair<EarNode *, uint>> m_added;       // Node and next entry in list
+
+    public:
+      // Inclusive range of cells
+      struct Range { uint x0, y0, x1, y1; };
+
+      void build(std::span<EarNode * const> nodes) {
+        double min_x =  std::numeric_limits<double>::max(), min_y =  std::numeric_limits<double>::max();
+        double max_x = -std::numeric_limits<double>::max(), max_y = -std::numeric_limits<double>::max();
+        for (const EarNode *p : nodes) {
+          min_x = std::min(min_x, p->x); max_x = std::max(max_x, p->x);
+          min_y = std::min(min_y, p->y); max_y = std::max(max_y, p->y);
+        }
+        double w = max_x - min_x, h = max_y - min_y, n = static_cast<double>(nodes.size());
+        double cell = std::max({ std::sqrt(w * h / n), std::max(w, h) / n, 1e-30 });
+        m_x     = min_x;
+        m_y     = min_y;
+        m_scale = 1.0 / cell;
+        m_nx    = static_cast<uint>(w * m_scale) + 1;
+        m_ny    = static_cast<uint>(h * m_scale) + 1;
+
+        // Count entries per cell, then scatter them
+        m_offsets.assign(m_nx * m_ny + 1, 0);
+        for (const EarNode *p : nodes)
+          for_each_cell(edge_range(p), [&](uint cell) { m_offsets[cell + 1]++; });
+        for (uint k = 1; k < m_offsets.size(); ++k)
+          m_offsets[k] += m_offsets[k - 1];
+        m_nodes.resize(m_offsets.back());
+        std::vector<uint> cursor(m_offsets.begin(), m_offsets.end() - 1);
+        for (EarNode *p : nodes)
+          for_each_cell(edge_range(p), [&](uint cell) { m_nodes[cursor[cell]++] = p; });
+
+        m_added_heads.assign(m_nx * m_ny, invalid);
+        m_added.clear();
+      }
+
+      void insert(EarNode *p) {
+        for_each_cell(edge_range(p), [&](uint cell) {
+          m_added.push_back({ p, m_added_heads[cell] });
+          m_added_heads[cell] = m_added.size() - 1;
+        });
+      }
+
+      // Cells overlapped by a bounding box, clamped to the grid
+      Range range(double min_x, double min_y, double max_x, double max_y) const {
+        auto cell_x = [&](double x) { return static_cast<uint>(std::clamp((x - m_x) * m_scale, 0.0, m_nx - 1.0)); };
+        auto cell_y = [&](double y) { return static_cast<uint>(std::clamp((y - m_y) * m_scale, 0.0, m_ny - 1.0)); };
+        return { cell_x(min_x), cell_y(min_y), cell_x(max_x), cell_y(max_y) };
+      }
+
+      Range edge_range(const EarNode *p) const {
+        const EarNode *q = p->next;
+        return range(std::min(p->x, q->x), std::min(p->y, q->y), std::max(p->x, q->x), std::max(p->y, q->y));
+      }
+
+      template <typename F>
+      void for_each_cell(Range r, F f) const {
+        for (uint y = r.y0; y <= r.y1; ++y)
+          for (uint x = r.x0; x <= r.x1; ++x)
+            f(y * m_nx + x);
+      }
+
+      // Call f(p) for the start nodes of edges listed in a range of cells; nodes may be
+      // visited more than once
+      template <typename F>
+      void visit(Range r, F f) const {
+        for_each_cell(r, [&](uint cell) {
+          for (uint k = m_offsets[cell]; k < m_offsets[cell + 1]; ++k)
+            f(m_nodes[k]);
+          for (uint k = m_added_heads[cell]; k != invalid; k = m_added[k].second)
+            f(m_added[k].first);
+        });
+      }
+    };
+
+    // Kd-tree over the reflex and collinear nodes of a ring, against which ear tests are run,
+    // as only these can block an ear. Each tree node counts its live nodes, s.t. subtrees whose
+    // nodes were all removed are skipped, and subtrees outside the tested triangle are culled.
+    // Positions are copied into the tree, s.t. culled nodes are never dereferenced. Nodes that
+    // turn reflex after the build are inserted into lists at the leaves whose cells hold them
+    class ReflexTree {
+      static constexpr uint leaf_size = 8;
+
+      struct Item {
+        double   x, y;
+        EarNode *p;
+      };
+
+      struct TreeNode {
+        double min_x, min_y, max_x, max_y;
+        uint   first, last; // Range of items
+        uint   child;       // Index of first of two children, or invalid for leaves
+        uint   parent;
+        uint   live;        // Nr. of items in subtree whose nodes were not removed
+        uint   added;       // First entry in list of items added to leaf, or invalid
+        bool   is_x;        // Axis and coordinate at which children are split
+        double split;
+      };
+
+      std::vector<TreeNode>              m_tree;
+      std::vector<Item>                  m_items;
+      std::vector<std::pair<Item, uint>> m_added; // Item and next entry in list
+
+      void build_node(uint t, uint first, uint last, uint parent) {
+        TreeNode node = { .min_x =  std::numeric_limits<double>::max(), .min_y =  std::numeric_limits<double>::max(),
+                          .max_x = -std::numeric_limits<double>::max(), .max_y = -std::numeric_limits<double>::max(),
+                          .first = first, .last = last, .child = invalid, .parent = parent, .live = last - first,
+                          .added = invalid };
+        for (uint k = first; k < last; ++k) {
+          node.min_x = std::min(node.min_x, m_items[k].x); node.max_x = std::max(node.max_x, m_items[k].x);
+          node.min_y = std::min(node.min_y, m_items[k].y); node.max_y = std::max(node.max_y, m_items[k].y);
+        }
+
+        if (last - first <= leaf_size) {
+          for (uint k = first; k < last; ++k)
+            m_items[k].p->leaf = t;
+          m_tree[t] = node;
+          return;
+        }
+
+        // Split at the median along the longer axis
+        uint mid  = (first + last) / 2;
+        bool is_x = node.max_x - node.min_x >= node.max_y - node.min_y;
+        std::nth_element(m_items.begin() + first, m_items.begin() + mid, m_items.begin() + last,
+          [is_x](const Item &a, const Item &b) { return is_x ? a.x < b.x : a.y < b.y; });
+        node.is_x  = is_x;
+        node.split = is_x ? m_items[mid].x : m_items[mid].y;
+        node.child = m_tree.size();
+        m_tree[t]  = node;
+        m_tree.resize(m_tree.size() + 2);
+        build_node(node.child,     first, mid,  t);
+        build_node(node.child + 1, mid,   last, t);
+      }
+
+    public:
+      // Build over the reflex and collinear nodes of the ring holding start
+      void build(EarNode *start) {
+        m_items.clear();
+        m_added.clear();
+        m_tree.clear();
+        EarNode *p = start;
+        do {
+          p->leaf = invalid;
+          if (orient(p->prev, p, p->next) <= 0.0)
+            m_items.push_back({ p->x, p->y, p });
+          p = p->next;
+        } while (p != start);
+        m_tree.resize(1);
+        build_node(0, 0, m_items.size(), invalid);
+      }
+
+      // Track a node whose neighbours changed, in case it turned reflex; it is added to the
+      // leaf whose cell holds it, and bounds along the way are grown to include it
+      void update(EarNode *p) {
+        guard(p->leaf == invalid && orient(p->prev, p, p->next) <= 0.0);
+        uint t = 0;
+        while (true) {
+          TreeNode &node = m_tree[t];
+          node.min_x = std::min(node.min_x, p->x); node.max_x = std::max(node.max_x, p->x);
+          node.min_y = std::min(node.min_y, p->y); node.max_y = std::max(node.max_y, p->y);
+          node.live++;
+          guard_break(node.child != invalid);
+          t = node.child + ((node.is_x ? p->x : p->y) < node.split ? 0 : 1);
+        }
+        m_added.push_back({ { p->x, p->y, p }, m_tree[t].added });
+        m_tree[t].added = m_added.size() - 1;
+        p->leaf = t;
+      }
+
+      // Track removal of a node
+      void remove(EarNode *p) {
+        for (uint t = p->leaf; t != invalid; t = m_tree[t].parent)
+          m_tree[t].live--;
+      }
+
+      // Call f(p) for nodes inside or on counter-clockwise triangle (a, b, c) until f returns
+      // false; returns whether all nodes were visited. Removed nodes may be visited
+      template <typename F>
+      bool visit(const EarNode *a, const EarNode *b, const EarNode *c, F f) const {
+        double min_x = std::min({ a->x, b->x, c->x }), max_x = std::max({ a->x, b->x, c->x });
+        double min_y = std::min({ a->y, b->y, c->y }), max_y = std::max({ a->y, b->y, c->y });
+
+        // A box lies outside the triangle if its corner furthest left of any edge is right of it
+        auto is_outside_edge = [](const TreeNode &node, const EarNode *u, const EarNode *v) {
+          double dx = v->x - u->x, dy = v->y - u->y;
+          double x  = dy > 0.0 ? node.min_x : node.max_x;
+          double y  = dx > 0.0 ? node.max_y : node.min_y;
+          return dx * (y - u->y) - dy * (x - u->x) < 0.0;
+        };
+
+        std::array<uint, 128> stack;
+        uint                  stack_size = 0;
+        if (!m_tree.empty())
+          stack[stack_size++] = 0;
+        while (stack_size > 0) {
+          const TreeNode &node = m_tree[stack[--stack_size]];
+          guard_continue(node.live > 0
+            && node.min_x <= max_x && node.max_x >= min_x && node.min_y <= max_y && node.max_y >= min_y
+            && !is_outside_edge(node, a, b) && !is_outside_edge(node, b, c) && !is_outside_edge(node, c, a));
+          auto is_inside = [&](const Item &item) {
+            return item.x >= min_x && item.x <= max_x && item.y >= min_y && item.y <= max_y
+                && is_in_triangle(a->x, a->y, b->x, b->y, c->x, c->y, item.x, item.y);
+          };
+          if (node.child == invalid) {
+            for (uint k = node.first; k < node.last; ++k)
+              guard(!is_inside(m_items[k]) || f(m_items[k].p), false);
+            for (uint k = node.added; k != invalid; k = m_added[k].second)
+              guard(!is_inside(m_added[k].first) || f(m_added[k].first.p), false);
+          } else {
+            stack[stack_size++] = node.child;
+            stack[stack_size++] = node.child + 1;
+          }
+        }
+        return true;
+      }
+    };
+
+    // Ear-clipping triangulator over linked rings, which appends triangles to elems. Nodes
+    // are kept in a deque, s.t. links remain valid as rings are split
+    class EarClipper {
+      std::vector<eig::Array3u> &m_elems;
+      std::deque<EarNode>        m_nodes;
+
+      // Tree over a ring's reflex nodes, rebuilt for each ring that is clipped, against which
+      // ear tests are run if m_is_indexed is set
+      bool       m_is_indexed = false;
+      ReflexTree m_reflex;
+
+      // Grid over edges of all rings, used to find hole bridges. Entries go stale as nodes are
+      // removed, and resolve to their nearest live predecessor, which then owns the removed
+      // edge's span; nodes on rings that are not yet bridged are skipped
+      EdgeGrid           m_edge_grid;
+      std::vector<uchar> m_is_bridged; // Per ring, whether part of the outer ring
+
+    public:
+      EarClipper(std::vector<eig::Array3u> &elems) : m_elems(elems) { }
+
+      // Insert a node after last, or start a new ring if last is nullptr
+      EarNode *insert_node(uint i, uint ring, const eig::Vector2f &v, EarNode *last) {
+        EarNode *p = &m_nodes.emplace_back(EarNode { .i = i, .ring = ring, .x = v.x(), .y = v.y() });
+        if (!last) {
+          p->prev = p->next = p;
+        } else {
+          p->next = last->next;
+          p->prev = last;
+          last->next->prev = p;
+          last->next = p;
+        }
+        return p;
+      }
+
+      void remove_node(EarNode *p) {
+        p->next->prev = p->prev;
+        p->prev->next = p->next;
+        p->is_removed = true;
+        if (p->leaf != invalid)
+          m_reflex.remove(p);
+      }
+
+      // Track nodes whose neighbours changed, as they may have turned reflex
+      void update_nodes(EarNode *p, EarNode *q) {
+        guard(m_is_indexed);
+        m_reflex.update(p);
+        m_reflex.update(q);
+      }
+
+      // Link a ring of input vertices in [first, last), in counter-clockwise order if ccw is
+      // set, or clockwise order otherwise
+      EarNode *link_ring(std::span<const eig::Vector2f> verts, uint first, uint last, uint ring, bool ccw) {
+        double area = 0.0;
+        for (uint i = first, j = last - 1; i < last; j = i++)
+          area += static_cast<double>(verts[j].x()) * verts[i].y() - static_cast<double>(verts[i].x()) * verts[j].y();
+
+        EarNode *p = nullptr;
+        if ((area > 0.0) == ccw) {
+          for (uint i = first; i < last; ++i)
+            p = insert_node(i, ring, verts[i], p);
+        } else {
+          for (uint i = last; i-- > first;)
+            p = insert_node(i, ring, verts[i], p);
+        }
+        if (p && is_equal(p, p->next)) {
+          remove_node(p);
+          p = p->next;
+        }
+        return p;
+      }
+
+      // Remove duplicate and collinear nodes between start and end, and return a live node
+      EarNode *filter_points(EarNode *start, EarNode *end = nullptr) {
+        guard(start, start);
+        end = end ? end : start;
+
+        EarNode *p = start;
+        bool     is_again;
+        do {
+          is_again = false;
+          if (is_equal(p, p->next) || orient(p->prev, p, p->next) == 0.0) {
+            remove_node(p);
+            update_nodes(p->prev, p->next);
+            p = end = p->prev;
+            guard_break(p != p->next);
+            is_again = true;
+          } else {
+            p = p->next;
+          }
+        } while (is_again || p != end);
+        return end;
+      }
+
+      // Split a ring along diagonal (a, b) into two rings, by duplicating a and b; returns
+      // the duplicate of b, which lies on the second ring
+      EarNode *split_ring(EarNode *a, EarNode *b) {
+        EarNode *a2 = &m_nodes.emplace_back(EarNode { .i = a->i, .ring = a->ring, .x = a->x, .y = a->y });
+        EarNode *b2 = &m_nodes.emplace_back(EarNode { .i = b->i, .ring = b->ring, .x = b->x, .y = b->y });
+        EarNode *an = a->next, *bp = b->prev;
+        a->next  = b;  b->prev  = a;
+        a2->next = an; an->prev = a2;
+        b2->next = a2; a2->prev = b2;
+        bp->next = b2; b2->prev = bp;
+        return b2;
+      }
+
+      // Run ear tests against a tree over the ring's reflex nodes, rather than the full ring
+      void enable_index(bool is_indexed) {
+        m_is_indexed = is_indexed;
+      }
+
+      // Test whether ear forms a valid ear; a convex corner whose triangle holds no reflex
+      // node. Tested nodes are those in grid cells overlapping the triangle, or the full ring
+      bool is_ear(const EarNode *ear) const {
+        const EarNode *a = ear->prev, *b = ear, *c = ear->next;
+        guard(orient(a, b, c) > 0.0, false);
+
+        double min_x = std::min({ a->x, b->x, c->x }), max_x = std::max({ a->x, b->x, c->x });
+        double min_y = std::min({ a->y, b->y, c->y }), max_y = std::max({ a->y, b->y, c->y });
+        auto is_outside = [&](const EarNode *p) {
+          return p == a || p == b || p == c || p->is_removed
+              || p->x < min_x || p->x > max_x || p->y < min_y || p->y > max_y
+              || !is_in_triangle(a, b, c, p) || orient(p->prev, p, p->next) > 0.0;
+        };
+
+        if (m_is_indexed)
+          return m_reflex.visit(a, b, c, [&](const EarNode *p) {
+            return p == a || p == b || p == c || p->is_removed || orient(p->prev, p, p->next) > 0.0;
+          });
+        for (const EarNode *p = c->next; p != a; p = p->next)
+          guard(is_outside(p), false);
+        return true;
+      }
+
+      // Clip ears from a ring until a triangle remains. If no ear is found, consecutive
+      // passes remove degenerate nodes, cure small self-intersections, and finally split the
+      // ring along a valid diagonal, after which both halves start over
+      void clip_ears(EarNode *ear, uint pass) {
+        guard(ear);
+        if (pass == 0 && m_is_indexed)
+          m_reflex.build(ear);
+
+        EarNode *stop = ear;
+        while (ear->prev != ear->next) {
+          EarNode *prev = ear->prev, *next = ear->next;
+          if (is_ear(ear)) {
+            m_elems.push_back({ prev->i, ear->i, next->i });
+            remove_node(ear);
+            update_nodes(prev, next);
+
+            // Skipping the next node avoids slivers
+            ear = stop = next->next;
+            continue;
+          }
+
+          ear = next;
+          guard_continue(ear == stop);
+          if (pass == 0)
+            clip_ears(filter_points(ear), 1);
+          else if (pass == 1)
+            clip_ears(cure_local_intersections(filter_points(ear)), 2);
+          else
+            split_ears(ear);
+          break;
+        }
+      }
+
+      // Clip triangles at local self-intersections, where edges (a, p) and (p.next, b) cross
+      EarNode *cure_local_intersections(EarNode *start) {
+        EarNode *p = start;
+        do {
+          EarNode *a = p->prev, *b = p->next->next;
+          if (!is_equal(a, b) && is_intersecting(a, p, p->next, b)
+              && is_locally_inside(a, b) && is_locally_inside(b, a)) {
+            m_elems.push_back({ a->i, p->i, b->i });
+            remove_node(p);
+            remove_node(p->next);
+            update_nodes(a, b);
+            p = start = b;
+          }
+          p = p->next;
+        } while (p != start);
+        return filter_points(p);
+      }
+
+      // Split a ring along the first valid diagonal found, and triangulate both halves
+      void split_ears(EarNode *start) {
+        EarNode *a = start;
+        do {
+          for (EarNode *b = a->next->next; b != a->prev; b = b->next) {
+            guard_continue(a->i != b->i && is_valid_diagonal(a, b));
+            EarNode *c = split_ring(a, b);
+            a = filter_points(a, a->next);
+            c = filter_points(c, c->next);
+            clip_ears(a, 0);
+            clip_ears(c, 0);
+            return;
+          }
+          a = a->next;
+        } while (a != start);
+      }
+
+      // Split the ring holding start along diagonals found by find_split(...), largest ring
+      // first, until max_pieces rings exist or no ring can be split into two of min_size
+      // nodes; returns a live node per ring, largest ring first. Rings are kept as their nodes
+      // in order, s.t. both halves of a split ring are copied from its ranges
+      std::vector<EarNode *> split_pieces(EarNode *start, uint max_pieces, uint min_size) {
+        using Ring = std::vector<EarNode *>;
+        auto is_smaller = [](const Ring &a, const Ring &b) { return a.size() < b.size(); };
+        std::vector<Ring> queue(1), pieces;
+        EarNode *p = start;
+        do {
+          queue[0].push_back(p);
+          p = p->next;
+        } while (p != start);
+
+        while (!queue.empty()) {
+          std::ranges::pop_heap(queue, is_smaller);
+          Ring ring = std::move(queue.back());
+          queue.pop_back();
+          if (ring.size() < 2 * min_size || queue.size() + pieces.size() + 1 >= max_pieces) {
+            pieces.push_back(std::move(ring));
+            continue;
+          }
+
+          auto [ka, kb] = find_split(ring, min_size);
+          if (ka == invalid) {
+            pieces.push_back(std::move(ring));
+            continue;
+          }
+
+          // Ring of a holds nodes from b up to a, and that of c, the duplicate of b, holds
+          // duplicates of b and a, and the nodes between a and b. Degeneracies at the cut are
+          // left to ear clipping, s.t. no nodes are removed
+          EarNode *a = ring[ka], *b = ring[kb];
+          EarNode *c = split_ring(a, b);
+
+          auto append = [&](Ring &out, uint first, uint last) { // Cyclic range [first, last)
+            if (first <= last) {
+              out.insert(out.end(), ring.begin() + first, ring.begin() + last);
+            } else {
+              out.insert(out.end(), ring.begin() + first, ring.end());
+              out.insert(out.end(), ring.begin(), ring.begin() + last);
+            }
+          };
+          Ring ring_a, ring_c = { c, c->next };
+          append(ring_a, kb, ka + 1);
+          append(ring_c, ka + 1, kb);
+          queue.push_back(std::move(ring_a));
+          std::ranges::push_heap(queue, is_smaller);
+          queue.push_back(std::move(ring_c));
+          std::ranges::push_heap(queue, is_smaller);
+        }
+
+        std::ranges::sort(pieces, [&](const Ring &a, const Ring &b) { return is_smaller(b, a); });
+        std::vector<EarNode *> out(pieces.size());
+        std::ranges::transform(pieces, out.begin(), [](const Ring &ring) { return ring.front(); });
+        return out;
+      }
+
+      // Call f(p) for the live nodes of edges listed in a range of the edge grid, which are
+      // part of the outer ring
+      template <typename F>
+      void visit_edges(EdgeGrid::Range r, F f) const {
+        m_edge_grid.visit(r, [&](EarNode *p) {
+          while (p->is_removed)
+            p = p->prev;
+          if (m_is_bridged[p->ring])
+            f(p);
+        });
+      }
+
+      // Find the outer ring's node to bridge a hole to, given the hole's leftmost node. A ray
+      // from the hole to the left is tested against edges in cells along its row, nearest
+      // column first, up to the first column that cannot hold a nearer hit; the hit edge's
+      // leftmost end is the candidate bridge. Outer nodes inside the triangle spanned by the
+      // hole, the hit and the candidate would block it, and the one at the least angle to the
+      // ray is taken instead
+      EarNode *find_hole_bridge(const EarNode *hole) const {
+        double   hx = hole->x, hy = hole->y, qx = -std::numeric_limits<double>::max();
+        EarNode *m  = nullptr;
+
+        // Nearest edge crossing the ray, going downwards s.t. the hole lies on its inner side
+        auto row = m_edge_grid.range(hx, hy, hx, hy);
+        for (uint col = row.x0 + 1; col-- > 0;) {
+          visit_edges({ col, row.y0, col, row.y0 }, [&](EarNode *p) {
+            guard(hy <= p->y && hy >= p->next->y && p->next->y != p->y);
+            double x = p->x + (hy - p->y) * (p->next->x - p->x) / (p->next->y - p->y);
+            guard(x <= hx && x > qx);
+            qx = x;
+            m  = p->x < p->next->x ? p : p->next;
+          });
+
+          // Hole touches the hit edge, so bridge to the edge's leftmost end
+          guard(!m || qx != hx, m);
+          guard_break(!m || m_edge_grid.range(qx, hy, qx, hy).x0 < col);
+        }
+        guard(m, nullptr);
+
+        // Search nodes inside the triangle (hole, hit, m) for the least angle to the ray;
+        // ties prefer the rightmost node, or the node whose sector contains the other's
+        double mx = m->x, my = m->y, tan_min = std::numeric_limits<double>::max();
+        visit_edges(m_edge_grid.range(mx, std::min(hy, my), hx, std::max(hy, my)), [&](EarNode *p) {
+          guard(hx >= p->x && p->x >= mx && hx != p->x
+             && is_in_triangle(hy < my ? hx : qx, hy, mx, my, hy < my ? qx : hx, hy, p->x, p->y));
+          double tan = std::abs(hy - p->y) / (hx - p->x);
+          guard(is_locally_inside(p, hole));
+          guard(tan < tan_min || (tan == tan_min 
+            && (p->x > m->x || (p->x == m->x && is_sector_contained(m, p)))));
+          m       = p;
+          tan_min = tan;
+        });
+        return m;
+      }
+
+      // Bridge a hole into the outer ring through a pair of coincident edges, and return a
+      // live node on the outer ring
+      EarNode *eliminate_hole(EarNode *hole, EarNode *outer) {
+        EarNode *bridge = find_hole_bridge(hole);
+        guard(bridge, outer);
+
+        EarNode *bridge_reverse = split_ring(bridge, hole);
+        m_edge_grid.insert(bridge);
+        m_edge_grid.insert(bridge_reverse);
+        m_edge_grid.insert(bridge_reverse->next);
+
+        // Remove collinear nodes around the cut
+        filter_points(bridge_reverse, bridge_reverse->next);
+        return filter_points(bridge, bridge->next);
+      }
+
+      // Link holes, and bridge them into the outer ring in order of their leftmost node
+      EarNode *eliminate_holes(std::span<const eig::Vector2f> verts, std::span<const uint> hole_offsets, EarNode *outer) {
+        uint n = verts.size(), n_rings = hole_offsets.size() + 1;
+
+        std::vector<EarNode *> holes;
+        for (uint r = 1; r < n_rings; ++r) {
+          auto [first, last] = polygon_ring(hole_offsets, n, r);
+          guard_continue(last >= first + 3);
+          EarNode *p = link_ring(verts, first, last, r, false);
+          guard_continue(p->next != p->prev);
+
+          // Leftmost node, with ties broken by y
+          EarNode *left = p, *q = p;
+          do {
+            if (q->x < left->x || (q->x == left->x && q->y < left->y))
+              left = q;
+            q = q->next;
+          } while (q != p);
+          holes.push_back(left);
+        }
+        guard(!holes.empty(), outer);
+        std::ranges::sort(holes, [](const EarNode *a, const EarNode *b) {
+          return a->x < b->x || (a->x == b->x && a->y < b->y);
+        });
+
+        // Grid over all rings' edges; removed nodes are listed too, and resolve on lookup
+        std::vector<EarNode *> nodes(m_nodes.size());
+        std::ranges::transform(m_nodes, nodes.begin(), [](EarNode &p) { return &p; });
+        m_edge_grid.build(nodes);
+        m_is_bridged.assign(n_rings, false);
+        m_is_bridged[0] = true;
+
+        for (EarNode *hole : holes) {
+          outer = eliminate_hole(hole, outer);
+          m_is_bridged[hole->ring] = true;
+        }
+        return outer;
+      }
+    };
+  } // namespace dtl
+
+  void is_inside_polygon(std::span<const eig::Vector2f> verts,
+                         std::span<const eig::Vector2f> points,
+                         std::span<uchar>               out) {
+    dbg::check_expr(out.size() >= points.size(), "is_inside_polygon(...) requires an output per point");
+    
+    const auto &kernels  = kernel_table();
+    const auto  verts_f  = cast_span<const float>(verts);
+    const auto  points_f = cast_span<const float>(points);
+    const int   n_chunks = ceil_div(points.size(), dtl::kernel_chunk_size);
+    
+    #pragma omp parallel for schedule(static)
+    for (int chunk = 0; chunk < n_chunks; ++chunk) {
+      size_t first = chunk * dtl::kernel_chunk_size;
+      size_t size  = std::min(dtl::kernel_chunk_size, points.size() - first);
+      kernels.inside_polygon(verts_f.data(), verts.size(), &points_f[2 * first], size, &out[first]);
+    }
+  }
+
+  void is_inside_triangle(eig::Vector2f                  a,
+                          eig::Vector2f                  b,
+                          eig::Vector2f                  c,
+                          std::span<const eig::Vector2f> points,
+                          std::span<uchar>               out) {
+    dbg::check_expr(out.size() >= points.size(), "is_inside_triangle(...) requires an output per point");
+
+    const auto &kernels  = kernel_table();
+    const auto  points_f = cast_span<const float>(points);
+    const int   n_chunks = ceil_div(points.size(), dtl::kernel_chunk_size);
+    const std::array<float, 6> tri = { a.x(), a.y(), b.x(), b.y(), c.x(), c.y() };
+
+    #pragma omp parallel for schedule(static)
+    for (int chunk = 0; chunk < n_chunks; ++chunk) {
+      size_t first = chunk * dtl::kernel_chunk_size;
+      size_t size  = std::min(dtl::kernel_chunk_size, points.size() - first);
+      kernels.inside_triangle(tri.data(), &points_f[2 * first], size, &out[first]);
+    }
+  }
+
+  std::vector<eig::Array3u> triangulate_polygon(std::span<const eig::Vector2f> verts,
+                                                std::span<const uint>          hole_offsets,
+                                                TriangulateMode                mode) {
+    const uint n = verts.size();
+    dbg::check_expr(std::ranges::is_sorted(hole_offsets) && (hole_offsets.empty() || hole_offsets.back() <= n),
+      "triangulate_polygon(...) requires ascending hole offsets within verts");
+
+    std::vector<eig::Array3u> elems;
+    auto [first, last] = polygon_ring(hole_offsets, n, 0);
+    guard(last >= first + 3, elems);
+    elems.reserve(n + 2 * hole_offsets.size());
+
+    dtl::EarClipper clipper(elems);
+    dtl::EarNode *outer = clipper.link_ring(verts, first, last, 0, true);
+    guard(outer->next != outer->prev, elems);
+    outer = clipper.eliminate_holes(verts, hole_offsets, outer);
+
+    int n_threads = omp_get_max_threads();
+    if (mode == TriangulateMode::eSerial || n <= dtl::triangulate_parallel_size || n_threads == 1) {
+      clipper.enable_index(n > dtl::triangulate_index_size);
+      clipper.clip_ears(outer, 0);
+      return elems;
+    }
+
+    // Clip pieces concurrently, largest first; each gets its own clipper, as these hold
+    // per-ring state, while nodes are shared but disjoint between pieces
+    auto pieces = clipper.split_pieces(outer, 4 * n_threads, dtl::triangulate_parallel_size / 4);
+    std::vector<std::vector<eig::Array3u>> piece_elems(pieces.size());
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int i = 0; i < static_cast<int>(pieces.size()); ++i) {
+      dtl::EarClipper piece_clipper(piece_elems[i]);
+      piece_clipper.enable_index(true);
+      piece_clipper.clip_ears(pieces[i], 0);
+    }
+
+    // Concatenate pieces' triangles
+    std::vector<size_t> offsets(pieces.size() + 1, 0);
+    for (uint i = 0; i < pieces.size(); ++i)
+      offsets[i + 1] = offsets[i] + piece_elems[i].size();
+    elems.resize(offsets.back());
+    #pragma omp parallel for schedule(dynamic, 1)
+    for (int i = 0; i < static_cast<int>(pieces.size()); ++i)
+      std::ranges::copy(piece_elems[i], elems.begin() + offsets[i]);
+    return elems;
+  }
+} // namespace prg
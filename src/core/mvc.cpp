@@ -0,0 +1,538 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <core/mvc.hpp>
+#include <core/mesh.hpp>
+#include <core/kernels.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+namespace prg {
+  namespace dtl {
+    inline
+    float cross_2d(const eig::Vector2f &a, const eig::Vector2f &b) {
+      return a.x() * b.y() - a.y() * b.x();
+    }
+
+    // Gradient w.r.t. p of the polar angle of s = v - p
+    inline
+    eig::Vector2f mvc_angle_grad(const eig::Vector2f &s, float r) {
+      return eig::Vector2f(s.y(), -s.x()) / (r * r);
+    }
+
+    // Boundary fallback of eval_mvc(...); if p lies on a vertex or edge, the weights are set
+    // to the linear boundary interpolant and true is returned
+    inline
+    bool eval_mvc_boundary(std::span<const eig::Vector2f> verts,
+                           eig::Vector2f                  p,
+                           std::span<float>               weights) {
+      const uint n = verts.size();
+      for (uint i = 0; i < n; ++i) {
+        uint j = (i + 1 == n) ? 0 : i + 1;
+        eig::Vector2f s_curr = verts[i] - p, s_next = verts[j] - p;
+        float r_curr = s_curr.norm(), r_next = s_next.norm();
+        
+        // p coincides with a vertex
+        if (r_curr <= mvc_epsilon) {
+          std::ranges::fill(weights.subspan(0, n), 0.f);
+          weights[i] = 1.f;
+          return true;
+        }
+
+        // p lies on edge (i, j), so interpolate linearly
+        if (std::abs(cross_2d(s_curr, s_next)) <= mvc_epsilon * r_curr * r_next && s_curr.dot(s_next) < 0.f) {
+          std::ranges::fill(weights.subspan(0, n), 0.f);
+          weights[i] = r_next / (r_curr + r_next);
+          weights[j] = r_curr / (r_curr + r_next);
+          return true;
+        }
+      }
+      return false;
+    }
+
+    // Tangent of half the signed angle of an edge as seen from p, given the cross and dot
+    // products of the vectors from p to the edge's vertices
+    template <MvcPrecision P>
+    float mvc_half_tan(float cross, float dot) {
+      if constexpr (P == MvcPrecision::eFast)
+        return tan_fast(.5f * atan2_fast(cross, dot));
+      else
+        return std::tan(.5f * std::atan2(cross, dot));
+    }
+
+    template <MvcPrecision P>
+    void eval_mvc(std::span<const eig::Vector2f> verts,
+                  eig::Vector2f                  p,
+                  std::span<float>               weights) {
+      const uint n = verts.size();
+
+      // Vectors from p to previous/current vertex, and half-angle tangent of their edge
+      eig::Vector2f s_prev = verts[n - 1] - p;
+      eig::Vector2f s_curr = verts[0] - p;
+      float         r_curr = s_curr.norm();
+      float         t_prev = mvc_half_tan<P>(cross_2d(s_prev, s_curr), s_prev.dot(s_curr));
+
+      // Iterate polygon vertices; w_i = (tan(a_{i-1} / 2) + tan(a_i / 2)) / r_i
+      float weights_sum = 0.f;
+      for (uint i = 0; i < n; ++i) {
+        uint j = (i + 1 == n) ? 0 : i + 1;
+        eig::Vector2f s_next = verts[j] - p;
+        float         r_next = s_next.norm();
+
+        // Boundary case; p lies on a vertex or edge
+        float cross = cross_2d(s_curr, s_next), dot = s_curr.dot(s_next);
+        if (r_curr <= mvc_epsilon || (std::abs(cross) <= mvc_epsilon * r_curr * r_next && dot < 0.f)) {
+          eval_mvc_boundary(verts, p, weights);
+          return;
+        }
+
+        float t_curr = mvc_half_tan<P>(cross, dot);
+        weights[i]   = (t_prev + t_curr) / r_curr;
+        weights_sum += weights[i];
+
+        s_curr = s_next;
+        r_curr = r_next;
+        t_prev = t_curr;
+      }
+
+      // Normalize w_i over sum of w_j
+      float rcp = 1.f / weights_sum;
+      for (uint i = 0; i < n; ++i)
+        weights[i] *= rcp;
+    }
+
+    // Fixed-size form of eval_mvc(...) for polygons of N vertices; loops over vertices have 
+    // constant trip counts and wrap-around indices, s.t. they unroll fully and per-vertex 
+    // terms stay in registers
+    template <uint N, MvcPrecision P>
+    void eval_mvc_fixed(std::span<const eig::Vector2f> verts,
+                        eig::Vector2f                  p,
+                        std::span<float>               weights) {
+      std::array<eig::Vector2f, N> s;
+      std::array<float, N>         r, t;
+      for (uint i = 0; i < N; ++i) {
+        s[i] = verts[i] - p;
+        r[i] = s[i].norm();
+      }
+
+      // Half-angle tangents of edges (i, i + 1); boundary case if p lies on a vertex or edge
+      bool is_valid = true;
+      for (uint i = 0; i < N; ++i) {
+        const uint j = (i + 1) % N;
+        float cross = cross_2d(s[i], s[j]), dot = s[i].dot(s[j]);
+        is_valid &= r[i] > mvc_epsilon && (std::abs(cross) > mvc_epsilon * r[i] * r[j] || dot >= 0.f);
+        t[i] = mvc_half_tan<P>(cross, dot);
+      }
+      if (!is_valid) {
+        eval_mvc_boundary(verts, p, weights);
+        return;
+      }
+
+      // w_i = (tan(a_{i-1} / 2) + tan(a_i / 2)) / r_i, normalized over sum of w_j
+      std::array<float, N> w;
+      float weights_sum = 0.f;
+      for (uint i = 0; i < N; ++i) {
+        w[i] = (t[(i + N - 1) % N] + t[i]) / r[i];
+        weights_sum += w[i];
+      }
+      float rcp = 1.f / weights_sum;
+      for (uint i = 0; i < N; ++i)
+        weights[i] = w[i] * rcp;
+    }
+
+    // Jump table over fixed-size forms of eval_mvc(...), indexed by vertex count; entries
+    // for fewer than three vertices are unused
+    template <MvcPrecision P>
+    constexpr auto eval_mvc_fixed_table = []<uint... N>(std::integer_sequence<uint, N...>) {
+      using EvalFn = void (*)(std::span<const eig::Vector2f>, eig::Vector2f, std::span<float>);
+      return std::array<EvalFn, sizeof...(N)> { (N < 3 ? nullptr : &eval_mvc_fixed<std::max(N, 3u), P>)... };
+    }(std::make_integer_sequence<uint, kernel_max_fixed_size + 1>());
+
+    // Dispatch to a fixed-size form of eval_mvc(...) if one exists, or the generic form otherwise
+    template <MvcPrecision P>
+    void eval_mvc_dispatch(std::span<const eig::Vector2f> verts,
+                           eig::Vector2f                  p,
+                           std::span<float>               weights) {
+      if (verts.size() <= kernel_max_fixed_size)
+        eval_mvc_fixed_table<P>[verts.size()](verts, p, weights);
+      else
+        eval_mvc<P>(verts, p, weights);
+    }
+
+    // Form of eval_mvc(...) over the rings of a polygon with holes; per-ring weights follow
+    // the single-ring loop, scaled by the ring's sign, and are normalized over all rings
+    template <MvcPrecision P>
+    void eval_mvc(std::span<const eig::Vector2f> verts,
+                  std::span<const uint>          hole_offsets,
+                  std::span<const float>         signs,
+                  eig::Vector2f                  p,
+                  std::span<float>               weights) {
+      float weights_sum = 0.f;
+      for (uint r = 0; r < signs.size(); ++r) {
+        auto [first, last] = polygon_ring(hole_offsets, verts.size(), r);
+        auto ring          = verts.subspan(first, last - first);
+        const uint n = ring.size();
+
+        eig::Vector2f s_prev = ring[n - 1] - p;
+        eig::Vector2f s_curr = ring[0] - p;
+        float         r_curr = s_curr.norm();
+        float         t_prev = mvc_half_tan<P>(cross_2d(s_prev, s_curr), s_prev.dot(s_curr));
+        for (uint i = 0; i < n; ++i) {
+          uint j = (i + 1 == n) ? 0 : i + 1;
+          eig::Vector2f s_next = ring[j] - p;
+          float         r_next = s_next.norm();
+
+          // Boundary case; p lies on a vertex or edge of this ring
+          float cross = cross_2d(s_curr, s_next), dot = s_curr.dot(s_next);
+          if (r_curr <= mvc_epsilon || (std::abs(cross) <= mvc_epsilon * r_curr * r_next && dot < 0.f)) {
+            std::ranges::fill(weights.subspan(0, verts.size()), 0.f);
+            eval_mvc_boundary(ring, p, weights.subspan(first, n));
+            return;
+          }
+
+          float t_curr        = mvc_half_tan<P>(cross, dot);
+          weights[first + i]  = signs[r] * (t_prev + t_curr) / r_curr;
+          weights_sum        += weights[first + i];
+
+          s_curr = s_next;
+          r_curr = r_next;
+          t_prev = t_curr;
+        }
+      }
+
+      float rcp = 1.f / weights_sum;
+      for (uint i = 0; i < verts.size(); ++i)
+        weights[i] *= rcp;
+    }
+
+    template <MvcPrecision P>
+    void eval_mvc(std::span<const eig::Vector2f> verts,
+                  eig::Vector2f                  p,
+                  std::span<float>               weights,
+                  std::span<eig::Vector2f>       grads) {
+      const uint n = verts.size();
+
+      // Vectors from p to current vertex, their angle gradients, and the half-angle tangent 
+      // of the previous edge together with its gradient; with a_i the signed angle of edge i,
+      // d(a_i) = g_{i+1} - g_i and d(tan(a_i / 2)) = (1 + tan^2(a_i / 2)) / 2 * d(a_i)
+      eig::Vector2f s_prev  = verts[n - 1] - p;
+      eig::Vector2f s_curr  = verts[0] - p;
+      float         r_curr  = s_curr.norm();
+      eig::Vector2f g_curr  = mvc_angle_grad(s_curr, r_curr);
+      float         t_prev  = mvc_half_tan<P>(cross_2d(s_prev, s_curr), s_prev.dot(s_curr));
+      eig::Vector2f dt_prev = .5f * (1.f + t_prev * t_prev) 
+                            * (g_curr - mvc_angle_grad(s_prev, s_prev.norm()));
+
+      // Iterate polygon vertices; w_i = (tan(a_{i-1} / 2) + tan(a_i / 2)) / r_i, and
+      // d(w_i) = (d(tan(a_{i-1} / 2)) + d(tan(a_i / 2))) / r_i + w_i * s_i / r_i^2
+      float         weights_sum = 0.f;
+      eig::Vector2f grads_sum   = eig::Vector2f::Zero();
+      for (uint i = 0; i < n; ++i) {
+        uint j = (i + 1 == n) ? 0 : i + 1;
+        eig::Vector2f s_next = verts[j] - p;
+        float         r_next = s_next.norm();
+
+        // Boundary case; p lies on a vertex or edge, where gradients are undefined
+        float cross = cross_2d(s_curr, s_next), dot = s_curr.dot(s_next);
+        if (r_curr <= mvc_epsilon || (std::abs(cross) <= mvc_epsilon * r_curr * r_next && dot < 0.f)) {
+          eval_mvc_boundary(verts, p, weights);
+          std::ranges::fill(grads.subspan(0, n), eig::Vector2f::Zero());
+          return;
+        }
+        
+        eig::Vector2f g_next  = mvc_angle_grad(s_next, r_next);
+        float         t_curr  = mvc_half_tan<P>(cross, dot);
+        eig::Vector2f dt_curr = .5f * (1.f + t_curr * t_curr) * (g_next - g_curr);
+        
+        float rcp_r = 1.f / r_curr;
+        weights[i]  = (t_prev + t_curr) * rcp_r;
+        grads[i]    = (dt_prev + dt_curr) * rcp_r + weights[i] * rcp_r * rcp_r * s_curr;
+        weights_sum += weights[i];
+        grads_sum   += grads[i];
+
+        s_curr  = s_next;
+        r_curr  = r_next;
+        g_curr  = g_next;
+        t_prev  = t_curr;
+        dt_prev = dt_curr;
+      }
+
+      // Normalize w_i over sum of w_j, and apply quotient rule to gradients
+      float rcp = 1.f / weights_sum;
+      for (uint i = 0; i < n; ++i) {
+        weights[i] *= rcp;
+        grads[i]    = (grads[i] - weights[i] * grads_sum) * rcp;
+      }
+    }
+  } // namespace dtl
+
+  void eval_mvc(std::span<const eig::Vector2f> verts,
+                eig::Vector2f                  p,
+                std::span<float>               weights,
+                MvcPrecision                   precision) {
+    dbg::check_expr(verts.size() >= 3,              "eval_mvc(...) requires at least three vertices");
+    dbg::check_expr(weights.size() >= verts.size(), "eval_mvc(...) requires a weight per vertex");
+    if (precision == MvcPrecision::eFast)
+      dtl::eval_mvc_dispatch<MvcPrecision::eFast>(verts, p, weights);
+    else
+      dtl::eval_mvc_dispatch<MvcPrecision::eExact>(verts, p, weights);
+  }
+
+  void eval_mvc(std::span<const eig::Vector2f> verts,
+                std::span<const eig::Vector2f> points,
+                std::span<float>               weights,
+                MvcPrecision                   precision) {
+    const uint n = verts.size();
+    dbg::check_expr(n >= 3, "eval_mvc(...) requires at least three vertices");
+    dbg::check_expr(weights.size() >= points.size() * n, 
+      "eval_mvc(...) requires a weight per vertex per point");
+
+    const auto &kernels  = kernel_table();
+    const auto  verts_f  = cast_span<const float>(verts);
+    const auto  points_f = cast_span<const float>(points);
+    const uint  n_blocks = ceil_div(static_cast<uint>(points.size()), kernel_block_size);
+    #pragma omp parallel
+    {
+      // Block-local data; weights are stored per vertex in w
+      std::vector<float> w(n * kernel_block_size);
+      alignas(64) std::array<float, kernel_block_size> sum;
+      alignas(64) std::array<int,   kernel_block_size> valid;
+
+      #pragma omp for schedule(static)
+      for (int block = 0; block < static_cast<int>(n_blocks); ++block) {
+        uint first = block * kernel_block_size;
+        uint size  = std::min(kernel_block_size, static_cast<uint>(points.size()) - first);
+        kernels.mvc_block(verts_f.data(), n, &points_f[2 * first], size, 
+          precision == MvcPrecision::eFast, false, w.data(), sum.data(), valid.data());
+
+        // Normalize and scatter weights; points on the boundary take the scalar path. Vector
+        // kernels may flag points near the boundary tolerance that the scalar test does not,
+        // e.g. through fused multiply-adds, in which case the scalar form evaluates them
+        for (uint b = 0; b < size; ++b) {
+          auto weights_b = weights.subspan((first + b) * n, n);
+          if (!valid[b]) {
+            if (dtl::eval_mvc_boundary(verts, points[first + b], weights_b))
+              continue;
+            if (precision == MvcPrecision::eFast)
+              dtl::eval_mvc<MvcPrecision::eFast>(verts, points[first + b], weights_b);
+            else
+              dtl::eval_mvc<MvcPrecision::eExact>(verts, points[first + b], weights_b);
+            continue;
+          }
+          float rcp = 1.f / sum[b];
+          for (uint i = 0; i < n; ++i)
+            weights_b[i] = w[i * kernel_block_size + b] * rcp;
+        }
+      }
+    }
+  }
+
+  void eval_mvc(std::span<const eig::Vector2f> verts,
+                eig::Vector2f                  p,
+                std::span<float>               weights,
+                std::span<eig::Vector2f>       grads,
+                MvcPrecision                   precision) {
+    dbg::check_expr(verts.size() >= 3,              "eval_mvc(...) requires at least three vertices");
+    dbg::check_expr(weights.size() >= verts.size(), "eval_mvc(...) requires a weight per vertex");
+    dbg::check_expr(grads.size() >= verts.size(),   "eval_mvc(...) requires a gradient per vertex");
+    if (precision == MvcPrecision::eFast)
+      dtl::eval_mvc<MvcPrecision::eFast>(verts, p, weights, grads);
+    else
+      dtl::eval_mvc<MvcPrecision::eExact>(verts, p, weights, grads);
+  }
+
+  void eval_mvc(std::span<const eig::Vector2f> verts,
+                std::span<const eig::Vector2f> points,
+                std::span<float>               weights,
+                std::span<eig::Vector2f>       grads,
+                MvcPrecision                   precision) {
+    const size_t n = verts.size();
+    dbg::check_expr(weights.size() >= points.size() * n && grads.size() >= points.size() * n, 
+      "eval_mvc(...) requires a weight and gradient per vertex per point");
+
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < static_cast<int>(points.size()); ++i)
+      eval_mvc(verts, points[i], weights.subspan(i * n, n), grads.subspan(i * n, n), precision);
+  }
+
+  std::vector<float> mvc_ring_signs(std::span<const eig::Vector2f> verts,
+                                    std::span<const uint>          hole_offsets) {
+    std::vector<float> signs(hole_offsets.size() + 1);
+    for (uint r = 0; r < signs.size(); ++r) {
+      auto [first, last] = polygon_ring(hole_offsets, verts.size(), r);
+      dbg::check_expr(last >= first + 3, "mvc_ring_signs(...) requires at least three vertices per ring");
+      float area = 0.f;
+      for (uint i = first, j = last - 1; i < last; j = i++)
+        area += dtl::cross_2d(verts[j], verts[i]);
+      signs[r] = ((area > 0.f) == (r == 0)) ? 1.f : -1.f;
+    }
+    return signs;
+  }
+
+  void eval_mvc(std::span<const eig::Vector2f> verts,
+                std::span<const uint>          hole_offsets,
+                eig::Vector2f                  p,
+                std::span<float>               weights,
+                MvcPrecision                   precision) {
+    dbg::check_expr(weights.size() >= verts.size(), "eval_mvc(...) requires a weight per vertex");
+    auto signs = mvc_ring_signs(verts, hole_offsets);
+    if (precision == MvcPrecision::eFast)
+      dtl::eval_mvc<MvcPrecision::eFast>(verts, hole_offsets, signs, p, weights);
+    else
+      dtl::eval_mvc<MvcPrecision::eExact>(verts, hole_offsets, signs, p, weights);
+  }
+
+  void eval_mvc(std::span<const eig::Vector2f> verts,
+                std::span<const uint>          hole_offsets,
+                std::span<const eig::Vector2f> points,
+                std::span<float>               weights,
+                MvcPrecision                   precision) {
+    const size_t n = verts.size();
+    dbg::check_expr(weights.size() >= points.size() * n, 
+      "eval_mvc(...) requires a weight per vertex per point");
+    // Ring orientation is shared by all points
+    auto signs = mvc_ring_signs(verts, hole_offsets);
+    #pragma omp parallel for schedule(static)
+    for (int i = 0; i < static_cast<int>(points.size()); ++i) {
+      if (precision == MvcPrecision::eFast)
+        dtl::eval_mvc<MvcPrecision::eFast>(verts, hole_offsets, signs, points[i], weights.subspan(i * n, n));
+      else
+        dtl::eval_mvc<MvcPrecision::eExact>(verts, hole_offsets, signs, points[i], weights.subspan(i * n, n));
+    }
+  }
+
+  void eval_wachspress(std::span<const eig::Vector2f> verts,
+                       eig::Vector2f                  p,
+                       std::span<float>               weights) {
+    const uint n = verts.size();
+    dbg::check_expr(n >= 3,              "eval_wachspress(...) requires at least three vertices");
+    dbg::check_expr(weights.size() >= n, "eval_wachspress(...) requires a weight per vertex");
+
+    // Vectors from p to previous/current vertex, and twice the signed area of their triangle
+    eig::Vector2f s_prev = verts[n - 1] - p;
+    eig::Vector2f s_curr = verts[0] - p;
+    float         a_prev = dtl::cross_2d(s_prev, s_curr);
+
+    // Iterate polygon vertices; w_i = C_i / (A_{i-1} * A_i), with C_i the area of 
+    // triangle (v_{i-1}, v_i, v_{i+1}) and A_i the area of triangle (p, v_i, v_{i+1})
+    float weights_sum = 0.f;
+    for (uint i = 0; i < n; ++i) {
+      uint j = (i + 1 == n) ? 0 : i + 1;
+      eig::Vector2f s_next = verts[j] - p;
+      eig::Vector2f e_next = s_next - s_curr;
+      float         a_curr = dtl::cross_2d(s_curr, s_next);
+      
+      // Boundary or exterior case; p lies on or beyond an edge's supporting line
+      if (a_curr * a_prev <= 0.f || std::abs(a_curr) <= mvc_epsilon * e_next.squaredNorm()) {
+        eval_mvc(verts, p, weights);
+        return;
+      }
+
+      weights[i]   = dtl::cross_2d(s_curr - s_prev, e_next) / (a_prev * a_curr);
+      weights_sum += weights[i];
+
+      s_prev = s_curr;
+      s_curr = s_next;
+      a_prev = a_curr;
+    }
+
+    // Normalize w_i over sum of w_j
+    float rcp = 1.f / weights_sum;
+    for (uint i = 0; i < n; ++i)
+      weights[i] *= rcp;
+  }
+
+  void eval_wachspress(std::span<const eig::Vector2f> verts,
+                       std::span<const eig::Vector2f> points,
+                       std::span<float>               weights) {
+    const uint n = verts.size();
+    dbg::check_expr(n >= 3, "eval_wachspress(...) requires at least three vertices");
+    dbg::check_expr(weights.size() >= points.size() * n, 
+      "eval_wachspress(...) requires a weight per vertex per point");
+
+    // Per-polygon terms; C_i, and squared edge lengths for boundary tests
+    std::vector<float> c(n), e2(n);
+    for (uint i = 0; i < n; ++i) {
+      const auto &v_prev = verts[(i + n - 1) % n], &v_curr = verts[i], &v_next = verts[(i + 1) % n];
+      c[i]  = dtl::cross_2d(v_curr - v_prev, v_next - v_curr);
+      e2[i] = (v_next - v_curr).squaredNorm();
+    }
+
+    const auto &kernels  = kernel_table();
+    const auto  verts_f  = cast_span<const float>(verts);
+    const auto  points_f = cast_span<const float>(points);
+    const uint  n_blocks = ceil_div(static_cast<uint>(points.size()), kernel_block_size);
+    #pragma omp parallel
+    {
+      // Block-local data; weights are stored per vertex in w
+      std::vector<float> w(n * kernel_block_size);
+      alignas(64) std::array<float, kernel_block_size> sum;
+      alignas(64) std::array<int,   kernel_block_size> valid;
+
+      #pragma omp for schedule(static)
+      for (int block = 0; block < static_cast<int>(n_blocks); ++block) {
+        uint first = block * kernel_block_size;
+        uint size  = std::min(kernel_block_size, static_cast<uint>(points.size()) - first);
+        kernels.wachspress_block(verts_f.data(), c.data(), e2.data(), n, &points_f[2 * first], size,
+          false, w.data(), sum.data(), valid.data());
+
+        // Normalize and scatter weights; points on the boundary or outside the
+        // polygon take the scalar fallback path
+        for (uint b = 0; b < size; ++b) {
+          auto weights_b = weights.subspan((first + b) * n, n);
+          if (!valid[b]) {
+            eval_wachspress(verts, points[first + b], weights_b);
+            continue;
+          }
+          float rcp = 1.f / sum[b];
+          for (uint i = 0; i < n; ++i)
+            weights_b[i] = w[i * kernel_block_size + b] * rcp;
+        }
+      }
+    }
+  }
+
+  void eval_coords(CoordMethod                    method,
+                   std::span<const eig::Vector2f> verts,
+                   std::span<const eig::Vector2f> points,
+                   std::span<float>               weights) {
+    if (method == CoordMethod::eAuto)
+      method = is_convex_polygon(verts) ? CoordMethod::eWachspress : CoordMethod::eMeanValue;
+    if (method == CoordMethod::eWachspress)
+      eval_wachspress(verts, points, weights);
+    else
+      eval_mvc(verts, points, weights);
+  }
+
+  eig::Array3f eval_mvc_colr(std::span<const eig::Vector2f>  verts,
+                             std::span<const eig::AlArray3f> colrs,
+                             eig::Vector2f                   p,
+                             std::span<float>                weights,
+                             MvcPrecision                    precision) {
+    eval_mvc(verts, p, weights, precision);
+    eig::Array3f colr = 0.f;
+    for (uint i = 0; i < verts.size(); ++i)
+      colr += weights[i] * colrs[i];
+    return colr;
+  }
+} // namespace prg
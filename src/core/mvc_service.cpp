@@ -0,0 +1,706 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <core/mvc_service.hpp>
+#include <core/mesh.hpp>
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <poll.h>
+  #include <sys/mman.h>
+  #include <sys/socket.h>
+  #include <sys/stat.h>
+  #include <sys/un.h>
+  #include <unistd.h>
+#endif
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#ifndef _WIN32
+namespace prg {
+  namespace dtl {
+    // Message a client sends once, on connection, alongside its arena's file descriptor; the
+    // server acknowledges with a zero status
+    struct MvcHello {
+      std::array<char, 8> magic = { 'P', 'R', 'G', 'M', 'V', 'C', 'S', '1' };
+      uint64_t            arena_size;
+    };
+
+    static_assert(sizeof(MvcRequest) == 64);
+    static_assert(sizeof(MvcReply)   == 24);
+
+    // Send/receive of a complete message; returns false if the peer disconnected, or if
+    // a non-blocking socket would block
+    inline
+    bool send_all(int fd, std::span<const std::byte> data) {
+      while (!data.empty()) {
+        ssize_t n = ::send(fd, data.data(), data.size(), MSG_NOSIGNAL);
+        if (n < 0 && errno == EINTR)
+          continue;
+        guard(n > 0, false);
+        data = data.subspan(n);
+      }
+      return true;
+    }
+
+    inline
+    bool recv_all(int fd, std::span<std::byte> data) {
+      while (!data.empty()) {
+        ssize_t n = ::recv(fd, data.data(), data.size(), MSG_WAITALL);
+        if (n < 0 && errno == EINTR)
+          continue;
+        guard(n > 0, false);
+        data = data.subspan(n);
+      }
+      return true;
+    }
+
+    inline
+    sockaddr_un socket_address(const std::filesystem::path &path) {
+      sockaddr_un addr = { .sun_family = AF_UNIX };
+      if (path.string().size() >= sizeof(addr.sun_path))
+        dtl::throw_keyed_error("socket_address(...) failed", "socket path too long",
+                               {{ "path", path.string() }, { "errno", std::strerror(errno) }});
+      std::strncpy(addr.sun_path, path.c_str(), sizeof(addr.sun_path) - 1);
+      return addr;
+    }
+
+    // Result alongside the inputs it was computed from, s.t. hash collisions are detected
+    struct CachedResult {
+      std::vector<std::byte> input, result;
+    };
+
+    // Least recently used cache of results keyed by hash, bounded by the total size of its
+    // inputs and results; values are shared, s.t. evicted results stay valid for holders
+    class ResultCache {
+      using Value = std::shared_ptr<const CachedResult>;
+      using Order = std::list<std::pair<uint64_t, Value>>;
+
+      Order                                          m_order; // Most recently used first
+      std::unordered_map<uint64_t, Order::iterator> m_entries;
+      size_t                                         m_size     = 0;
+      size_t                                         m_capacity = 0;
+
+    public:
+      ResultCache() = default;
+      explicit ResultCache(size_t capacity) : m_capacity(capacity) { }
+
+      // Find a result by key; misses if the stored inputs differ from the given ones
+      Value find(uint64_t key, std::span<const std::byte> input) {
+        auto it = m_entries.find(key);
+        guard(it != m_entries.end(), nullptr);
+        guard(std::ranges::equal(it->second->second->input, input), nullptr);
+        m_order.splice(m_order.begin(), m_order, it->second);
+        return it->second->second;
+      }
+
+      void insert(uint64_t key, std::span<const std::byte> input, std::span<const std::byte> result) {
+        size_t size = input.size() + result.size();
+        guard(size <= m_capacity && !m_entries.contains(key));
+        m_order.emplace_front(key, std::make_shared<const CachedResult>(
+          std::vector<std::byte>(range_iter(input)), std::vector<std::byte>(range_iter(result))));
+        m_entries.emplace(key, m_order.begin());
+        m_size += size;
+        while (m_size > m_capacity) {
+          const auto &value = *m_order.back().second;
+          m_size -= value.input.size() + value.result.size();
+          m_entries.erase(m_order.back().first);
+          m_order.pop_back();
+        }
+      }
+    };
+
+    // Hash over a value, chained through seed
+    template <typename T>
+    uint64_t hash_value(const T &value, uint64_t seed) {
+      return hash_bytes(obj_span<const std::byte>(value), seed);
+    }
+
+    // Group of values with equal contents, among groups of equal hash; a new group is added 
+    // if none matches, s.t. hash collisions never merge unequal values
+    template <typename T, typename Eq>
+    std::vector<T> & find_group(std::vector<std::vector<T>>              &groups,
+                                std::unordered_multimap<uint64_t, size_t> &index,
+                                uint64_t                                   hash,
+                                const T                                   &value,
+                                Eq                                         eq) {
+      auto [first, last] = index.equal_range(hash);
+      auto it = std::find_if(first, last, [&](const auto &i) { return eq(groups[i.second].front(), value); });
+      if (it == last) {
+        it = index.emplace(hash, groups.size());
+        groups.emplace_back();
+      }
+      return groups[it->second];
+    }
+  } // namespace dtl
+
+  struct MvcServer::Impl {
+    // Client sockets are non-blocking; partially received hello and request messages are
+    // buffered per client, s.t. a stalled client never holds up the others. The arena is
+    // mapped once the hello is complete
+    struct Client {
+      int        fd;
+      std::byte *arena    = nullptr;
+      size_t     size     = 0;
+      int        arena_fd = -1;
+      std::array<std::byte, std::max(sizeof(dtl::MvcHello), sizeof(MvcRequest))> buffer;
+      size_t     n_buffered = 0;
+      bool       is_broken  = false; // Set if a reply could not be sent
+    };
+
+    // Request in a batch; its inputs are copied out of the arena once, s.t. clients cannot
+    // alter them after validation. The copy holds, in order, the polygon's sizes, vertices
+    // and holes, followed by the request's type, precision and sizes, and its query points
+    struct Pending {
+      uint                           client;
+      MvcRequest                     request;
+      MvcReply                       reply = { .status = MvcStatus::eOk };
+      std::vector<std::byte>         input;            // Server copy of the request's inputs
+      size_t                         polygon_size = 0; // Leading bytes of input covering the polygon
+      std::span<const eig::Vector2f> verts;            // Ranges inside input
+      std::span<const uint>          holes;
+      std::span<const eig::Vector2f> points;
+      std::span<std::byte>           out;
+      uint64_t                       key = 0;          // Cache key of the result, over all of input
+
+      std::span<const std::byte> polygon() const { return std::span(input).first(polygon_size); }
+    };
+
+    MvcServerInfo       info;
+    int                 listen_fd = -1;
+    std::array<int, 2>  wake_fds  = { -1, -1 };
+    std::atomic<bool>   is_stopped = false;
+    std::vector<Client> clients;
+    dtl::ResultCache    cache;
+    mutable std::mutex  stats_mutex;
+    MvcServerStats      stats;
+
+    // Arena range of a request as a typed span; empty if it lies outside the arena or is
+    // misaligned, which the caller tests against the expected size
+    template <typename T>
+    std::span<T> arena_span(const Client &client, uint64_t offset, uint64_t n) const {
+      guard(n > 0 && offset % alignof(T) == 0 && offset <= client.size, {});
+      guard(n <= (client.size - offset) / sizeof(T), {});
+      return { reinterpret_cast<T *>(client.arena + offset), static_cast<size_t>(n) };
+    }
+
+    void accept_client();
+    void drop_client(uint i);
+
+    // Receive part of a readable client's hello, and map its arena once complete; false if
+    // the client disconnected or its arena was rejected
+    bool read_hello(uint i);
+
+    // Receive part of a request from a readable client, and add it to a batch once complete;
+    // false if the client disconnected
+    bool read_request(uint i, std::vector<Pending> &batch);
+
+    // Resolve, evaluate and reply to a batch of requests
+    void process(std::vector<Pending> &batch);
+  };
+
+  void MvcServer::Impl::accept_client() {
+    int fd = ::accept(listen_fd, nullptr, nullptr);
+    guard(fd >= 0);
+    ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+    ::fcntl(fd, F_SETFL, O_NONBLOCK);
+    clients.push_back({ .fd = fd });
+  }
+
+  void MvcServer::Impl::drop_client(uint i) {
+    bool is_accepted = clients[i].arena != nullptr;
+    if (is_accepted)
+      ::munmap(clients[i].arena, clients[i].size);
+    if (clients[i].arena_fd >= 0)
+      ::close(clients[i].arena_fd);
+    ::close(clients[i].fd);
+    clients.erase(clients.begin() + i);
+    guard(is_accepted);
+    std::lock_guard lock(stats_mutex);
+    stats.clients--;
+  }
+
+  bool MvcServer::Impl::read_hello(uint i) {
+    auto &client = clients[i];
+
+    // Receive the remainder of the hello message; the arena's file descriptor arrives
+    // alongside its first bytes
+    iovec iov = { .iov_base = client.buffer.data()   + client.n_buffered, 
+                  .iov_len  = sizeof(dtl::MvcHello) - client.n_buffered };
+    alignas(cmsghdr) std::array<char, CMSG_SPACE(sizeof(int))> control;
+    msghdr msg = { .msg_iov = &iov, .msg_iovlen = 1, .msg_control = control.data(), .msg_controllen = control.size() };
+    ssize_t n = ::recvmsg(client.fd, &msg, 0);
+    if (n < 0)
+      return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+    guard(n > 0, false);
+    if (cmsghdr *cmsg = CMSG_FIRSTHDR(&msg); cmsg && cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_RIGHTS) {
+      int arena_fd;
+      std::memcpy(&arena_fd, CMSG_DATA(cmsg), sizeof(int));
+      if (client.arena_fd >= 0) {
+        ::close(arena_fd);
+        return false;
+      }
+      client.arena_fd = arena_fd;
+    }
+    client.n_buffered += n;
+    guard(client.n_buffered == sizeof(dtl::MvcHello), true);
+
+    // The arena must cover the claimed size, s.t. access never faults past its end; on Linux,
+    // it must also be sealed against shrinking, s.t. this holds after the test
+    dtl::MvcHello hello;
+    std::memcpy(&hello, client.buffer.data(), sizeof(hello));
+    client.n_buffered = 0;
+    struct stat st;
+    bool is_valid = hello.magic == dtl::MvcHello().magic && client.arena_fd >= 0 && hello.arena_size > 0
+                 && ::fstat(client.arena_fd, &st) == 0 && hello.arena_size <= static_cast<uint64_t>(st.st_size);
+#ifdef __linux__
+    int seals = is_valid ? ::fcntl(client.arena_fd, F_GET_SEALS) : -1;
+    is_valid  = seals >= 0 && (seals & F_SEAL_SHRINK) != 0;
+#endif
+    void *arena = is_valid ? ::mmap(nullptr, hello.arena_size, PROT_READ | PROT_WRITE, MAP_SHARED, client.arena_fd, 0) 
+                           : MAP_FAILED;
+    if (client.arena_fd >= 0)
+      ::close(client.arena_fd);
+    client.arena_fd = -1;
+
+    uint status = arena == MAP_FAILED ? 1 : 0;
+    if (!dtl::send_all(client.fd, obj_span<const std::byte>(status)) || arena == MAP_FAILED) {
+      if (arena != MAP_FAILED)
+        ::munmap(arena, hello.arena_size);
+      return false;
+    }
+
+    client.arena = static_cast<std::byte *>(arena);
+    client.size  = hello.arena_size;
+    std::lock_guard lock(stats_mutex);
+    stats.clients++;
+    return true;
+  }
+
+  bool MvcServer::Impl::read_request(uint i, std::vector<Pending> &batch) {
+    auto &client = clients[i];
+    guard(client.arena, read_hello(i));
+    
+    ssize_t n = ::recv(client.fd, client.buffer.data() + client.n_buffered, sizeof(MvcRequest) - client.n_buffered, 0);
+    if (n < 0)
+      return errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR;
+    guard(n > 0, false);
+    client.n_buffered += n;
+    guard(client.n_buffered == sizeof(MvcRequest), true);
+
+    Pending p = { .client = i };
+    std::memcpy(&p.request, client.buffer.data(), sizeof(MvcRequest));
+    client.n_buffered = 0;
+    batch.push_back(p);
+    return true;
+  }
+
+  void MvcServer::Impl::process(std::vector<Pending> &batch) {
+    // Resolve arena ranges, copy inputs into server memory, validate polygons, and establish
+    // cache keys; keys hash sizes ahead of contents, s.t. ranges of different splits differ
+    for (auto &p : batch) {
+      const auto &client = clients[p.client];
+      const auto &r      = p.request;
+      auto verts  = arena_span<const eig::Vector2f>(client, r.verts_offset,  r.n_verts);
+      auto holes  = r.n_holes ? arena_span<const uint>(client, r.holes_offset, r.n_holes) : std::span<const uint>();
+      auto points = r.type == MvcRequestType::eEvalMvc
+                  ? arena_span<const eig::Vector2f>(client, r.points_offset, r.n_points) : std::span<const eig::Vector2f>();
+      p.out       = arena_span<std::byte>(client, r.out_offset, r.out_size);
+
+      // Output ranges must be aligned to the written type
+      size_t out_align = r.type == MvcRequestType::eTriangulate ? alignof(eig::Array3u) : alignof(float);
+      bool is_valid = verts.size() == r.n_verts && holes.size() == r.n_holes && r.n_verts >= 3
+                   && (r.type == MvcRequestType::eTriangulate || (points.size() == r.n_points && r.n_points > 0))
+                   && p.out.size() == r.out_size && r.out_offset % out_align == 0;
+      if (!is_valid) {
+        p.reply.status = MvcStatus::eInvalid;
+        continue;
+      }
+
+      auto append = [&](std::span<const std::byte> data) { p.input.insert(p.input.end(), range_iter(data)); };
+      std::array<uint, 2> polygon_sizes = { r.n_verts, r.n_holes };
+      std::array<uint, 3> request_sizes = { static_cast<uint>(r.type), static_cast<uint>(r.precision), 
+                                            r.type == MvcRequestType::eEvalMvc ? r.n_points : 0u };
+      p.input.reserve(sizeof(polygon_sizes) + verts.size_bytes() + holes.size_bytes() 
+                    + sizeof(request_sizes) + points.size_bytes());
+      append(obj_span<const std::byte>(polygon_sizes));
+      append(std::as_bytes(verts));
+      append(std::as_bytes(holes));
+      p.polygon_size = p.input.size();
+      append(obj_span<const std::byte>(request_sizes));
+      append(std::as_bytes(points));
+      
+      size_t offset = sizeof(polygon_sizes);
+      p.verts  = cast_span<const eig::Vector2f>(std::span(p.input).subspan(offset, verts.size_bytes()));
+      offset  += verts.size_bytes();
+      p.holes  = cast_span<const uint>(std::span(p.input).subspan(offset, holes.size_bytes()));
+      offset   = p.polygon_size + sizeof(request_sizes);
+      p.points = cast_span<const eig::Vector2f>(std::span(p.input).subspan(offset, points.size_bytes()));
+
+      for (uint h = 0; h <= r.n_holes && is_valid; ++h) {
+        auto [first, last] = polygon_ring(p.holes, r.n_verts, h);
+        is_valid &= first < last && last - first >= 3 && last <= r.n_verts;
+      }
+      if (!is_valid) {
+        p.reply.status = MvcStatus::eInvalid;
+        continue;
+      }
+
+      p.reply.polygon_hash = hash_bytes(p.polygon());
+      p.key                = hash_bytes(p.input);
+      if (r.type == MvcRequestType::eEvalMvc) {
+        // Output size is known up front for weights; triangulations are tested once built
+        size_t n_weights = static_cast<size_t>(r.n_points) * r.n_verts;
+        if (r.out_size < n_weights * sizeof(float)) {
+          p.reply.status = MvcStatus::eTooSmall;
+          p.reply.count  = static_cast<uint>(n_weights);
+        }
+      }
+    }
+
+    // Write a result to a request's output range
+    auto write = [](Pending &p, std::span<const std::byte> data) {
+      uint size = p.request.type == MvcRequestType::eTriangulate ? sizeof(eig::Array3u) : sizeof(float);
+      p.reply.count = static_cast<uint>(data.size() / size);
+      if (data.size() > p.out.size()) {
+        p.reply.status = MvcStatus::eTooSmall;
+        return;
+      }
+      if (data.data() != p.out.data())
+        std::ranges::copy(data, p.out.begin());
+    };
+
+    // Serve cache hits, and group the remaining requests by inputs; requests with equal
+    // inputs are evaluated once
+    MvcServerStats stats_ = { .requests = batch.size(), .batches = 1 };
+    std::vector<std::vector<Pending *>>       groups;
+    std::unordered_multimap<uint64_t, size_t> groups_index;
+    for (auto &p : batch) {
+      guard_continue(p.reply.status == MvcStatus::eOk);
+      if (auto value = cache.find(p.key, p.input)) {
+        write(p, value->result);
+        p.reply.is_cached = true;
+        stats_.hits++;
+      } else {
+        dtl::find_group(groups, groups_index, p.key, &p, [](const Pending *a, const Pending *b) { 
+          return a->input == b->input; }).push_back(&p);
+        stats_.misses++;
+      }
+    }
+
+    // Triangulations are evaluated per group, and evaluations per polygon and precision, s.t.
+    // points of all groups on the same polygon are concatenated into one batched call
+    std::vector<std::vector<std::vector<Pending *> *>> polygons;
+    std::unordered_multimap<uint64_t, size_t>          polygons_index;
+    for (auto &group : groups) {
+      const auto &p = *group.front();
+      stats_.coalesced += group.size() - 1;
+      if (p.request.type == MvcRequestType::eTriangulate) {
+        auto elems = triangulate_polygon(p.verts, p.holes);
+        for (auto *q : group)
+          write(*q, std::as_bytes(std::span(elems)));
+        for (auto *q : group)
+          q->reply.batch_size = group.size();
+        cache.insert(p.key, p.input, std::as_bytes(std::span(elems)));
+      } else {
+        dtl::find_group(polygons, polygons_index, dtl::hash_value(p.request.precision, p.reply.polygon_hash), &group,
+          [](const std::vector<Pending *> *a, const std::vector<Pending *> *b) {
+            const auto &p = *a->front(), &q = *b->front();
+            return p.request.precision == q.request.precision && std::ranges::equal(p.polygon(), q.polygon()); 
+          }).push_back(&group);
+      }
+    }
+
+    for (auto &keys : polygons) {
+      const auto &p = *keys.front()->front();
+      uint n = p.request.n_verts, batch_size = 0;
+      for (auto *group : keys)
+        batch_size += group->size();
+
+      // A single key is evaluated directly into its first requester's output range;
+      // otherwise, points of all keys are concatenated
+      std::vector<eig::Vector2f> points_concat;
+      std::vector<float>         weights_concat;
+      std::span<const eig::Vector2f> points  = p.points;
+      std::span<float>               weights = cast_span<float>(p.out).first(points.size() * n);
+      if (keys.size() > 1) {
+        for (auto *group : keys)
+          points_concat.insert(points_concat.end(), range_iter(group->front()->points));
+        weights_concat.resize(points_concat.size() * n);
+        points  = points_concat;
+        weights = weights_concat;
+      }
+
+      if (p.holes.empty())
+        prg::eval_mvc(p.verts, points, weights, p.request.precision);
+      else
+        prg::eval_mvc(p.verts, p.holes, points, weights, p.request.precision);
+      stats_.evaluations++;
+
+      size_t offset = 0;
+      for (auto *group : keys) {
+        auto result = std::as_bytes(weights.subspan(offset, group->front()->points.size() * n));
+        for (auto *q : *group) {
+          write(*q, result);
+          q->reply.batch_size = batch_size;
+        }
+        cache.insert(group->front()->key, group->front()->input, result);
+        offset += group->front()->points.size() * n;
+      }
+    }
+
+    // Update statistics before replying, s.t. clients observe them once replies arrive
+    {
+      std::lock_guard lock(stats_mutex);
+      stats.requests    += stats_.requests;
+      stats.batches     += stats_.batches;
+      stats.evaluations += stats_.evaluations;
+      stats.coalesced   += stats_.coalesced;
+      stats.hits        += stats_.hits;
+      stats.misses      += stats_.misses;
+    }
+
+    // Reply in order of arrival; clients that fail to receive are dropped after the batch
+    for (const auto &p : batch)
+      if (!dtl::send_all(clients[p.client].fd, obj_span<const std::byte>(p.reply)))
+        clients[p.client].is_broken = true;
+  }
+
+  MvcServer::MvcServer(MvcServerInfo info)
+  : m_impl(new Impl { .info = info, .cache = dtl::ResultCache(info.cache_size) }) {
+    auto addr = dtl::socket_address(info.path);
+    ::unlink(info.path.c_str());
+
+    m_impl->listen_fd = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (m_impl->listen_fd < 0
+     || ::bind(m_impl->listen_fd, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) < 0
+     || ::listen(m_impl->listen_fd, 64) < 0
+     || ::pipe(m_impl->wake_fds.data()) < 0) {
+      auto e = errno;
+      delete m_impl;
+      errno = e;
+      dtl::throw_keyed_error("MvcServer(...) failed", "could not listen on socket",
+                             {{ "path", info.path.string() }, { "errno", std::strerror(errno) }});
+    }
+    ::fcntl(m_impl->wake_fds[1], F_SETFL, O_NONBLOCK);
+  }
+
+  MvcServer::~MvcServer() {
+    while (!m_impl->clients.empty())
+      m_impl->drop_client(m_impl->clients.size() - 1);
+    ::close(m_impl->listen_fd);
+    ::close(m_impl->wake_fds[0]);
+    ::close(m_impl->wake_fds[1]);
+    ::unlink(m_impl->info.path.c_str());
+    delete m_impl;
+  }
+
+  void MvcServer::run() {
+    auto &impl = *m_impl;
+    std::vector<pollfd>       fds;
+    std::vector<Impl::Pending> batch;
+
+    // Poll the wake pipe, listening socket and clients; returns false on a stop request
+    auto poll_fds = [&](int timeout, bool accept) {
+      fds = { { impl.wake_fds[0], POLLIN, 0 }, { impl.listen_fd, static_cast<short>(accept ? POLLIN : 0), 0 } };
+      for (const auto &client : impl.clients)
+        fds.push_back({ client.fd, POLLIN, 0 });
+      guard(::poll(fds.data(), fds.size(), timeout) >= 0 || errno == EINTR, false);
+      return !impl.is_stopped;
+    };
+
+    // Read requests from readable clients; disconnected clients are dropped, which is
+    // deferred while their requests are in the batch
+    std::vector<uint> dropped;
+    auto read_clients = [&]() {
+      uint n_polled = std::min<uint>(impl.clients.size(), fds.size() - 2);
+      for (uint i = 0; i < n_polled && batch.size() < impl.info.max_batch; ++i) {
+        guard_continue(fds[i + 2].revents & (POLLIN | POLLHUP | POLLERR));
+        guard_continue(std::ranges::find(dropped, i) == dropped.end());
+        if (!impl.read_request(i, batch))
+          dropped.push_back(i);
+      }
+    };
+
+    while (!impl.is_stopped) {
+      guard_break(poll_fds(-1, true));
+      if (fds[1].revents & POLLIN)
+        impl.accept_client();
+      read_clients();
+
+      // Gather requests arriving within the batch window, then process them together
+      auto window_end = std::chrono::steady_clock::now() + std::chrono::microseconds(impl.info.batch_window);
+      while (!batch.empty() && batch.size() < impl.info.max_batch) {
+        auto remaining = std::chrono::duration_cast<std::chrono::milliseconds>(
+          window_end - std::chrono::steady_clock::now() + std::chrono::microseconds(999)).count();
+        guard_break(remaining > 0 && poll_fds(static_cast<int>(remaining), false));
+        size_t n = batch.size();
+        read_clients();
+        guard_break(batch.size() > n);
+      }
+      if (!batch.empty())
+        impl.process(batch);
+      batch.clear();
+
+      for (uint i = 0; i < impl.clients.size(); ++i)
+        if (impl.clients[i].is_broken && std::ranges::find(dropped, i) == dropped.end())
+          dropped.push_back(i);
+
+      std::ranges::sort(dropped, std::greater<>());
+      for (uint i : dropped)
+        impl.drop_client(i);
+      dropped.clear();
+    }
+  }
+
+  void MvcServer::stop() {
+    m_impl->is_stopped = true;
+    char c = 0;
+    [[maybe_unused]] auto n = ::write(m_impl->wake_fds[1], &c, 1);
+  }
+
+  MvcServerStats MvcServer::stats() const {
+    std::lock_guard lock(m_impl->stats_mutex);
+    return m_impl->stats;
+  }
+
+  MvcClient::MvcClient(const std::filesystem::path &path, size_t arena_size)
+  : m_size(arena_size) {
+    auto addr = dtl::socket_address(path);
+    m_socket = ::socket(AF_UNIX, SOCK_STREAM | SOCK_CLOEXEC, 0);
+    if (m_socket < 0 || ::connect(m_socket, reinterpret_cast<const sockaddr *>(&addr), sizeof(addr)) < 0)
+      dtl::throw_keyed_error("MvcClient(...) failed", "could not connect to socket",
+                             {{ "path", path.string() }, { "errno", std::strerror(errno) }});
+
+    // Create the arena as an unlinked shared memory object; it lives until both sides unmap.
+    // On Linux, it is a memfd sealed against shrinking, which the server requires
+    static std::atomic<uint> n_arenas = 0;
+    auto name = fmt::format("/prg_mvc_{}_{}", ::getpid(), n_arenas++);
+#ifdef __linux__
+    int arena_fd = ::memfd_create(name.c_str() + 1, MFD_CLOEXEC | MFD_ALLOW_SEALING);
+#else
+    int arena_fd = ::shm_open(name.c_str(), O_CREAT | O_EXCL | O_RDWR, 0600);
+    if (arena_fd >= 0)
+      ::shm_unlink(name.c_str());
+#endif
+    if (arena_fd < 0)
+      dtl::throw_keyed_error("MvcClient(...) failed", "could not create shared memory",
+                             {{ "path", name }, { "errno", std::strerror(errno) }});
+    bool is_sized = ::ftruncate(arena_fd, arena_size) == 0;
+#ifdef __linux__
+    is_sized = is_sized && ::fcntl(arena_fd, F_ADD_SEALS, F_SEAL_SHRINK | F_SEAL_SEAL) == 0;
+#endif
+    void *arena = is_sized
+                ? ::mmap(nullptr, arena_size, PROT_READ | PROT_WRITE, MAP_SHARED, arena_fd, 0) : MAP_FAILED;
+    if (arena == MAP_FAILED) {
+      ::close(arena_fd);
+      dtl::throw_keyed_error("MvcClient(...) failed", "could not map shared memory", {{ "path", name }, { "errno", std::strerror(errno) }});
+    }
+    m_arena = static_cast<std::byte *>(arena);
+
+    // Hand the arena to the server, and wait for its acknowledgement
+    dtl::MvcHello hello = { .arena_size = arena_size };
+    iovec iov = { .iov_base = &hello, .iov_len = sizeof(hello) };
+    alignas(cmsghdr) std::array<char, CMSG_SPACE(sizeof(int))> control = { };
+    msghdr msg = { .msg_iov = &iov, .msg_iovlen = 1, .msg_control = control.data(), .msg_controllen = control.size() };
+    cmsghdr *cmsg    = CMSG_FIRSTHDR(&msg);
+    cmsg->cmsg_level = SOL_SOCKET;
+    cmsg->cmsg_type  = SCM_RIGHTS;
+    cmsg->cmsg_len   = CMSG_LEN(sizeof(int));
+    std::memcpy(CMSG_DATA(cmsg), &arena_fd, sizeof(int));
+    ssize_t n = ::sendmsg(m_socket, &msg, MSG_NOSIGNAL);
+    ::close(arena_fd);
+
+    uint status = 1;
+    if (n != sizeof(hello) || !dtl::recv_all(m_socket, obj_span<std::byte>(status)) || status != 0)
+      dtl::throw_keyed_error("MvcClient(...) failed", "server did not accept arena",
+                             {{ "path", path.string() }, { "errno", std::strerror(errno) }});
+  }
+
+  MvcClient::~MvcClient() {
+    if (m_arena)
+      ::munmap(m_arena, m_size);
+    if (m_socket >= 0)
+      ::close(m_socket);
+  }
+
+  uint64_t MvcClient::offset_of(std::span<const std::byte> data) const {
+    guard(!data.empty(), 0);
+    if (data.data() < m_arena || data.data() + data.size() > m_arena + m_size)
+      dtl::throw_keyed_error("MvcClient::offset_of(...) failed", "request data does not lie in the client's arena");
+    return static_cast<uint64_t>(data.data() - m_arena);
+  }
+
+  MvcReply MvcClient::request(const MvcRequest &request) {
+    MvcReply reply;
+    if (!dtl::send_all(m_socket, obj_span<const std::byte>(request))
+     || !dtl::recv_all(m_socket, obj_span<std::byte>(reply)))
+      dtl::throw_keyed_error("MvcClient::request(...) failed", "lost connection to the server");
+    return reply;
+  }
+
+  MvcReply MvcClient::triangulate(std::span<const eig::Vector2f> verts,
+                                  std::span<const uint>          hole_offsets,
+                                  std::span<eig::Array3u>        elems) {
+    return request({ .type         = MvcRequestType::eTriangulate,
+                     .n_verts      = static_cast<uint>(verts.size()),
+                     .n_holes      = static_cast<uint>(hole_offsets.size()),
+                     .verts_offset = offset_of(std::as_bytes(verts)),
+                     .holes_offset = offset_of(std::as_bytes(hole_offsets)),
+                     .out_offset   = offset_of(std::as_bytes(elems)),
+                     .out_size     = elems.size_bytes() });
+  }
+
+  MvcReply MvcClient::eval_mvc(std::span<const eig::Vector2f> verts,
+                               std::span<const uint>          hole_offsets,
+                               std::span<const eig::Vector2f> points,
+                               std::span<float>               weights,
+                               MvcPrecision                   precision) {
+    return request({ .type          = MvcRequestType::eEvalMvc,
+                     .precision     = precision,
+                     .n_verts       = static_cast<uint>(verts.size()),
+                     .n_holes       = static_cast<uint>(hole_offsets.size()),
+                     .n_points      = static_cast<uint>(points.size()),
+                     .verts_offset  = offset_of(std::as_bytes(verts)),
+                     .holes_offset  = offset_of(std::as_bytes(hole_offsets)),
+                     .points_offset = offset_of(std::as_bytes(points)),
+                     .out_offset    = offset_of(std::as_bytes(weights)),
+                     .out_size      = weights.size_bytes() });
+  }
+
+  void MvcClient::swap(MvcClient &o) {
+    using std::swap;
+    swap(m_socket, o.m_socket);
+    swap(m_arena,  o.m_arena);
+    swap(m_size,   o.m_size);
+    swap(m_head,   o.m_head);
+  }
+} // namespace prg
+#endif // _WIN32
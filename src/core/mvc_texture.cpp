@@ -0,0 +1,97 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <core/mvc_texture.hpp>
+#include <glad/glad.h>
+#include <algorithm>
+#include <utility>
+
+namespace prg {
+  MvcWeightTexture::~MvcWeightTexture() {
+    destroy();
+  }
+
+  void MvcWeightTexture::destroy() {
+    guard(m_texture);
+    glDeleteTextures(1, &m_texture);
+    m_texture  = 0;
+    m_size     = 0;
+    m_layers   = 0;
+    m_is_valid = false;
+  }
+
+  bool MvcWeightTexture::is_stale(std::span<const eig::Vector2f> verts,
+                                  eig::Array2u                   size,
+                                  const eig::Matrix4f           &projection,
+                                  DrawMethod                     method) const {
+    return !m_is_valid 
+        || (m_size != size).any()
+        || method != m_method
+        || projection != m_projection
+        || !std::ranges::equal(verts, m_verts);
+  }
+
+  void MvcWeightTexture::eval(std::span<const eig::Vector2f> verts,
+                              eig::Array2u                   size,
+                              const eig::Matrix4f           &projection,
+                              DrawMethod                     method) {
+    dbg::check_expr(supports(verts.size()), "MvcWeightTexture::eval(...) received an unsupported polygon size");
+    dbg::check_expr((size > 0).all(), "MvcWeightTexture::eval(...) requires a non-empty viewport");
+
+    // Immutable storage; reallocate if the viewport or layer count changed
+    uint layers = ceil_div(static_cast<uint>(verts.size()), 4u);
+    if ((size != m_size).any() || layers != m_layers) {
+      destroy();
+      glCreateTextures(GL_TEXTURE_2D_ARRAY, 1, &m_texture);
+      glTextureStorage3D(m_texture, 1, GL_RGBA32F, size.x(), size.y(), layers);
+      glTextureParameteri(m_texture, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+      glTextureParameteri(m_texture, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+      m_size   = size;
+      m_layers = layers;
+    }
+
+    // Dispatch over the viewport, and make writes visible to subsequent fetches
+    glBindImageTexture(0, m_texture, 0, GL_TRUE, 0, GL_WRITE_ONLY, GL_RGBA32F);
+    glDispatchCompute(ceil_div(size.x(), mvc_texture_group_size), ceil_div(size.y(), mvc_texture_group_size), 1);
+    glMemoryBarrier(GL_TEXTURE_FETCH_BARRIER_BIT);
+
+    m_verts.assign(range_iter(verts));
+    m_projection = projection;
+    m_method     = method;
+    m_is_valid   = true;
+    m_evals++;
+  }
+
+  void MvcWeightTexture::bind(uint unit) const {
+    glBindTextureUnit(unit, m_texture);
+  }
+
+  void MvcWeightTexture::swap(MvcWeightTexture &o) {
+    using std::swap;
+    swap(m_texture,    o.m_texture);
+    swap(m_size,       o.m_size);
+    swap(m_layers,     o.m_layers);
+    swap(m_evals,      o.m_evals);
+    swap(m_is_valid,   o.m_is_valid);
+    swap(m_verts,      o.m_verts);
+    swap(m_projection, o.m_projection);
+    swap(m_method,     o.m_method);
+  }
+} // namespace prg
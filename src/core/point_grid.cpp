@@ -0,0 +1,119 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <core/point_grid.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace prg {
+  namespace dtl {
+    // Upper bound on grid cells per point, which caps memory for sparse point sets
+    constexpr size_t point_grid_max_cells_per_point = 4;
+
+    // Upper bound on cell size doublings; with finite extents the cap is met well before
+    constexpr uint point_grid_max_doublings = 256;
+  } // namespace dtl
+
+  PointGrid::PointGrid(std::span<const eig::Vector2f> points, float cell_size) {
+    dbg::check_expr(cell_size > 0.f, "PointGrid(...) requires a positive cell size");
+    guard(!points.empty());
+
+    // Non-finite points, e.g. overflowing window-space projections, are skipped, as they
+    // cannot be picked and would break the bounds; so are points beyond a quarter of the
+    // float range, s.t. differences between points stay finite
+    auto is_finite = [](const eig::Vector2f &p) { 
+      return p.array().isFinite().all() && (p.array().abs() <= .25f * std::numeric_limits<float>::max()).all(); 
+    };
+    uint n_points = static_cast<uint>(std::ranges::count_if(points, is_finite));
+    guard(n_points > 0);
+
+    // Bounds of point set; extent is padded s.t. points on the max. bound fall inside
+    eig::AlignedBox2f bounds;
+    for (const auto &p : points)
+      if (is_finite(p))
+        bounds.extend(p);
+    eig::Array2f extent = bounds.sizes().array().max(1e-6f);
+    
+    // Grow cell size until the grid satisfies the cap on nr. of cells
+    size_t max_cells = std::max<size_t>(n_points * dtl::point_grid_max_cells_per_point, 1);
+    for (uint i = 0; i < dtl::point_grid_max_doublings; ++i) {
+      guard_break(((extent / cell_size).floor() + 1.f).prod() > static_cast<float>(max_cells));
+      cell_size *= 2.f;
+    }
+
+    m_origin    = bounds.min();
+    m_cell_size = cell_size;
+    m_dims      = ((extent / cell_size).floor() + 1.f).cast<int>();
+
+    // Counting sort of points into cells
+    auto cell_of = [&](const eig::Vector2f &p) {
+      eig::Array2i xy = ((p.array() - m_origin) / m_cell_size).cast<int>().min(m_dims - 1);
+      return static_cast<uint>(xy.y() * m_dims.x() + xy.x());
+    };
+    const uint n_cells = m_dims.prod();
+    std::vector<uint> cells(points.size());
+    m_offsets.assign(n_cells + 1, 0);
+    for (uint i = 0; i < points.size(); ++i) {
+      guard_continue(is_finite(points[i]));
+      cells[i] = cell_of(points[i]);
+      m_offsets[cells[i] + 1]++;
+    }
+    for (uint c = 0; c < n_cells; ++c)
+      m_offsets[c + 1] += m_offsets[c];
+
+    std::vector<uint> heads(m_offsets.begin(), m_offsets.end() - 1);
+    m_indices.resize(n_points);
+    m_points.resize(n_points);
+    for (uint i = 0; i < points.size(); ++i) {
+      guard_continue(is_finite(points[i]));
+      uint j = heads[cells[i]]++;
+      m_indices[j] = i;
+      m_points[j]  = points[i];
+    }
+  }
+
+  std::optional<uint> PointGrid::find_nearest(eig::Vector2f p, float radius) const {
+    guard(!empty(), {});
+
+    // Range of cells overlapping the query's bounding square
+    eig::Array2f min_f = ((p.array() - radius - m_origin) / m_cell_size).floor();
+    eig::Array2f max_f = ((p.array() + radius - m_origin) / m_cell_size).floor();
+    guard((max_f >= 0.f).all() && (min_f < m_dims.cast<float>()).all(), {});
+    eig::Array2i cell_min = min_f.max(0.f).cast<int>();
+    eig::Array2i cell_max = max_f.min((m_dims - 1).cast<float>()).cast<int>();
+
+    std::optional<uint> nearest;
+    float dist_nearest = std::numeric_limits<float>::max();
+    for (int y = cell_min.y(); y <= cell_max.y(); ++y) {
+      for (int x = cell_min.x(); x <= cell_max.x(); ++x) {
+        uint c = y * m_dims.x() + x;
+        for (uint j = m_offsets[c]; j < m_offsets[c + 1]; ++j) {
+          float dist = (m_points[j] - p).squaredNorm();
+          guard_continue(dist <= radius * radius);
+          guard_continue(!nearest || dist < dist_nearest || (dist == dist_nearest && m_indices[j] < *nearest));
+          dist_nearest = dist;
+          nearest      = m_indices[j];
+        }
+      }
+    }
+    return nearest;
+  }
+} // namespace prg
@@ -0,0 +1,221 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <core/polygon_collection.hpp>
+#include <core/mesh.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+namespace prg {
+  namespace dtl {
+    // Max. nr. of children per R-tree node
+    constexpr uint rtree_node_size = 16;
+
+    // Upper bound on the traversal stack; each level below the root adds at most
+    // rtree_node_size - 1 pending nodes, and 32-bit ids bound the tree to 8 levels
+    constexpr uint rtree_stack_size = 8 * rtree_node_size;
+
+    // Nr. of points per chunk in batched queries, which are distributed over threads
+    constexpr uint collection_query_chunk = 256;
+
+    // Sort-tile-recursive ordering of items by their boxes' centers; items are sorted along x,
+    // cut into sqrt(k / node_size) vertical slabs, and each slab is sorted along y, s.t.
+    // consecutive runs of node_size items form spatially compact nodes
+    template <typename T, typename F>
+    void str_sort(std::vector<T> &items, F center) {
+      size_t n_nodes = ceil_div(items.size(), static_cast<size_t>(rtree_node_size));
+      size_t n_slabs = static_cast<size_t>(std::ceil(std::sqrt(static_cast<double>(n_nodes))));
+      size_t n_slab  = n_slabs * rtree_node_size;
+
+      std::ranges::sort(items, { }, [&](const T &item) { return center(item).x(); });
+      for (size_t first = 0; first < items.size(); first += n_slab) {
+        auto last = items.begin() + std::min(first + n_slab, items.size());
+        std::sort(items.begin() + first, last, [&](const T &a, const T &b) {
+          return center(a).y() < center(b).y();
+        });
+      }
+    }
+  } // namespace dtl
+
+  uint PolygonCollection::add(std::span<const eig::Vector2f>  verts,
+                              std::span<const eig::AlArray3f> colrs,
+                              std::span<const uint>           hole_offsets) {
+    dbg::check_expr(verts.size() >= 3,            "PolygonCollection::add(...) requires at least three vertices");
+    dbg::check_expr(verts.size() == colrs.size(), "PolygonCollection::add(...) requires a color per vertex");
+    dbg::check_expr(std::ranges::is_sorted(hole_offsets) && (hole_offsets.empty() || hole_offsets.back() < verts.size()),
+      "PolygonCollection::add(...) requires ascending hole offsets inside the vertex range");
+
+    Entry entry = { .first       = static_cast<uint>(m_verts.size()),
+                    .size        = static_cast<uint>(verts.size()),
+                    .holes_first = static_cast<uint>(m_hole_offsets.size()),
+                    .holes_size  = static_cast<uint>(hole_offsets.size()) };
+    for (const auto &v : verts)
+      entry.bbox.extend(v);
+
+    m_verts.insert(m_verts.end(), range_iter(verts));
+    m_colrs.insert(m_colrs.end(), range_iter(colrs));
+    m_hole_offsets.insert(m_hole_offsets.end(), range_iter(hole_offsets));
+    m_entries.push_back(entry);
+    m_max_size = std::max(m_max_size, entry.size);
+    m_is_built = false;
+    return static_cast<uint>(m_entries.size()) - 1;
+  }
+
+  void PolygonCollection::build() {
+    m_nodes.clear();
+    m_order.resize(m_entries.size());
+    m_is_built = true;
+    guard(!m_entries.empty());
+
+    // Leaf level packs entries in STR order
+    for (uint i = 0; i < m_order.size(); ++i)
+      m_order[i] = i;
+    dtl::str_sort(m_order, [&](uint i) { return m_entries[i].bbox.center(); });
+
+    std::vector<Node> level;
+    for (uint first = 0; first < m_order.size(); first += dtl::rtree_node_size) {
+      Node node = { .first   = first,
+                    .size    = std::min<uint>(dtl::rtree_node_size, m_order.size() - first),
+                    .is_leaf = true };
+      for (uint j = node.first; j < node.first + node.size; ++j)
+        node.bbox.extend(m_entries[m_order[j]].bbox);
+      level.push_back(node);
+    }
+
+    // Pack each level into parents until a single root remains; a level is reordered
+    // before it is stored, as its parents reference contiguous runs of it
+    while (true) {
+      dtl::str_sort(level, [](const Node &node) { return node.bbox.center(); });
+      uint base = static_cast<uint>(m_nodes.size());
+      m_nodes.insert(m_nodes.end(), range_iter(level));
+      guard_break(level.size() > 1);
+
+      std::vector<Node> parents;
+      for (uint first = 0; first < level.size(); first += dtl::rtree_node_size) {
+        Node node = { .first   = base + first,
+                      .size    = std::min<uint>(dtl::rtree_node_size, level.size() - first),
+                      .is_leaf = false };
+        for (uint j = first; j < first + node.size; ++j)
+          node.bbox.extend(level[j].bbox);
+        parents.push_back(node);
+      }
+      level = std::move(parents);
+    }
+  }
+
+  uint PolygonCollection::find(eig::Vector2f p) const {
+    dbg::check_expr(m_is_built, "PolygonCollection::find(...) requires build() after adding polygons");
+    guard(!m_nodes.empty(), polygon_none);
+
+    // Even-odd rule over all rings of an entry
+    auto is_inside = [&](uint id) {
+      auto poly_verts = verts(id);
+      auto poly_holes = hole_offsets(id);
+      bool is_inside  = false;
+      for (uint r = 0; r <= poly_holes.size(); ++r) {
+        auto [first, last] = polygon_ring(poly_holes, poly_verts.size(), r);
+        is_inside ^= is_inside_polygon(poly_verts.subspan(first, last - first), p);
+      }
+      return is_inside;
+    };
+
+    // Depth-first traversal over nodes whose boxes hold p, keeping the lowest containing id
+    uint id_found = polygon_none;
+    std::array<uint, dtl::rtree_stack_size> stack;
+    uint stack_size = 0;
+    stack[stack_size++] = static_cast<uint>(m_nodes.size()) - 1;
+    while (stack_size > 0) {
+      const auto &node = m_nodes[stack[--stack_size]];
+      guard_continue(node.bbox.contains(p));
+      if (node.is_leaf) {
+        for (uint j = node.first; j < node.first + node.size; ++j) {
+          uint id = m_order[j];
+          guard_continue(id < id_found && m_entries[id].bbox.contains(p));
+          if (is_inside(id))
+            id_found = id;
+        }
+      } else {
+        for (uint j = node.first; j < node.first + node.size; ++j)
+          stack[stack_size++] = j;
+      }
+    }
+    return id_found;
+  }
+
+  void PolygonCollection::query(std::span<const eig::Vector2f> points,
+                                std::span<uint>                ids,
+                                std::span<eig::AlArray3f>      colrs,
+                                MvcPrecision                   precision) const {
+    dbg::check_expr(ids.size() >= points.size() && colrs.size() >= points.size(),
+      "PolygonCollection::query(...) requires an id and color per point");
+    dbg::check_expr(m_is_built, "PolygonCollection::query(...) requires build() after adding polygons");
+
+    int n_chunks = static_cast<int>(ceil_div(points.size(), static_cast<size_t>(dtl::collection_query_chunk)));
+    #pragma omp parallel
+    {
+      // Per-thread weight scratch space, sized for the largest polygon
+      std::vector<float> weights(m_max_size);
+
+      #pragma omp for schedule(dynamic)
+      for (int c = 0; c < n_chunks; ++c) {
+        size_t first = static_cast<size_t>(c) * dtl::collection_query_chunk;
+        size_t last  = std::min(first + dtl::collection_query_chunk, points.size());
+        for (size_t i = first; i < last; ++i) {
+          ids[i] = find(points[i]);
+          if (ids[i] == polygon_none) {
+            colrs[i] = 0.f;
+            continue;
+          }
+
+          // Interpolate the containing polygon's colors
+          auto poly_verts   = verts(ids[i]);
+          auto poly_colrs   = this->colrs(ids[i]);
+          auto poly_holes   = hole_offsets(ids[i]);
+          auto poly_weights = std::span(weights).first(poly_verts.size());
+          if (poly_holes.empty()) {
+            colrs[i] = eval_mvc_colr(poly_verts, poly_colrs, points[i], poly_weights, precision);
+          } else {
+            eval_mvc(poly_verts, poly_holes, points[i], poly_weights, precision);
+            eig::Array3f colr = 0.f;
+            for (uint j = 0; j < poly_verts.size(); ++j)
+              colr += poly_weights[j] * poly_colrs[j];
+            colrs[i] = colr;
+          }
+        }
+      }
+    }
+  }
+
+  std::span<const eig::Vector2f> PolygonCollection::verts(uint id) const {
+    const auto &entry = m_entries[id];
+    return std::span(m_verts).subspan(entry.first, entry.size);
+  }
+
+  std::span<const eig::AlArray3f> PolygonCollection::colrs(uint id) const {
+    const auto &entry = m_entries[id];
+    return std::span(m_colrs).subspan(entry.first, entry.size);
+  }
+
+  std::span<const uint> PolygonCollection::hole_offsets(uint id) const {
+    const auto &entry = m_entries[id];
+    return std::span(m_hole_offsets).subspan(entry.holes_first, entry.holes_size);
+  }
+} // namespace prg
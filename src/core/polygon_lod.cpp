@@ -0,0 +1,180 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <core/polygon_lod.hpp>
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <functional>
+#include <iterator>
+#include <queue>
+
+namespace prg {
+  namespace dtl {
+    // Area of the triangle formed by a vertex and its neighbours
+    inline
+    float corner_area(const eig::Vector2f &a, const eig::Vector2f &b, const eig::Vector2f &c) {
+      eig::Vector2f ab = b - a, ac = c - a;
+      return .5f * std::abs(ab.x() * ac.y() - ab.y() * ac.x());
+    }
+  } // namespace dtl
+
+  std::vector<PolygonLodLevel> build_polygon_lod(std::span<const eig::Vector2f> verts,
+                                                 PolygonLodInfo                 info) {
+    dbg::check_expr(info.ratio > 1.f, "build_polygon_lod(...) requires a ratio above 1");
+    uint n = static_cast<uint>(verts.size());
+    uint min_verts = std::max(info.min_verts, 3u);
+    guard(n > min_verts, {});
+
+    // Vertices form a doubly linked ring, from which removed vertices are unlinked
+    std::vector<uint> prev(n), next(n);
+    for (uint i = 0; i < n; ++i) {
+      prev[i] = (i + n - 1) % n;
+      next[i] = (i + 1) % n;
+    }
+
+    // Min-queue over (area, vertex); entries whose area no longer matches the vertex's
+    // current area are stale, and skipped on removal
+    using entry = std::pair<float, uint>;
+    std::vector<float> area(n);
+    std::vector<entry> entries(n);
+    for (uint i = 0; i < n; ++i) {
+      area[i]    = dtl::corner_area(verts[prev[i]], verts[i], verts[next[i]]);
+      entries[i] = { area[i], i };
+    }
+    std::priority_queue<entry, std::vector<entry>, std::greater<entry>> queue(std::greater<entry>(), std::move(entries));
+
+    // Remove vertices until three remain, recording removal order and effective areas
+    std::vector<uint>  order;     // Vertices in order of removal
+    std::vector<float> effective; // Monotone effective area, per removal
+    std::vector<uchar> is_removed(n, false);
+    order.reserve(n - 3);
+    effective.reserve(n - 3);
+    while (order.size() < n - 3) {
+      auto [a, i] = queue.top();
+      queue.pop();
+      guard_continue(!is_removed[i] && a == area[i]);
+
+      order.push_back(i);
+      effective.push_back(effective.empty() ? a : std::max(a, effective.back()));
+      is_removed[i] = true;
+
+      // Unlink vertex, and requeue neighbours with updated areas
+      uint p = prev[i], q = next[i];
+      next[p] = q;
+      prev[q] = p;
+      for (uint j : { p, q }) {
+        area[j] = dtl::corner_area(verts[prev[j]], verts[j], verts[next[j]]);
+        queue.push({ area[j], j });
+      }
+    }
+
+    // Rank vertices by removal, s.t. a level of m vertices retains those with rank >= n - m;
+    // the last three vertices are never removed
+    std::vector<uint> rank(n, n);
+    for (uint r = 0; r < order.size(); ++r)
+      rank[order[r]] = r;
+
+    // Extract levels at geometrically decreasing vertex counts
+    std::vector<PolygonLodLevel> levels;
+    for (float m_ = n / info.ratio; ; m_ /= info.ratio) {
+      uint m = std::max(static_cast<uint>(m_), min_verts);
+
+      PolygonLodLevel level = { .error = effective[n - m - 1] };
+      level.indices.reserve(m);
+      for (uint i = 0; i < n; ++i)
+        if (rank[i] >= n - m)
+          level.indices.push_back(i);
+      levels.push_back(std::move(level));
+
+      guard_break(m > min_verts);
+    }
+    return levels;
+  }
+
+  const PolygonLodLevel &select_lod_level(std::span<const PolygonLodLevel> levels, uint max_verts) {
+    dbg::check_expr(!levels.empty(), "select_lod_level(...) requires a nonempty LOD chain");
+    auto it = std::ranges::find_if(levels, [&](const auto &level) { return level.indices.size() <= max_verts; });
+    return it != levels.end() ? *it : levels.back();
+  }
+
+  void extract_lod_level(const PolygonLodLevel          &level,
+                         std::span<const eig::Vector2f>  verts,
+                         std::span<const eig::AlArray3f> colrs,
+                         std::vector<eig::Vector2f>     &verts_out,
+                         std::vector<eig::AlArray3f>    &colrs_out,
+                         std::optional<uint>             pinned) {
+    dbg::check_expr(verts.size() == colrs.size(), "extract_lod_level(...) requires matching vertex and color counts");
+    uint n = static_cast<uint>(verts.size());
+
+    // Insert pinned vertex into a copy of the level's indices, if it was removed
+    std::span<const uint> indices = level.indices;
+    std::vector<uint>     indices_pinned;
+    if (pinned && !std::ranges::binary_search(indices, *pinned)) {
+      indices_pinned.reserve(indices.size() + 1);
+      std::ranges::merge(indices, std::array { *pinned }, std::back_inserter(indices_pinned));
+      indices = indices_pinned;
+    }
+    uint m = static_cast<uint>(indices.size());
+    dbg::check_expr(m == 0 || indices.back() < n, "extract_lod_level(...) level does not match polygon");
+
+    verts_out.resize(m);
+    colrs_out.resize(m);
+    for (uint j = 0; j < m; ++j)
+      verts_out[j] = verts[indices[j]];
+
+    // Each original vertex is weighted by half of its adjacent edges' lengths, and split over
+    // the retained vertices bounding its span by relative arc length
+    auto edge_length = [&](uint i) { return (verts[(i + 1) % n] - verts[i]).norm(); };
+    std::vector<float> weights(m, 0.f);
+    std::ranges::fill(colrs_out, eig::AlArray3f(0.f));
+    for (uint j = 0; j < m; ++j) {
+      uint a = indices[j], b = indices[(j + 1) % m];
+      uint count = (b + n - a) % n;
+      count = count == 0 ? n : count;
+
+      // Arc length of span, and dual length of its first vertex
+      float length = 0.f;
+      for (uint k = 0; k < count; ++k)
+        length += edge_length((a + k) % n);
+      float dual = .5f * (edge_length((a + n - 1) % n) + edge_length(a));
+      colrs_out[j] += dual * colrs[a];
+      weights[j]   += dual;
+
+      // Removed vertices within the span
+      float s = 0.f;
+      for (uint k = 1; k < count; ++k) {
+        uint  i = (a + k) % n;
+        float l = edge_length((i + n - 1) % n);
+        s += l;
+        float t = length > 0.f ? s / length : 0.f;
+        dual = .5f * (l + edge_length(i));
+        colrs_out[j]           += (1.f - t) * dual * colrs[i];
+        colrs_out[(j + 1) % m] += t * dual * colrs[i];
+        weights[j]             += (1.f - t) * dual;
+        weights[(j + 1) % m]   += t * dual;
+      }
+    }
+
+    // Normalize; degenerate spans of zero length keep the original color
+    for (uint j = 0; j < m; ++j)
+      colrs_out[j] = weights[j] > 0.f ? (colrs_out[j] / weights[j]).eval() : colrs[indices[j]];
+  }
+} // namespace prg
@@ -0,0 +1,267 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <core/program_cache.hpp>
+#include <glad/glad.h>
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string_view>
+#include <utility>
+
+namespace prg {
+  namespace dtl {
+    // Header of the program cache file format; the header is followed by n_entries entries,
+    // each directly followed by its binary
+    struct ProgramCacheHeader {
+      std::array<char, 8> magic = { 'P', 'R', 'G', 'P', 'R', 'O', 'G', '1' };
+      uint64_t            driver_hash;
+      uint                n_entries;
+      uint                padding = 0;
+    };
+
+    struct ProgramCacheEntry {
+      uint64_t key;
+      uint     format;
+      uint     size;
+    };
+
+    static_assert(sizeof(ProgramCacheHeader) == 24);
+    static_assert(sizeof(ProgramCacheEntry)  == 16);
+
+    inline
+    std::string read_glsl(const std::filesystem::path &path) {
+      std::ifstream in(path);
+      if (!in.is_open())
+        dtl::throw_keyed_error("ProgramCache::build(...) failed", "could not open shader", {{ "path", path.string() }});
+      std::stringstream ss;
+      ss << in.rdbuf();
+      return ss.str();
+    }
+
+    inline
+    std::string shader_log(GLuint shader) {
+      GLint size = 0;
+      glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &size);
+      std::string log(std::max(size, 1), '\0');
+      glGetShaderInfoLog(shader, size, nullptr, log.data());
+      return log.c_str();
+    }
+
+    inline
+    std::string program_log(GLuint program) {
+      GLint size = 0;
+      glGetProgramiv(program, GL_INFO_LOG_LENGTH, &size);
+      std::string log(std::max(size, 1), '\0');
+      glGetProgramInfoLog(program, size, nullptr, log.data());
+      return log.c_str();
+    }
+
+    // Whether the current context exposes an extension
+    inline
+    bool has_gl_extension(std::string_view name) {
+      GLint n = 0;
+      glGetIntegerv(GL_NUM_EXTENSIONS, &n);
+      for (GLint i = 0; i < n; ++i)
+        if (name == reinterpret_cast<const char *>(glGetStringi(GL_EXTENSIONS, i)))
+          return true;
+      return false;
+    }
+  } // namespace dtl
+
+  ProgramCache::ProgramCache(ProgramCacheInfo info)
+  : m_path(std::move(info.path)) {
+    // Driver string covers vendor, renderer and version, which e.g. Mesa bumps per release
+    for (GLenum name : { GL_VENDOR, GL_RENDERER, GL_VERSION, GL_SHADING_LANGUAGE_VERSION }) {
+      auto str = reinterpret_cast<const char *>(glGetString(name));
+      m_driver += fmt::format("{}{}", m_driver.empty() ? "" : " / ", str ? str : "");
+    }
+
+#ifdef GL_KHR_parallel_shader_compile
+    // Leave the nr. of compiler threads to the driver
+    if (info.parallel && dtl::has_gl_extension("GL_KHR_parallel_shader_compile")) {
+      glMaxShaderCompilerThreadsKHR(0xFFFFFFFFu);
+      m_parallel = true;
+    }
+#endif
+
+    // Read back entries of a previous run; files of another driver or format are ignored,
+    // as are files that turn out truncated or hold entries larger than the remaining data
+    guard(!m_path.empty() && std::filesystem::exists(m_path));
+    std::ifstream in(m_path, std::ios::binary);
+    guard(in.is_open());
+    uint64_t file_size = std::filesystem::file_size(m_path);
+
+    dtl::ProgramCacheHeader header;
+    in.read(reinterpret_cast<char *>(&header), sizeof(header));
+    guard(in.good() && header.magic == dtl::ProgramCacheHeader().magic);
+    guard(header.driver_hash == hash_bytes(std::as_bytes(std::span(m_driver))));
+
+    for (uint i = 0; i < header.n_entries; ++i) {
+      dtl::ProgramCacheEntry entry;
+      in.read(reinterpret_cast<char *>(&entry), sizeof(entry));
+      guard_break(in.good());
+      guard_break(entry.size <= file_size - static_cast<uint64_t>(in.tellg()));
+      std::vector<std::byte> binary(entry.size);
+      in.read(reinterpret_cast<char *>(binary.data()), binary.size());
+      guard_break(in.good());
+      m_entries.emplace(entry.key, Entry { entry.format, std::move(binary) });
+    }
+  }
+
+  ProgramCache::~ProgramCache() {
+    for (uint program : m_programs)
+      glDeleteProgram(program);
+  }
+
+  std::vector<uint> ProgramCache::build(std::span<const std::vector<ProgramStage>> programs) {
+    auto time_start = std::chrono::steady_clock::now();
+    m_stats = { .is_parallel = m_parallel };
+
+    // Programs missing from the cache, alongside their shaders
+    struct Pending {
+      uint              index;
+      uint64_t          key;
+      std::vector<uint> shaders;
+    };
+    std::vector<Pending> pending;
+
+    std::vector<uint> objects(programs.size());
+    for (uint i = 0; i < programs.size(); ++i) {
+      std::vector<std::string> sources;
+      uint64_t key = hash_bytes(std::as_bytes(std::span(m_driver)));
+      for (const auto &stage : programs[i]) {
+        sources.push_back(dtl::read_glsl(stage.path));
+        key = hash_bytes(obj_span<const std::byte>(stage.type), key);
+        key = hash_bytes(std::as_bytes(std::span(sources.back())), key);
+      }
+
+      GLuint program = glCreateProgram();
+      objects[i] = program;
+      m_programs.push_back(program);
+
+      // Load a cached binary; drivers may still reject it, e.g. after a silent update, in
+      // which case the entry is dropped and the program compiled as a miss
+      if (auto it = m_entries.find(key); it != m_entries.end()) {
+        glProgramBinary(program, it->second.format, it->second.binary.data(),
+                        static_cast<GLsizei>(it->second.binary.size()));
+        GLint is_linked = 0;
+        glGetProgramiv(program, GL_LINK_STATUS, &is_linked);
+        if (is_linked) {
+          m_stats.hits++;
+          continue;
+        }
+        m_entries.erase(it);
+        m_is_dirty = true;
+      }
+
+      // Issue compiles without querying status, s.t. the driver may run them concurrently
+      Pending p = { .index = i, .key = key };
+      for (uint j = 0; j < programs[i].size(); ++j) {
+        const char *glsl = sources[j].c_str();
+        GLuint shader = glCreateShader(programs[i][j].type);
+        glShaderSource(shader, 1, &glsl, nullptr);
+        glCompileShader(shader);
+        glAttachShader(program, shader);
+        p.shaders.push_back(shader);
+      }
+      glProgramParameteri(program, GL_PROGRAM_BINARY_RETRIEVABLE_HINT, GL_TRUE);
+      pending.push_back(std::move(p));
+      m_stats.misses++;
+    }
+
+    // Issue all links, then wait on each program in turn, and store its binary
+    for (const auto &p : pending)
+      glLinkProgram(objects[p.index]);
+    for (const auto &p : pending) {
+      GLuint program = objects[p.index];
+      GLint is_linked = 0;
+      glGetProgramiv(program, GL_LINK_STATUS, &is_linked);
+      if (!is_linked) {
+        // Report the first stage that failed to compile, or the link log otherwise
+        const auto &stages = programs[p.index];
+        for (uint j = 0; j < p.shaders.size(); ++j) {
+          GLint is_compiled = 0;
+          glGetShaderiv(p.shaders[j], GL_COMPILE_STATUS, &is_compiled);
+          if (!is_compiled)
+            dtl::throw_keyed_error("ProgramCache::build(...) failed", "could not compile shader",
+                                   {{ "path", stages[j].path.string() }, { "log", dtl::shader_log(p.shaders[j]) }});
+        }
+        dtl::throw_keyed_error("ProgramCache::build(...) failed", "could not link program",
+                               {{ "path", stages.front().path.string() }, { "log", dtl::program_log(program) }});
+      }
+
+      for (uint shader : p.shaders) {
+        glDetachShader(program, shader);
+        glDeleteShader(shader);
+      }
+
+      GLint size = 0;
+      glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &size);
+      guard_continue(size > 0);
+      Entry entry = { .binary = std::vector<std::byte>(size) };
+      glGetProgramBinary(program, size, nullptr, &entry.format, entry.binary.data());
+      m_entries.insert_or_assign(p.key, std::move(entry));
+      m_is_dirty = true;
+    }
+
+    m_stats.time_ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - time_start).count();
+    return objects;
+  }
+
+  bool ProgramCache::save() {
+    guard(m_is_dirty && !m_path.empty(), true);
+
+    // Write to a temporary file first, s.t. an interrupted write leaves no truncated cache
+    auto path_tmp = std::filesystem::path(m_path).concat(".tmp");
+    {
+      std::ofstream out(path_tmp, std::ios::binary | std::ios::trunc);
+      dtl::ProgramCacheHeader header = { .driver_hash = hash_bytes(std::as_bytes(std::span(m_driver))),
+                                         .n_entries   = static_cast<uint>(m_entries.size()) };
+      out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+      for (const auto &[key, entry] : m_entries) {
+        dtl::ProgramCacheEntry entry_ = { key, entry.format, static_cast<uint>(entry.binary.size()) };
+        out.write(reinterpret_cast<const char *>(&entry_), sizeof(entry_));
+        out.write(reinterpret_cast<const char *>(entry.binary.data()), entry.binary.size());
+      }
+      guard(out.good(), false);
+    }
+
+    std::error_code ec;
+    std::filesystem::rename(path_tmp, m_path, ec);
+    guard(!ec, false);
+    m_is_dirty = false;
+    return true;
+  }
+
+  void ProgramCache::swap(ProgramCache &o) {
+    using std::swap;
+    swap(m_path,     o.m_path);
+    swap(m_parallel, o.m_parallel);
+    swap(m_driver,   o.m_driver);
+    swap(m_entries,  o.m_entries);
+    swap(m_programs, o.m_programs);
+    swap(m_stats,    o.m_stats);
+    swap(m_is_dirty, o.m_is_dirty);
+  }
+} // namespace prg
@@ -0,0 +1,273 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <core/tiled_render.hpp>
+#include <core/mesh.hpp>
+#include <core/mvc.hpp>
+#include <zlib.h>
+#include <algorithm>
+#include <fstream>
+#include <limits>
+
+namespace prg {
+  namespace dtl {
+    static_assert(sizeof(TiledImageHeader) == 32);
+    static_assert(sizeof(TiledImageEntry)  == 16);
+
+    // Hash over all settings that affect rendered pixels, s.t. resumes only
+    // continue files that were produced with identical inputs
+    inline
+    uint64_t hash_render_info(const TiledRenderInfo &info) {
+      std::array<float, 4> bounds = { info.bounds.min().x(), info.bounds.min().y(), 
+                                      info.bounds.max().x(), info.bounds.max().y() };
+      uint64_t hash = hash_bytes(obj_span<const std::byte>(bounds));
+      hash = hash_bytes(std::as_bytes(info.verts), hash);
+
+      // Colors are hashed per component, as AlArray3f's padding bytes are indeterminate
+      for (const auto &colr : info.colrs) {
+        std::array<float, 3> rgb = { colr.x(), colr.y(), colr.z() };
+        hash = hash_bytes(obj_span<const std::byte>(rgb), hash);
+      }
+      return hash;
+    }
+
+    // Attempt to read back header and tile table of an interrupted render; returns false
+    // if the file does not exist or was produced with different settings
+    inline
+    bool read_tiled_table(const std::filesystem::path &path, 
+                          const TiledImageHeader      &header,
+                          std::span<TiledImageEntry>   table) {
+      guard(std::filesystem::exists(path), false);
+      std::ifstream in(path, std::ios::binary);
+      guard(in.is_open(), false);
+      
+      // Test header match
+      TiledImageHeader header_;
+      in.read(reinterpret_cast<char *>(&header_), sizeof(header_));
+      guard(in.good(), false);
+      guard(header_.magic  == header.magic  && header_.hash   == header.hash   &&
+            header_.size_x == header.size_x && header_.size_y == header.size_y &&
+            header_.tile_x == header.tile_x && header_.tile_y == header.tile_y, false);
+      
+      // Read tile table
+      in.read(reinterpret_cast<char *>(table.data()), table.size_bytes());
+      guard(in.good(), false);
+
+      // Discard entries pointing past the end of the file, e.g. data truncated by
+      // a copy of an incomplete file, as well as entries whose data does not match
+      // its crc; writes are not synced, so a crash can persist an entry before its data
+      uint64_t file_size = std::filesystem::file_size(path);
+      std::vector<uchar> comp;
+      for (auto &entry : table) {
+        guard_continue(entry.size > 0);
+        if (entry.offset + entry.size <= file_size) {
+          comp.resize(entry.size);
+          in.seekg(entry.offset);
+          in.read(reinterpret_cast<char *>(comp.data()), comp.size());
+          if (in.good() && crc32(0, comp.data(), entry.size) == entry.crc)
+            continue;
+          in.clear();
+        }
+        entry = { 0, 0, 0 };
+      }
+      return true;
+    }
+
+    // Upper bound on zlib's compressed size, following compressBound(...), but evaluated
+    // in 64 bits s.t. oversized tiles can be rejected before the bound wraps
+    constexpr
+    uint64_t compress_bound_64(uint64_t size) {
+      return size + (size >> 12) + (size >> 14) + (size >> 25) + 13;
+    }
+  } // namespace dtl
+
+  TiledRenderResult render_mvc_tiled(const TiledRenderInfo &info) {
+    dbg::check_expr(info.verts.size() >= 3,                 "render_mvc_tiled(...) requires at least three vertices");
+    dbg::check_expr(info.verts.size() == info.colrs.size(), "render_mvc_tiled(...) requires a color per vertex");
+    dbg::check_expr((info.size > 0).all() && (info.tile_size > 0).all(), 
+      "render_mvc_tiled(...) requires non-zero image and tile sizes");
+
+    // Establish tile layout; tile sizes and counts are bounded s.t. sizes fit in the 
+    // file format's 32-bit fields, as well as in zlib's uLong (32-bit on Windows)
+    eig::Array2u n_tiles   = { ceil_div(info.size.x(), info.tile_size.x()), 
+                               ceil_div(info.size.y(), info.tile_size.y()) };
+    uint64_t     n_total_  = static_cast<uint64_t>(n_tiles.x()) * n_tiles.y();
+    if (n_total_ > std::numeric_limits<uint>::max())
+      dtl::throw_keyed_error("render_mvc_tiled(...) failed", "image holds too many tiles; increase tile size",
+                             {{ "path", info.path.string() }});
+    uint         n_total   = static_cast<uint>(n_total_);
+    size_t       table_offs = sizeof(TiledImageHeader);
+    
+    size_t   tile_bytes_raw = static_cast<size_t>(info.tile_size.x()) * info.tile_size.y() * 4;
+    uint64_t tile_bytes_max = std::min<uint64_t>(std::numeric_limits<uLong>::max(), 
+                                                 std::numeric_limits<uint>::max());
+    if (dtl::compress_bound_64(tile_bytes_raw) > tile_bytes_max)
+      dtl::throw_keyed_error("render_mvc_tiled(...) failed", "tile size is too large to compress; decrease tile size",
+                             {{ "path", info.path.string() }});
+    
+    // Establish file header, and open or resume the tile table
+    TiledImageHeader header = { .size_x = info.size.x(),      .size_y = info.size.y(),
+                                .tile_x = info.tile_size.x(), .tile_y = info.tile_size.y(),
+                                .hash   = dtl::hash_render_info(info) };
+    std::vector<TiledImageEntry> table(n_total, TiledImageEntry { 0, 0, 0 });
+    if (!info.resume || !dtl::read_tiled_table(info.path, header, table)) {
+      std::ofstream out(info.path, std::ios::binary | std::ios::trunc);
+      out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+      out.write(reinterpret_cast<const char *>(table.data()), table.size() * sizeof(TiledImageEntry));
+      if (!out.good())
+        dtl::throw_keyed_error("render_mvc_tiled(...) failed", "could not create output file", {{ "path", info.path.string() }});
+    }
+    
+    // Reopen for appending tile data; interrupted writes may have left orphaned 
+    // data at the end of the file, which is harmless as the table never refers to it
+    std::fstream file(info.path, std::ios::binary | std::ios::in | std::ios::out);
+    if (!file.is_open())
+      dtl::throw_keyed_error("render_mvc_tiled(...) failed", "could not open output file", {{ "path", info.path.string() }});
+    file.seekp(0, std::ios::end);
+    uint64_t data_offs = static_cast<uint64_t>(file.tellp());
+
+    // Gather remaining tiles
+    std::vector<uint> tiles;
+    tiles.reserve(n_total);
+    for (uint i = 0; i < n_total; ++i)
+      if (table[i].size == 0)
+        tiles.push_back(i);
+
+    // Bound the nr. of tiles in flight by the memory budget; each tile holds
+    // uncompressed rgba8 data as well as its worst-case compressed form
+    size_t tile_bytes_comp = compressBound(static_cast<uLong>(tile_bytes_raw));
+    size_t n_batch         = std::clamp<size_t>(info.mem_budget / (tile_bytes_raw + tile_bytes_comp), 
+                                                1, std::max<size_t>(tiles.size(), 1));
+    std::vector<std::vector<uchar>> batch_raw(n_batch, std::vector<uchar>(tile_bytes_raw));
+    std::vector<std::vector<uchar>> batch_comp(n_batch, std::vector<uchar>(tile_bytes_comp));
+    std::vector<uLong>              batch_size(n_batch);
+
+    // Pixel footprint in polygon space
+    eig::Array2f px_size = info.bounds.sizes().array() / info.size.cast<float>();
+
+    for (size_t batch_first = 0; batch_first < tiles.size(); batch_first += n_batch) {
+      int  batch_n   = static_cast<int>(std::min(n_batch, tiles.size() - batch_first));
+      bool batch_err = false;
+      
+      // Render and compress tiles in parallel
+      #pragma omp parallel
+      {
+        std::vector<float> weights(info.verts.size());
+
+        #pragma omp for schedule(dynamic)
+        for (int b = 0; b < batch_n; ++b) {
+          uint         tile = tiles[batch_first + b];
+          eig::Array2u orig = eig::Array2u(tile % n_tiles.x(), tile / n_tiles.x()) * info.tile_size;
+          eig::Array2u size = info.tile_size.min(info.size - orig);
+          
+          // Evaluate pixel centers; rows run top-to-bottom
+          auto &raw = batch_raw[b];
+          for (uint y = 0; y < size.y(); ++y) {
+            for (uint x = 0; x < size.x(); ++x) {
+              eig::Vector2f p = { info.bounds.min().x() + (orig.x() + x + .5f) * px_size.x(),
+                                  info.bounds.max().y() - (orig.y() + y + .5f) * px_size.y() };
+              
+              uchar *px = &raw[(static_cast<size_t>(y) * size.x() + x) * 4];
+              if (!is_inside_polygon(info.verts, p)) {
+                std::fill(px, px + 4, 0);
+                continue;
+              }
+
+              eig::Array3f colr = eval_mvc_colr(info.verts, info.colrs, p, weights);
+              for (uint c = 0; c < 3; ++c)
+                px[c] = static_cast<uchar>(std::clamp(colr[c], 0.f, 1.f) * 255.f + .5f);
+              px[3] = 255;
+            }
+          }
+
+          // Compress tile
+          batch_size[b] = static_cast<uLong>(batch_comp[b].size());
+          if (compress2(batch_comp[b].data(), &batch_size[b], raw.data(), 
+                        static_cast<uLong>(static_cast<size_t>(size.x()) * size.y() * 4), info.compression) != Z_OK) {
+            #pragma omp atomic write
+            batch_err = true;
+          }
+        }
+      }
+      if (batch_err)
+        dtl::throw_keyed_error("render_mvc_tiled(...) failed", "tile compression failed", {{ "path", info.path.string() }});
+
+      // Stream finished tiles to disk; data is written and flushed before its table entry, 
+      // s.t. an interruption never leaves an entry pointing to incomplete data
+      for (int b = 0; b < batch_n; ++b) {
+        uint tile = tiles[batch_first + b];
+        uint size = static_cast<uint>(batch_size[b]);
+        uint crc  = static_cast<uint>(crc32(0, batch_comp[b].data(), size));
+        TiledImageEntry entry = { .offset = data_offs, .size = size, .crc = crc };
+        file.seekp(data_offs);
+        file.write(reinterpret_cast<const char *>(batch_comp[b].data()), entry.size);
+        file.flush();
+        file.seekp(table_offs + tile * sizeof(TiledImageEntry));
+        file.write(reinterpret_cast<const char *>(&entry), sizeof(entry));
+        data_offs += entry.size;
+      }
+      file.flush();
+      if (!file.good())
+        dtl::throw_keyed_error("render_mvc_tiled(...) failed", "could not write tile data", {{ "path", info.path.string() }});
+    }
+
+    return { .tiles_total    = n_total,
+             .tiles_rendered = static_cast<uint>(tiles.size()),
+             .tiles_skipped  = n_total - static_cast<uint>(tiles.size()) };
+  }
+
+  std::vector<eig::Array4<uchar>> read_mvc_tile(const std::filesystem::path &path, eig::Array2u tile) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in.is_open())
+      dtl::throw_keyed_error("render_mvc_tiled(...) failed", "could not open input file", {{ "path", path.string() }});
+    
+    // Read header, and the tile's table entry
+    TiledImageHeader header;
+    in.read(reinterpret_cast<char *>(&header), sizeof(header));
+    if (!in.good() || header.magic != TiledImageHeader().magic)
+      dtl::throw_keyed_error("render_mvc_tiled(...) failed", "not a tiled render file", {{ "path", path.string() }});
+    eig::Array2u size    = { header.size_x, header.size_y },
+                 tile_res = { header.tile_x, header.tile_y },
+                 n_tiles = { ceil_div(size.x(), tile_res.x()), ceil_div(size.y(), tile_res.y()) };
+    guard((tile < n_tiles).all(), {});
+    
+    TiledImageEntry entry;
+    in.seekg(sizeof(header) + (static_cast<size_t>(tile.y()) * n_tiles.x() + tile.x()) * sizeof(TiledImageEntry));
+    in.read(reinterpret_cast<char *>(&entry), sizeof(entry));
+    guard(in.good() && entry.size > 0, {});
+
+    // Read and validate compressed data
+    std::vector<uchar> comp(entry.size);
+    in.seekg(entry.offset);
+    in.read(reinterpret_cast<char *>(comp.data()), comp.size());
+    if (!in.good() || crc32(0, comp.data(), entry.size) != entry.crc)
+      dtl::throw_keyed_error("render_mvc_tiled(...) failed", "tile data is corrupt", {{ "path", path.string() }});
+
+    // Decompress cropped tile
+    eig::Array2u tile_size = tile_res.min(size - tile * tile_res);
+    std::vector<eig::Array4<uchar>> data(static_cast<size_t>(tile_size.x()) * tile_size.y());
+    uLong data_size = static_cast<uLong>(data.size() * 4);
+    if (uncompress(reinterpret_cast<Bytef *>(data.data()), &data_size, comp.data(), entry.size) != Z_OK
+     || data_size != data.size() * 4)
+      dtl::throw_keyed_error("render_mvc_tiled(...) failed", "tile decompression failed", {{ "path", path.string() }});
+
+    return data;
+  }
+} // namespace prg
@@ -0,0 +1,406 @@
+// Copyright (c) 2025 Mark van de Ruit, Delft University of Technology
+
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include <core/weight_field.hpp>
+#include <core/mesh.hpp>
+#include <core/mvc.hpp>
+#include <zlib.h>
+#include <algorithm>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <numeric>
+#include <omp.h>
+#ifdef _WIN32
+  #define WIN32_LEAN_AND_MEAN
+  #define NOMINMAX
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif
+
+namespace prg {
+  namespace dtl {
+    static_assert(sizeof(WeightFieldHeader) == 48);
+    static_assert(sizeof(WeightFieldEntry)  == 24);
+
+    // Min. magnitude of the sum of retained weights for renormalization
+    constexpr float field_min_sum = .5f;
+
+    // Quantized, top-k sparse weights of a single chunk, prior to compression
+    struct ChunkData {
+      std::vector<uchar>  counts;
+      std::vector<uint>   indices;
+      std::vector<ushort> weights;
+      float               w_min, w_scale;
+      std::vector<uchar>  packed;
+    };
+
+    MappedFile::MappedFile(const std::filesystem::path &path) {
+#ifdef _WIN32
+      HANDLE file = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, 
+                                OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+      if (file == INVALID_HANDLE_VALUE)
+        dtl::throw_keyed_error("weight field io failed", "could not open file", {{ "path", path.string() }});
+      LARGE_INTEGER size;
+      if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        dtl::throw_keyed_error("weight field io failed", "could not query file size", {{ "path", path.string() }});
+      }
+      HANDLE mapping = CreateFileMappingW(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+      CloseHandle(file);
+      if (!mapping)
+        dtl::throw_keyed_error("weight field io failed", "could not map file", {{ "path", path.string() }});
+      void *data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+      if (!data) {
+        CloseHandle(mapping);
+        dtl::throw_keyed_error("weight field io failed", "could not map file", {{ "path", path.string() }});
+      }
+      m_handle = mapping;
+      m_data   = { static_cast<const std::byte *>(data), static_cast<size_t>(size.QuadPart) };
+#else
+      int fd = open(path.c_str(), O_RDONLY);
+      if (fd < 0)
+        dtl::throw_keyed_error("weight field io failed", "could not open file", {{ "path", path.string() }});
+      struct stat st;
+      if (fstat(fd, &st) != 0) {
+        close(fd);
+        dtl::throw_keyed_error("weight field io failed", "could not query file size", {{ "path", path.string() }});
+      }
+      void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+      close(fd);
+      if (data == MAP_FAILED)
+        dtl::throw_keyed_error("weight field io failed", "could not map file", {{ "path", path.string() }});
+      m_handle = data;
+      m_data   = { static_cast<const std::byte *>(data), static_cast<size_t>(st.st_size) };
+#endif
+    }
+
+    MappedFile::~MappedFile() {
+      guard(m_handle);
+#ifdef _WIN32
+      UnmapViewOfFile(m_data.data());
+      CloseHandle(static_cast<HANDLE>(m_handle));
+#else
+      munmap(m_handle, m_data.size());
+#endif
+    }
+  } // namespace dtl
+
+  void export_weight_field(const WeightFieldInfo &info) {
+    dbg::check_expr(info.verts.size() >= 3, "export_weight_field(...) requires at least three vertices");
+    dbg::check_expr(info.k > 0 && info.k <= 255, "export_weight_field(...) requires k in [1, 255]");
+    dbg::check_expr((info.size > 0).all() && (info.chunk_size > 0).all(), 
+      "export_weight_field(...) requires non-zero field and chunk sizes");
+    
+    const uint   n        = info.verts.size();
+    const uint   k        = std::min(info.k, n);
+    eig::Array2u n_chunks = { ceil_div(info.size.x(), info.chunk_size.x()), 
+                              ceil_div(info.size.y(), info.chunk_size.y()) };
+    eig::Array2f px_size  = info.bounds.sizes().array() / info.size.cast<float>();
+
+    // Write header and placeholder table
+    WeightFieldHeader header = { .n_verts = n,                     .k       = k,
+                                 .size_x  = info.size.x(),         .size_y  = info.size.y(),
+                                 .chunk_x = info.chunk_size.x(),   .chunk_y = info.chunk_size.y(),
+                                 .bounds  = { info.bounds.min().x(), info.bounds.min().y(),
+                                              info.bounds.max().x(), info.bounds.max().y() } };
+    std::vector<WeightFieldEntry> table(n_chunks.prod());
+    std::ofstream out(info.path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char *>(table.data()), table.size() * sizeof(WeightFieldEntry));
+    if (!out.good())
+      dtl::throw_keyed_error("weight field io failed", "could not create output file", {{ "path", info.path.string() }});
+    uint64_t data_offs = static_cast<uint64_t>(out.tellp());
+    
+    // Chunks are produced in parallel batches, and written sequentially in between
+    std::vector<dtl::ChunkData> batch(4 * std::max(1, omp_get_max_threads()));
+    for (uint batch_first = 0; batch_first < table.size(); batch_first += batch.size()) {
+      int batch_n = static_cast<int>(std::min<size_t>(batch.size(), table.size() - batch_first));
+      int n_failed = 0; // Failures are counted, as exceptions cannot leave the parallel region
+      
+      #pragma omp parallel
+      {
+        std::vector<float> weights(n);
+        std::vector<uint>  order(n);
+
+        #pragma omp for schedule(dynamic) reduction(+ : n_failed)
+        for (int b = 0; b < batch_n; ++b) {
+          uint         chunk = batch_first + b;
+          eig::Array2u orig  = eig::Array2u(chunk % n_chunks.x(), chunk / n_chunks.x()) * info.chunk_size;
+          eig::Array2u size  = info.chunk_size.min(info.size - orig);
+          
+          auto &data = batch[b];
+          data.counts.clear();
+          data.indices.clear();
+          data.weights.clear();
+          std::vector<float> weights_k;
+          weights_k.reserve(size.prod() * k);
+
+          for (uint y = 0; y < size.y(); ++y) {
+            for (uint x = 0; x < size.x(); ++x) {
+              eig::Vector2f p = { info.bounds.min().x() + (orig.x() + x + .5f) * px_size.x(),
+                                  info.bounds.max().y() - (orig.y() + y + .5f) * px_size.y() };
+              
+              // Samples outside the polygon store no weights; their large, mixed-sign weights
+              // would otherwise widen the chunk's quantization range
+              if (!is_inside_polygon(info.verts, p)) {
+                data.counts.push_back(0);
+                continue;
+              }
+              eval_mvc(info.verts, p, weights);
+
+              // Select top-k weights by magnitude, and renormalize these
+              std::iota(range_iter(order), 0u);
+              std::partial_sort(order.begin(), order.begin() + k, order.end(), [&](uint i, uint j) {
+                return std::abs(weights[i]) > std::abs(weights[j]); });
+              float sum = 0.f;
+              for (uint i = 0; i < k; ++i)
+                sum += weights[order[i]];
+
+              // Retained weights that cancel out, e.g. in concave regions with mixed-sign
+              // weights, cannot be renormalized; the sample then keeps them as normalized
+              if (!(std::abs(sum) >= dtl::field_min_sum))
+                sum = 1.f;
+              
+              uchar count = 0;
+              for (uint i = 0; i < k; ++i) {
+                guard_continue(weights[order[i]] != 0.f);
+                data.indices.push_back(order[i]);
+                weights_k.push_back(weights[order[i]] / sum);
+                count++;
+              }
+              data.counts.push_back(count);
+            }
+          }
+
+          // Quantize weights to 16 bits over the chunk's weight range
+          auto [w_min, w_max] = weights_k.empty() 
+                              ? std::pair { 0.f, 0.f } 
+                              : std::pair { *std::ranges::min_element(weights_k), *std::ranges::max_element(weights_k) };
+          data.w_min   = w_min;
+          data.w_scale = (w_max - w_min) / 65535.f;
+          for (float w : weights_k)
+            data.weights.push_back(data.w_scale > 0.f 
+              ? static_cast<ushort>(std::lround((w - w_min) / data.w_scale)) : 0);
+
+          // Pack and compress chunk
+          std::vector<uchar> raw(data.counts.size() 
+                               + data.indices.size() * sizeof(uint) 
+                               + data.weights.size() * sizeof(ushort));
+          uchar *dst = raw.data();
+          dst = std::copy(range_iter(data.counts), dst);
+          std::memcpy(dst, data.indices.data(), data.indices.size() * sizeof(uint));
+          dst += data.indices.size() * sizeof(uint);
+          std::memcpy(dst, data.weights.data(), data.weights.size() * sizeof(ushort));
+          
+          uLong size_comp = compressBound(static_cast<uLong>(raw.size()));
+          data.packed.resize(size_comp);
+          if (compress2(data.packed.data(), &size_comp, raw.data(), static_cast<uLong>(raw.size()), info.compression) != Z_OK)
+            n_failed++;
+          data.packed.resize(size_comp);
+          table[chunk] = { .size_raw = static_cast<uint>(raw.size()) };
+        }
+      }
+      if (n_failed > 0)
+        dtl::throw_keyed_error("weight field io failed", "could not compress chunk data", {{ "path", info.path.string() }});
+
+      // Append compressed chunks to file
+      for (int b = 0; b < batch_n; ++b) {
+        auto &data  = batch[b];
+        auto &entry = table[batch_first + b];
+        entry.offset  = data_offs;
+        entry.size    = static_cast<uint>(data.packed.size());
+        entry.w_min   = data.w_min;
+        entry.w_scale = data.w_scale;
+        out.write(reinterpret_cast<const char *>(data.packed.data()), data.packed.size());
+        data_offs += data.packed.size();
+      }
+    }
+
+    // Finally, write completed table
+    out.seekp(sizeof(header));
+    out.write(reinterpret_cast<const char *>(table.data()), table.size() * sizeof(WeightFieldEntry));
+    if (!out.good())
+      dtl::throw_keyed_error("weight field io failed", "could not write output file", {{ "path", info.path.string() }});
+  }
+
+  WeightField::WeightField(const std::filesystem::path &path, size_t cache_size)
+  : m_path(path), m_file(path), m_cache_size(std::max<size_t>(cache_size, 1)) {
+    auto data = m_file.data();
+    if (data.size() < sizeof(WeightFieldHeader))
+      dtl::throw_keyed_error("weight field io failed", "not a weight field file", {{ "path", path.string() }});
+    std::memcpy(&m_header, data.data(), sizeof(WeightFieldHeader));
+    if (m_header.magic != WeightFieldHeader().magic)
+      dtl::throw_keyed_error("weight field io failed", "not a weight field file", {{ "path", path.string() }});
+    if (m_header.n_verts < 3 || m_header.size_x == 0 || m_header.size_y == 0 
+     || m_header.chunk_x == 0 || m_header.chunk_y == 0)
+      dtl::throw_keyed_error("weight field io failed", "weight field header is invalid", {{ "path", path.string() }});
+
+    // The chunk table is referred to in place, inside the mapping
+    m_n_chunks = { ceil_div(m_header.size_x, m_header.chunk_x), ceil_div(m_header.size_y, m_header.chunk_y) };
+    size_t table_size = static_cast<size_t>(m_n_chunks.x()) * m_n_chunks.y() * sizeof(WeightFieldEntry);
+    if (data.size() < sizeof(WeightFieldHeader) + table_size)
+      dtl::throw_keyed_error("weight field io failed", "weight field file is truncated", {{ "path", path.string() }});
+    m_table = cast_span<const WeightFieldEntry>(data.subspan(sizeof(WeightFieldHeader), table_size));
+  }
+
+  eig::AlignedBox2f WeightField::bounds() const {
+    return { eig::Vector2f(m_header.bounds[0], m_header.bounds[1]),
+             eig::Vector2f(m_header.bounds[2], m_header.bounds[3]) };
+  }
+
+  WeightField::ChunkPtr WeightField::chunk_at(eig::Array2u xy) const {
+    if ((xy >= size()).any())
+      dtl::throw_keyed_error("weight field io failed", fmt::format("sample ({}, {}) lies outside the field", xy.x(), xy.y()),
+                             {{ "path", m_path.string() }});
+    eig::Array2u chunk_xy = xy / chunk_size();
+    uint         chunk    = chunk_xy.y() * m_n_chunks.x() + chunk_xy.x();
+    if (chunk >= m_table.size())
+      dtl::throw_keyed_error("weight field io failed", "chunk index lies outside the chunk table", {{ "path", m_path.string() }});
+    
+    // Return cached chunk, if available
+    {
+      std::lock_guard lock(m_cache_mutex);
+      if (auto it = m_cache.find(chunk); it != m_cache.end())
+        return it->second;
+    }
+
+    // Decompress chunk from mapped data
+    const auto &entry = m_table[chunk];
+    auto file = m_file.data();
+    if (entry.offset > file.size() || entry.size > file.size() - entry.offset)
+      dtl::throw_keyed_error("weight field io failed", fmt::format("chunk {} lies outside the file", chunk), {{ "path", m_path.string() }});
+    std::vector<uchar> raw(entry.size_raw);
+    uLong size_raw = entry.size_raw;
+    auto  src      = file.subspan(entry.offset, entry.size);
+    if (uncompress(raw.data(), &size_raw, reinterpret_cast<const Bytef *>(src.data()), entry.size) != Z_OK
+     || size_raw != entry.size_raw)
+      dtl::throw_keyed_error("weight field io failed", fmt::format("could not decompress chunk {}", chunk), {{ "path", m_path.string() }});
+    
+    // Unpack counts into offsets, and dequantize weights; sizes are checked against the
+    // counts before anything is read past them
+    auto data    = std::make_shared<WeightChunk>();
+    data->origin = chunk_xy * chunk_size();
+    data->size   = chunk_size().min(size() - data->origin);
+    uint n_samples = data->size.prod();
+    if (size_raw < n_samples)
+      dtl::throw_keyed_error("weight field io failed", fmt::format("chunk {} is truncated", chunk), {{ "path", m_path.string() }});
+    data->offsets.resize(n_samples + 1, 0);
+    for (uint i = 0; i < n_samples; ++i)
+      data->offsets[i + 1] = data->offsets[i] + raw[i];
+    uint n_weights = data->offsets.back();
+    if (size_raw != n_samples + static_cast<uLong>(n_weights) * (sizeof(uint) + sizeof(ushort)))
+      dtl::throw_keyed_error("weight field io failed", fmt::format("chunk {} has unexpected size", chunk), {{ "path", m_path.string() }});
+    data->indices.resize(n_weights);
+    data->weights.resize(n_weights);
+    std::memcpy(data->indices.data(), raw.data() + n_samples, n_weights * sizeof(uint));
+    if (std::ranges::any_of(data->indices, [&](uint i) { return i >= n_verts(); }))
+      dtl::throw_keyed_error("weight field io failed", fmt::format("chunk {} refers to missing vertices", chunk),
+                             {{ "path", m_path.string() }});
+    const uchar *src_weights = raw.data() + n_samples + n_weights * sizeof(uint);
+    for (uint i = 0; i < n_weights; ++i) {
+      ushort q;
+      std::memcpy(&q, src_weights + i * sizeof(ushort), sizeof(ushort));
+      data->weights[i] = entry.w_min + entry.w_scale * static_cast<float>(q);
+    }
+    
+    // Insert into cache; evict an arbitrary chunk if the cache is full
+    std::lock_guard lock(m_cache_mutex);
+    if (m_cache.size() >= m_cache_size)
+      m_cache.erase(m_cache.begin());
+    return m_cache.emplace(chunk, std::move(data)).first->second;
+  }
+
+  void WeightField::eval_colr(eig::Array2u                    region_origin,
+                              eig::Array2u                    region_size,
+                              std::span<const eig::AlArray3f> colrs,
+                              std::span<eig::Array3f>         out) const {
+    dbg::check_expr(colrs.size() == n_verts(), "WeightField::eval_colr(...) requires a color per vertex");
+    dbg::check_expr(out.size() >= region_size.prod(), "WeightField::eval_colr(...) output is too small");
+    
+    // Chunk errors are captured, as exceptions cannot leave the parallel region
+    std::exception_ptr error;
+    #pragma omp parallel for schedule(dynamic)
+    for (int y = 0; y < static_cast<int>(region_size.y()); ++y) {
+      ChunkPtr chunk;
+      for (uint x = 0; x < region_size.x(); ++x) {
+        eig::Array2u xy = region_origin + eig::Array2u(x, y);
+        if (!chunk || (xy >= chunk->origin + chunk->size).any()) {
+          try {
+            chunk = chunk_at(xy);
+          } catch (...) {
+            #pragma omp critical
+            error = std::current_exception();
+            break;
+          }
+        }
+        
+        auto indices = chunk->sample_indices(xy - chunk->origin);
+        auto weights = chunk->sample_weights(xy - chunk->origin);
+        eig::Array3f colr = 0.f;
+        for (uint i = 0; i < indices.size(); ++i)
+          colr += weights[i] * colrs[indices[i]];
+        out[y * region_size.x() + x] = colr;
+      }
+    }
+    if (error)
+      std::rethrow_exception(error);
+  }
+
+  void WeightField::eval_verts(eig::Array2u                   region_origin,
+                               eig::Array2u                   region_size,
+                               std::span<const eig::Vector2f> verts,
+                               std::span<eig::Vector2f>       out) const {
+    dbg::check_expr(verts.size() == n_verts(), "WeightField::eval_verts(...) requires a position per vertex");
+    dbg::check_expr(out.size() >= region_size.prod(), "WeightField::eval_verts(...) output is too small");
+    
+    // Chunk errors are captured, as exceptions cannot leave the parallel region
+    std::exception_ptr error;
+    #pragma omp parallel for schedule(dynamic)
+    for (int y = 0; y < static_cast<int>(region_size.y()); ++y) {
+      ChunkPtr chunk;
+      for (uint x = 0; x < region_size.x(); ++x) {
+        eig::Array2u xy = region_origin + eig::Array2u(x, y);
+        if (!chunk || (xy >= chunk->origin + chunk->size).any()) {
+          try {
+            chunk = chunk_at(xy);
+          } catch (...) {
+            #pragma omp critical
+            error = std::current_exception();
+            break;
+          }
+        }
+        
+        auto indices = chunk->sample_indices(xy - chunk->origin);
+        auto weights = chunk->sample_weights(xy - chunk->origin);
+        eig::Vector2f vert = eig::Vector2f::Zero();
+        for (uint i = 0; i < indices.size(); ++i)
+          vert += weights[i] * verts[indices[i]];
+        out[y * region_size.x() + x] = vert;
+      }
+    }
+    if (error)
+      std::rethrow_exception(error);
+  }
+} // namespace prg